@@ -31,6 +31,9 @@ endif()
 if(ENABLE_PARALLEL)
     include(AddTbb)
 endif()
+if(ENABLE_IO_URING)
+    include(AddLibUring)
+endif()
 include(AddGoogleTest)
 include(AddBoost)
 include(AddFmt)
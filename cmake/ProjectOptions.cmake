@@ -27,3 +27,12 @@ option(ENABLE_PARALLEL "Enable parallel examples" OFF)
 add_feature_info(
     ENABLE_PARALLEL ENABLE_PARALLEL "Build project with parallel examples"
 )
+
+##
+# Enabling io_uring variants of asio servers requires installing: liburing
+# (e.g. for Ubuntu: $ sudo apt install liburing-dev)
+##
+option(ENABLE_IO_URING "Enable io_uring variants of asio servers" OFF)
+add_feature_info(
+    ENABLE_IO_URING ENABLE_IO_URING "Build asio servers with io_uring backend (*-io-uring targets)"
+)
\ No newline at end of file
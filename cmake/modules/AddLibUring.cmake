@@ -0,0 +1,55 @@
+# Copyright 2025 Denys Asauliak
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+find_package(LibUring REQUIRED)
+
+if(NOT TARGET LibUring::LibUring)
+    add_library(LibUring::LibUring UNKNOWN IMPORTED GLOBAL)
+    set_target_properties(LibUring::LibUring PROPERTIES
+        INTERFACE_INCLUDE_DIRECTORIES ${LIBURING_INCLUDE_DIR}
+        IMPORTED_LOCATION ${LIBURING_LIBRARY}
+    )
+endif()
+
+if(NOT TARGET IoUring)
+    add_library(IoUring INTERFACE)
+    target_compile_definitions(IoUring
+        INTERFACE -DBOOST_ASIO_HAS_IO_URING
+                  -DBOOST_ASIO_DISABLE_EPOLL
+    )
+    target_link_libraries(IoUring INTERFACE LibUring::LibUring)
+endif()
+
+# Adds <target>-io-uring executable built from the same sources as <target> but with asio
+# switched from epoll reactor to io_uring backend
+function(add_io_uring_executable TARGET)
+    set(_VARIANT "${TARGET}-io-uring")
+
+    get_target_property(_SOURCES ${TARGET} SOURCES)
+    get_target_property(_INCLUDES ${TARGET} INCLUDE_DIRECTORIES)
+    get_target_property(_LIBRARIES ${TARGET} LINK_LIBRARIES)
+    get_target_property(_DEFINITIONS ${TARGET} COMPILE_DEFINITIONS)
+
+    add_executable(${_VARIANT} ${_SOURCES})
+    if(_INCLUDES)
+        target_include_directories(${_VARIANT} PRIVATE ${_INCLUDES})
+    endif()
+    if(_LIBRARIES)
+        target_link_libraries(${_VARIANT} PRIVATE ${_LIBRARIES})
+    endif()
+    if(_DEFINITIONS)
+        target_compile_definitions(${_VARIANT} PRIVATE ${_DEFINITIONS})
+    endif()
+    target_link_libraries(${_VARIANT} PRIVATE IoUring)
+endfunction()
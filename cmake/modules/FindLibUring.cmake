@@ -0,0 +1,42 @@
+# Copyright 2025 Denys Asauliak
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_LIBURING QUIET liburing)
+
+find_path(LIBURING_INCLUDE_DIR
+    NAMES
+        liburing.h
+    HINTS
+        ${PC_LIBURING_INCLUDE_DIRS}
+)
+
+find_library(LIBURING_LIBRARY
+    NAMES uring
+    HINTS ${PC_LIBURING_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LibUring REQUIRED_VARS
+    LIBURING_LIBRARY
+    LIBURING_INCLUDE_DIR
+    VERSION_VAR PC_LIBURING_VERSION
+)
+
+if(LIBURING_FOUND)
+    set(LIBURING_INCLUDE_DIRS ${LIBURING_INCLUDE_DIR})
+    set(LIBURING_LIBRARIES ${LIBURING_LIBRARY})
+endif()
+
+mark_as_advanced(LIBURING_INCLUDE_DIR LIBURING_LIBRARY)
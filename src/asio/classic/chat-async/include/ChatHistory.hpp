@@ -0,0 +1,90 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "HistoryLog.hpp"
+#include "Message.hpp"
+
+#include <boost/circular_buffer.hpp>
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * The last messages of the chat replayed to joining clients
+ *
+ * The ring holds the same messages (shared buffers) as those fanned out to clients, so keeping
+ * history copies nothing. If there is a log, the text of every message is appended to it and
+ * the history is restored from it on start. A full log is rewritten with the messages of the
+ * ring. The oldest messages are dropped while the history is over its size in bytes (if
+ * limited). The history isn't thread-safe.
+ */
+class ChatHistory {
+public:
+    /* Makes message to send from text restored from the log */
+    using Restore = std::function<Message(std::string_view text)>;
+
+    explicit ChatHistory(std::size_t capacity);
+
+    ChatHistory(std::size_t capacity, std::unique_ptr<HistoryLog> log, const Restore& restore);
+
+    /* Appends message, the text to log starts at given offset of the message (e.g. after
+       frame header) */
+    void
+    append(const Message& message, std::size_t textOffset = 0);
+
+    /* Limits the total size of messages kept (the oldest ones are dropped to fit) */
+    void
+    limitBytes(std::size_t bytes);
+
+    /* Appends messages of the history to the vector (from the oldest one) */
+    void
+    copyTo(std::vector<Message>& messages) const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    struct Entry {
+        Message message;
+        std::size_t textOffset{0};
+    };
+
+    /* Keeps entry in the ring, dropping the oldest ones over the limits */
+    void
+    push(Entry entry);
+
+    void
+    rewriteLog();
+
+private:
+    boost::circular_buffer<Entry> _entries;
+    std::unique_ptr<HistoryLog> _log;
+    std::size_t _bytes{0};
+    std::size_t _maxBytes{std::numeric_limits<std::size_t>::max()};
+};
+
+//
+// Inlines
+//
+
+inline std::size_t
+ChatHistory::size() const
+{
+    return _entries.size();
+}
@@ -15,21 +15,78 @@
 #pragma once
 
 #include "Common.hpp"
+#include "ChatHistory.hpp"
 #include "ChatSession.hpp"
+#include "ClientRegistry.hpp"
+#include "MulticastPublisher.hpp"
 
+#include <filesystem>
+#include <mutex>
 #include <optional>
 #include <string>
-#include <unordered_set>
+#include <string_view>
 
+/**
+ * Chat server
+ *
+ * Lines of text are sent to all clients, except for commands:
+ *  /sub <pattern>          - subscribe to topics matching pattern (e.g. news/+/football)
+ *  /unsub <pattern>        - unsubscribe from topics matching pattern
+ *  /pub <topic> <text>     - send text to clients subscribed to topic
+ *  /resend <seq> [count]   - send again multicast messages starting from sequence number,
+ *                            each as "/resent <seq> <text>" (multicast fan-out only)
+ *
+ * With length-prefixed framing every message is a frame instead of a line (see FrameCodec),
+ * frames sent to clients carry the same text.
+ *
+ * If history is kept, joining clients get the last messages sent to all clients right after
+ * the greeting (in the same write).
+ *
+ * With multicast fan-out, messages for all clients are published once to a UDP multicast group
+ * instead of being written to every client, TCP sessions carry everything else and serve as
+ * side channel to request lost datagrams.
+ *
+ * Messages received from clients may be rate limited per client and for all of them together,
+ * so a client sending in a tight loop doesn't make the server fan out everything it sends.
+ */
 class ChatServer {
 public:
-    ChatServer(asio::io_context& context, std::uint16_t port);
+    ChatServer(asio::io_context& context,
+               std::uint16_t port,
+               std::size_t shardsNum = 1,
+               Framing framing = Framing::Line);
+
+    /* Keeps the given number of last messages (up to ChatSession::Limits::writeMessages - 1
+       and as many as fit writeBytes with the welcome message, so the history is replayed by
+       one write) and mirrors them to the log file if given (sized
+       for twice as many messages of maximum length, must be called before listening, throws
+       boost::system::system_error if the log can't be opened) */
+    void
+    keepHistory(std::size_t messages, const std::filesystem::path& log = {});
+
+    /* Publishes messages for all clients to the multicast group via the interface with given
+       address, the given number of last datagrams is retained for retransmission (must be
+       called before listening) */
+    void
+    multicast(const udp::endpoint& group,
+              const asio::ip::address_v4& interface,
+              std::size_t retained = 4096);
+
+    /* Limits the rate of messages received from every client and from all of them together
+       (messages per second, unlimited if zero), up to the given bursts of messages over it (must
+       be called before listening) */
+    void
+    limitRate(double clientRate,
+              double clientBurst,
+              double totalRate,
+              double totalBurst,
+              ChatSession::RatePolicy policy);
 
     void
     listen();
 
     void
-    post(std::string message);
+    post(const Message& message);
 
 private:
     void
@@ -38,9 +95,36 @@ private:
     void
     doAccept();
 
+    /* Returns the size of header preceding the text of message (framing) */
+    [[nodiscard]] std::size_t
+    headerSize() const;
+
+    /* Creates message from concatenated parts framed for sending */
+    [[nodiscard]] Message
+    makeMessage(std::initializer_list<std::string_view> parts) const;
+
+    /* Sends retained multicast messages to the client again */
+    void
+    resend(ClientRegistry::ShardId shard, ChatSession::Ptr client, std::string_view args);
+
+    void
+    onMessage(ClientRegistry::ShardId shard,
+              ChatSession::Ptr client,
+              std::string_view from,
+              std::string_view text);
+
 private:
     asio::io_context& _context;
     tcp::endpoint _endpoint;
     tcp::acceptor _acceptor;
-    std::unordered_set<ChatSession::Ptr> _clients;
+    ClientRegistry _clients;
+    ChatSession::Limits _limits;
+    FrameCodec _codec;
+    /* Receive buffers of all sessions (length-prefixed framing only) */
+    std::shared_ptr<BufferPool> _pool;
+    /* Orders history appends with broadcasts: a joining client gets every message either in
+       history or live, but not both */
+    std::mutex _historyGuard;
+    std::optional<ChatHistory> _history;
+    std::optional<MulticastPublisher> _multicast;
 };
\ No newline at end of file
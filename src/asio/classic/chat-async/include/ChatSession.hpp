@@ -15,26 +15,150 @@
 #pragma once
 
 #include "Common.hpp"
+#include "FrameReader.hpp"
+#include "HandlerMemory.hpp"
+#include "LineFramer.hpp"
+#include "Message.hpp"
+#include "TokenBucket.hpp"
 
+#include <boost/circular_buffer.hpp>
+
+#include <optional>
+#include <span>
 #include <string>
-#include <queue>
+#include <vector>
 #include <memory>
 
 class ChatSession : public std::enable_shared_from_this<ChatSession> {
 public:
     using Ptr = std::shared_ptr<ChatSession>;
 
+    /* What to do with a message that doesn't fit into the outgoing queue */
+    enum class OverflowPolicy {
+        /* Drop queued messages starting from the oldest one (not being written) */
+        DropOldest,
+        /* Drop the message */
+        DropNewest,
+        /* Merge queued messages (not being written) into one, drop the message if it
+           doesn't fit by size anyway */
+        Coalesce,
+        /* Disconnect the client */
+        Disconnect
+    };
+
+    /* What to do with a received message over the rate limit */
+    enum class RatePolicy {
+        /* Drop the message */
+        Drop,
+        /* Stop reading until the message is within the limit (the client is slowed down by
+           flow control) */
+        Delay
+    };
+
+    struct Limits {
+        /* The maximum number of queued messages gathered into one write (asio writes up to 64
+           buffers with one sendmsg call) */
+        std::size_t writeMessages{64};
+        /* The maximum number of bytes gathered into one write */
+        std::size_t writeBytes{65536};
+        /* How received messages are delimited */
+        Framing framing{Framing::Line};
+        /* The maximum length of received line (the size of receive buffer) */
+        std::size_t lineBytes{4096};
+        /* The maximum payload size of received frame */
+        std::size_t frameBytes{65536};
+        /* The maximum number of queued messages (including ones being written) */
+        std::size_t queueMessages{1024};
+        /* The maximum number of queued bytes (including ones being written) */
+        std::size_t queueBytes{1024 * 1024};
+        OverflowPolicy policy{OverflowPolicy::DropOldest};
+        /* The maximum rate of received messages per second (unlimited if zero) */
+        double rate{0};
+        /* The number of messages received at once over the rate */
+        double burst{16};
+        RatePolicy ratePolicy{RatePolicy::Delay};
+        /* The rate limit shared with other sessions (e.g. for all clients), optional */
+        std::shared_ptr<TokenBucket> sharedRate{};
+    };
+
+    struct Counters {
+        /* The number of messages written to the socket */
+        std::size_t messages{0};
+        /* The number of write operations issued for them */
+        std::size_t writes{0};
+        /* The number of queued messages dropped to fit new ones */
+        std::size_t droppedOldest{0};
+        /* The number of new messages dropped */
+        std::size_t droppedNewest{0};
+        /* The number of queued messages merged into others */
+        std::size_t coalesced{0};
+        /* The number of disconnects because of overflow */
+        std::size_t disconnects{0};
+        /* The number of received messages dropped or delayed by rate limits */
+        std::size_t limitedMessages{0};
+        /* The number of bytes of these messages */
+        std::size_t limitedBytes{0};
+    };
+
     explicit ChatSession(asio::io_context& context, tcp::socket&& socket);
 
+    ChatSession(asio::io_context& context, tcp::socket&& socket, Limits limits);
+
+    /* Creates session which writes on given strand (shared with other sessions) */
+    ChatSession(asio::io_context::strand strand, tcp::socket&& socket, Limits limits);
+
+    /* Creates session which receives frames into buffers of given pool (shared with other
+       sessions, the session creates its own pool if none is given) */
+    ChatSession(asio::io_context::strand strand,
+                tcp::socket&& socket,
+                Limits limits,
+                std::shared_ptr<BufferPool> pool);
+
     void start(MessageHandler onMessage, ErrorHandler onError);
 
-    void post(std::string message);
+    /* Queues message for sending, must be called on the write strand of the session */
+    void post(Message message);
+
+    /* Queues messages for sending at once (e.g. replayed history) */
+    void post(std::span<const Message> messages);
+
+    [[nodiscard]] const Counters& counters() const;
+
+    [[nodiscard]] std::size_t queuedMessages() const;
+
+    [[nodiscard]] std::size_t queuedBytes() const;
 
 private:
+    [[nodiscard]] bool overflows(std::size_t bytes) const;
+
+    bool admit(const Message& message);
+
+    void enqueue(Message message);
+
+    void dropOldest();
+
+    void coalesce();
+
+    void disconnect();
+
     void read();
 
     void onRead(sys::error_code errorCode, std::size_t bytes);
 
+    void onFrame(sys::error_code errorCode, BufferPool::Buffer payload);
+
+    /* Handles received lines, reads more if none is delayed */
+    void receiveLines();
+
+    /* Hands received message over unless it's over the rate limit, returns false if it's
+       delayed (reading must stop until it's delivered) */
+    bool deliver(std::string_view text);
+
+    /* Returns the time until a message is within rate limits (takes it into account if zero) */
+    [[nodiscard]] TokenBucket::Clock::duration throttle();
+
+    void onThrottled(sys::error_code errorCode);
+
     void write();
 
     void onWrite(sys::error_code errorCode, std::size_t bytes);
@@ -43,8 +167,51 @@ private:
     tcp::socket _socket;
     asio::io_context::strand _strandR;
     asio::io_context::strand _strandW;
-    asio::streambuf _buffer;
-    std::queue<std::string> _outgoing;
+    /* Either lines or frames are received depending on framing */
+    std::optional<LineFramer> _framer;
+    std::optional<FrameReader> _frames;
+    /* The rate limit of the session (if any) */
+    std::optional<TokenBucket> _rate;
+    /* Delays a message over the rate limit, the message is either the line (valid until the
+       next read) or the frame */
+    asio::steady_timer _throttleTimer;
+    std::optional<std::string_view> _throttledLine;
+    std::optional<BufferPool::Buffer> _throttledFrame;
+    /* Formatted address of the client ("address:port") */
+    std::string _peer;
+    /* Grows on demand and keeps capacity, so queueing doesn't allocate in steady state */
+    boost::circular_buffer<Message> _outgoing;
+    /* Buffers of messages from the front of the queue being written now */
+    std::vector<asio::const_buffer> _writing;
+    std::size_t _queuedBytes{0};
+    bool _disconnected{false};
+    Limits _limits;
+    Counters _counters;
+    /* Memory for operations of the read and write chains */
+    HandlerMemory _readMemory;
+    HandlerMemory _writeMemory;
     MessageHandler _onMessage;
     ErrorHandler _onError;
-};
\ No newline at end of file
+};
+
+//
+// Inlines
+//
+
+inline const ChatSession::Counters&
+ChatSession::counters() const
+{
+    return _counters;
+}
+
+inline std::size_t
+ChatSession::queuedMessages() const
+{
+    return _outgoing.size();
+}
+
+inline std::size_t
+ChatSession::queuedBytes() const
+{
+    return _queuedBytes;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+#include "ChatSession.hpp"
+#include "Message.hpp"
+#include "TopicIndex.hpp"
+
+#include <atomic>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Sharded registry of chat clients
+ *
+ * Every shard owns its clients on its own strand: the set of clients and their topic
+ * subscriptions are touched and the sessions write only there, so shards never contend with
+ * each other. A broadcast or publish posts one handler per shard, which fans the message out
+ * to (subscribed) clients of that shard.
+ */
+class ClientRegistry {
+public:
+    using ShardId = std::size_t;
+
+    ClientRegistry(asio::io_context& context, std::size_t shardsNum);
+
+    /* Selects shard for new client (round-robin) */
+    [[nodiscard]] ShardId
+    pick();
+
+    /* Returns the strand client sessions of the shard must write on */
+    [[nodiscard]] asio::io_context::strand
+    strand(ShardId shard) const;
+
+    /* Adds client, greeting messages are sent to it at once before any other message */
+    void
+    add(ShardId shard, ChatSession::Ptr client, std::vector<Message> greeting = {});
+
+    void
+    remove(ShardId shard, ChatSession::Ptr client, std::function<void()> onRemoved);
+
+    /* Sends message to one client */
+    void
+    send(ShardId shard, ChatSession::Ptr client, Message message);
+
+    void
+    broadcast(const Message& message);
+
+    void
+    subscribe(ShardId shard, ChatSession::Ptr client, std::string pattern);
+
+    void
+    unsubscribe(ShardId shard, ChatSession::Ptr client, std::string pattern);
+
+    /* Sends message to clients subscribed to the topic (topic must stay valid until message is
+       delivered, e.g. refer to the message text) */
+    void
+    publish(std::string_view topic, const Message& message);
+
+    [[nodiscard]] std::size_t
+    shardsNum() const;
+
+    /* The number of clients (eventually consistent with pending additions and removals) */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    struct Shard {
+        explicit Shard(asio::io_context& context);
+
+        asio::io_context::strand strand;
+        std::unordered_set<ChatSession::Ptr> clients;
+        /* Subscribers are owned by the set of clients */
+        TopicIndex<ChatSession*> topics;
+        /* Subscribers matching topic being published (reused) */
+        std::vector<ChatSession*> matched;
+    };
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<std::size_t> _next{0};
+    std::atomic<std::size_t> _size{0};
+};
\ No newline at end of file
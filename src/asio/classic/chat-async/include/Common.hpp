@@ -17,10 +17,14 @@
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <string_view>
 
 namespace asio = boost::asio;
 namespace sys = boost::system;
 using tcp = asio::ip::tcp;
+using udp = asio::ip::udp;
 
-using MessageHandler = std::function<void(std::string message)>;
+/* Receives a line of text (with line ending) or a frame payload and its sender formatted as
+   "address:port" */
+using MessageHandler = std::function<void(std::string_view from, std::string_view text)>;
 using ErrorHandler = std::function<void()>;
\ No newline at end of file
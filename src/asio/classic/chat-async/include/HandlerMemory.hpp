@@ -0,0 +1,142 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Memory block reused by handlers of one operation chain
+ *
+ * Asio allocates every asynchronous operation using the allocator associated with the handler.
+ * Operations of a session's write chain never overlap, so one block per session serves them
+ * all instead of the heap (falls back to the heap if the block is taken or too small).
+ */
+class HandlerMemory {
+public:
+    HandlerMemory() = default;
+
+    HandlerMemory(const HandlerMemory&) = delete;
+
+    HandlerMemory&
+    operator=(const HandlerMemory&)
+        = delete;
+
+    void*
+    allocate(std::size_t size)
+    {
+        if (!_inUse && size <= sizeof(_storage)) {
+            _inUse = true;
+            return &_storage;
+        }
+        return ::operator new(size);
+    }
+
+    void
+    deallocate(void* pointer)
+    {
+        if (pointer == &_storage) {
+            _inUse = false;
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+private:
+    alignas(std::max_align_t) std::byte _storage[1024];
+    bool _inUse{false};
+};
+
+/* The allocator to associate with handlers (must satisfy Allocator requirements) */
+template<typename T>
+class HandlerAllocator {
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory)
+        : _memory{&memory}
+    {
+    }
+
+    template<typename U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept
+        : _memory{other._memory}
+    {
+    }
+
+    T*
+    allocate(std::size_t n) const
+    {
+        return static_cast<T*>(_memory->allocate(sizeof(T) * n));
+    }
+
+    void
+    deallocate(T* pointer, std::size_t /*n*/) const
+    {
+        _memory->deallocate(pointer);
+    }
+
+    template<typename U>
+    bool
+    operator==(const HandlerAllocator<U>& other) const noexcept
+    {
+        return _memory == other._memory;
+    }
+
+private:
+    template<typename>
+    friend class HandlerAllocator;
+
+    HandlerMemory* _memory;
+};
+
+/* Wraps handler to allocate its operations from the given memory */
+template<typename Handler>
+class AllocatingHandler {
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+
+    AllocatingHandler(HandlerMemory& memory, Handler handler)
+        : _memory{memory}
+        , _handler{std::move(handler)}
+    {
+    }
+
+    [[nodiscard]] allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type{_memory};
+    }
+
+    template<typename... Args>
+    void
+    operator()(Args&&... args)
+    {
+        _handler(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory& _memory;
+    Handler _handler;
+};
+
+template<typename Handler>
+inline AllocatingHandler<std::decay_t<Handler>>
+makeAllocatingHandler(HandlerMemory& memory, Handler&& handler)
+{
+    return AllocatingHandler<std::decay_t<Handler>>{memory, std::forward<Handler>(handler)};
+}
@@ -0,0 +1,95 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string_view>
+
+/**
+ * Append-only log of records in a memory-mapped file
+ *
+ * The file has fixed size and starts with a magic, records follow as 32-bit length and data.
+ * The unused tail is zero-filled, so the first zero length marks the end of the log. A record
+ * is written before its length, so a process dying in the middle of an append leaves the log
+ * consistent (the kernel flushes mapped pages of a dead process as usual).
+ */
+class HistoryLog {
+public:
+    /* Opens existing log (resized to given size) or creates new one, throws
+       boost::system::system_error on failure */
+    HistoryLog(std::filesystem::path path, std::size_t capacity);
+
+    HistoryLog(const HistoryLog&) = delete;
+
+    HistoryLog&
+    operator=(const HistoryLog&)
+        = delete;
+
+    ~HistoryLog();
+
+    /* Calls handler for each record from the oldest one */
+    void
+    forEach(const std::function<void(std::string_view record)>& handler) const;
+
+    /* Appends non-empty record, returns false if the log is full */
+    [[nodiscard]] bool
+    append(std::string_view record);
+
+    /* Replaces the log with the newest of given records which fit into it (atomically, by
+       renaming new file over it) */
+    void
+    rewrite(std::span<const std::string_view> records);
+
+    /* Returns the number of bytes taken by records */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    [[nodiscard]] std::size_t
+    capacity() const;
+
+    /* Returns the capacity of the log taking the given number of records of given size */
+    [[nodiscard]] static std::size_t
+    capacityFor(std::size_t records, std::size_t recordBytes);
+
+private:
+    /* Calls handler (if any) for each record, returns the end of the last one */
+    std::size_t
+    scan(const std::function<void(std::string_view record)>* handler) const;
+
+    void
+    map(const std::filesystem::path& path);
+
+    void
+    unmap();
+
+private:
+    std::filesystem::path _path;
+    std::size_t _capacity;
+    char* _data{nullptr};
+    /* The end of the last record */
+    std::size_t _end{0};
+};
+
+//
+// Inlines
+//
+
+inline std::size_t
+HistoryLog::capacity() const
+{
+    return _capacity;
+}
@@ -0,0 +1,58 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/**
+ * Splits received data into lines without copying
+ *
+ * Data is received directly into the fixed-size buffer of the framer, complete lines are
+ * returned as views over it. Every byte is scanned for the line delimiter once, even if the
+ * line is received in several parts. A line must fit into the buffer.
+ */
+class LineFramer {
+public:
+    explicit LineFramer(std::size_t capacity);
+
+    /* Returns free space to receive data into (invalidates returned lines) */
+    [[nodiscard]] asio::mutable_buffer
+    prepare();
+
+    /* Marks received bytes as ready to be split into lines */
+    void
+    commit(std::size_t bytes);
+
+    /* Returns next complete line (with delimiter) */
+    [[nodiscard]] std::optional<std::string_view>
+    next();
+
+    /* Returns true if buffer is full, but doesn't contain a complete line */
+    [[nodiscard]] bool
+    overflowed() const;
+
+private:
+    std::vector<char> _buffer;
+    /* The beginning of incomplete line */
+    std::size_t _begin{0};
+    /* The end of scanned data (no delimiter between the beginning and this position) */
+    std::size_t _scanned{0};
+    /* The end of received data */
+    std::size_t _end{0};
+};
\ No newline at end of file
@@ -0,0 +1,110 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string_view>
+
+/**
+ * Immutable reference-counted chat message
+ *
+ * Copies of a message share one buffer, so a broadcast costs one allocation regardless of
+ * the number of sessions the message is queued to. The buffer and its reference counter
+ * are allocated together.
+ */
+class Message {
+public:
+    Message() = default;
+
+    explicit Message(std::string_view text);
+
+    /* Creates message from concatenated parts (e.g. {sender, ": ", text}) */
+    Message(std::initializer_list<std::string_view> parts);
+
+    explicit Message(std::span<const std::string_view> parts);
+
+    [[nodiscard]] std::string_view
+    view() const noexcept;
+
+    [[nodiscard]] asio::const_buffer
+    buffer() const noexcept;
+
+    [[nodiscard]] std::size_t
+    size() const noexcept;
+
+    [[nodiscard]] bool
+    empty() const noexcept;
+
+private:
+    std::shared_ptr<const char[]> _data;
+    std::size_t _size{0};
+};
+
+//
+// Inlines
+//
+
+inline Message::Message(std::string_view text)
+    : Message(std::initializer_list<std::string_view>{text})
+{
+}
+
+inline Message::Message(std::initializer_list<std::string_view> parts)
+    : Message(std::span<const std::string_view>{parts.begin(), parts.size()})
+{
+}
+
+inline Message::Message(std::span<const std::string_view> parts)
+{
+    for (const auto part : parts) {
+        _size += part.size();
+    }
+    auto data = std::make_shared_for_overwrite<char[]>(_size);
+    char* out = data.get();
+    for (const auto part : parts) {
+        std::memcpy(out, part.data(), part.size());
+        out += part.size();
+    }
+    _data = std::move(data);
+}
+
+inline std::string_view
+Message::view() const noexcept
+{
+    return std::string_view{_data.get(), _size};
+}
+
+inline asio::const_buffer
+Message::buffer() const noexcept
+{
+    return asio::buffer(view());
+}
+
+inline std::size_t
+Message::size() const noexcept
+{
+    return _size;
+}
+
+inline bool
+Message::empty() const noexcept
+{
+    return (_size == 0);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+#include "Message.hpp"
+
+#include <boost/circular_buffer.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+ * Publishes chat messages to a UDP multicast group
+ *
+ * Every message goes out as one datagram whatever the number of subscribers: 8-byte
+ * big-endian sequence number followed by the text. The last datagrams are retained, so
+ * subscribers which detect a gap in sequence numbers can ask for them again over TCP. A
+ * datagram which can't be sent (e.g. too large) is still numbered and retained, subscribers
+ * fetch it as a gap. Publishing is thread-safe.
+ */
+class MulticastPublisher {
+public:
+    static constexpr std::size_t kSequenceSize{sizeof(std::uint64_t)};
+
+    struct Counters {
+        /* The number of datagrams sent */
+        std::size_t sent{0};
+        /* The number of datagrams failed to be sent */
+        std::size_t failed{0};
+    };
+
+    /* Publishes to group via the interface with given address (e.g. loopback) */
+    MulticastPublisher(asio::io_context& context,
+                       const udp::endpoint& group,
+                       const asio::ip::address_v4& interface,
+                       std::size_t retained);
+
+    /* Sends text to the group, returns its sequence number (starting from one) */
+    std::uint64_t
+    publish(std::string_view text);
+
+    /* Appends retained datagrams with sequence numbers from the range [first, first + count)
+       to the vector */
+    void
+    retained(std::uint64_t first, std::size_t count, std::vector<Message>& datagrams) const;
+
+    [[nodiscard]] Counters
+    counters() const;
+
+    /* Returns sequence number of datagram */
+    [[nodiscard]] static std::uint64_t
+    sequence(std::string_view datagram);
+
+    /* Returns text of datagram */
+    [[nodiscard]] static std::string_view
+    text(std::string_view datagram);
+
+private:
+    udp::socket _socket;
+    udp::endpoint _group;
+    mutable std::mutex _guard;
+    std::uint64_t _next{1};
+    /* Datagrams with sequence numbers up to the next one */
+    boost::circular_buffer<Message> _retained;
+    Counters _counters;
+};
@@ -0,0 +1,60 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+#include "SequenceTracker.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+/**
+ * Receives chat messages published to a UDP multicast group (see MulticastPublisher)
+ *
+ * Messages are handed over in the order of arrival, gaps in sequence numbers are reported to
+ * be requested again over TCP (/resend command of ChatServer), stale datagrams are dropped.
+ */
+class MulticastSubscriber {
+public:
+    using MessageHandler = std::function<void(std::uint64_t sequence, std::string_view text)>;
+    using GapHandler = std::function<void(const SequenceTracker::Gap& gap)>;
+
+    /* Joins group on the interface with given address (e.g. loopback) */
+    MulticastSubscriber(asio::io_context& context,
+                        const udp::endpoint& group,
+                        const asio::ip::address_v4& interface);
+
+    void
+    start(MessageHandler onMessage, GapHandler onGap);
+
+    void
+    stop();
+
+private:
+    void
+    receive();
+
+    void
+    onReceive(sys::error_code errorCode, std::size_t bytes);
+
+private:
+    udp::socket _socket;
+    std::vector<char> _buffer;
+    SequenceTracker _tracker;
+    MessageHandler _onMessage;
+    GapHandler _onGap;
+};
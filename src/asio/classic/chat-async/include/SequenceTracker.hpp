@@ -0,0 +1,69 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Detects gaps in sequence numbers of received datagrams
+ *
+ * Datagrams may be lost or reordered, the tracker remembers the next expected number only:
+ * a datagram ahead of it reports the skipped numbers as a gap (to be requested again), one
+ * behind it is stale (a duplicate or arrived after its gap was reported).
+ */
+class SequenceTracker {
+public:
+    struct Gap {
+        std::uint64_t first{0};
+        std::uint64_t count{0};
+    };
+
+    /* Registers received sequence number, returns false if it's stale, the numbers missing
+       before it are stored in gap (zero count if none) */
+    bool
+    receive(std::uint64_t sequence, Gap& gap);
+
+    /* Returns the next expected sequence number (zero until the first datagram) */
+    [[nodiscard]] std::uint64_t
+    next() const;
+
+private:
+    std::uint64_t _next{0};
+};
+
+//
+// Inlines
+//
+
+inline bool
+SequenceTracker::receive(std::uint64_t sequence, Gap& gap)
+{
+    gap = Gap{};
+    if (_next != 0 && sequence < _next) {
+        return false;
+    }
+    /* The first datagram received sets the start, nothing before it is missing */
+    if (_next != 0 && sequence > _next) {
+        gap = Gap{_next, sequence - _next};
+    }
+    _next = sequence + 1;
+    return true;
+}
+
+inline std::uint64_t
+SequenceTracker::next() const
+{
+    return _next;
+}
@@ -0,0 +1,88 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Lock-free token bucket
+ *
+ * Tokens are added at the given rate up to the burst size. Instead of the number of tokens
+ * the bucket keeps the time it becomes full again (the theoretical arrival time of generic
+ * cell rate algorithm), so taking tokens is a single compare-and-swap, and the bucket may be
+ * shared by threads.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /* Adds rate tokens per second (must be positive), up to burst tokens (at least one) */
+    TokenBucket(double rate, double burst);
+
+    /* Takes tokens, returns zero if they are available, otherwise takes nothing and returns
+       the time until they are (more tokens than the burst size are never available) */
+    Clock::duration
+    take(std::uint64_t tokens, Clock::time_point now = Clock::now());
+
+    /* Returns taken tokens back (e.g. if other limit doesn't allow to proceed) */
+    void
+    give(std::uint64_t tokens);
+
+private:
+    /* Nanoseconds per token */
+    std::int64_t _interval;
+    /* Nanoseconds the bucket takes to refill from empty */
+    std::int64_t _tolerance;
+    /* Time the bucket is full at (nanoseconds since clock epoch) */
+    std::atomic<std::int64_t> _full{0};
+};
+
+//
+// Inlines
+//
+
+inline TokenBucket::TokenBucket(double rate, double burst)
+    : _interval{std::max<std::int64_t>(1, static_cast<std::int64_t>(1e9 / rate))}
+    , _tolerance{static_cast<std::int64_t>(burst * double(_interval))}
+{
+    assert(rate > 0 && burst >= 1);
+}
+
+inline TokenBucket::Clock::duration
+TokenBucket::take(std::uint64_t tokens, Clock::time_point now)
+{
+    const std::int64_t time = std::chrono::nanoseconds{now.time_since_epoch()}.count();
+    const std::int64_t cost = static_cast<std::int64_t>(tokens) * _interval;
+    std::int64_t full = _full.load(std::memory_order_relaxed);
+    while (true) {
+        const std::int64_t next = std::max(full, time) + cost;
+        if (next - time > _tolerance) {
+            return std::chrono::nanoseconds{next - time - _tolerance};
+        }
+        if (_full.compare_exchange_weak(full, next, std::memory_order_relaxed)) {
+            return Clock::duration::zero();
+        }
+    }
+}
+
+inline void
+TokenBucket::give(std::uint64_t tokens)
+{
+    _full.fetch_sub(static_cast<std::int64_t>(tokens) * _interval, std::memory_order_relaxed);
+}
@@ -0,0 +1,359 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Index of topic subscriptions
+ *
+ * Topics consist of '/' separated levels (e.g. "news/sport/football"). Patterns without
+ * wildcards are looked up in a hash map, patterns with wildcards are kept in a trie of
+ * levels, where '+' matches exactly one level and '#' (the last level only) matches any
+ * number of remaining levels including none. Matching walks only trie branches which fit
+ * the topic, so it costs proportionally to the number of levels and matching subscribers,
+ * not to the total number of subscriptions.
+ */
+template<typename Subscriber>
+class TopicIndex {
+public:
+    static constexpr char kSeparator{'/'};
+    static constexpr std::string_view kAnyLevel{"+"};
+    static constexpr std::string_view kAnyLevels{"#"};
+
+    /* Returns true if topic is non-empty and has no wildcards */
+    [[nodiscard]] static bool
+    isValidTopic(std::string_view topic);
+
+    /* Returns true if pattern is non-empty and wildcards take whole levels ('#' the last) */
+    [[nodiscard]] static bool
+    isValidPattern(std::string_view pattern);
+
+    /* Adds subscription, returns false if pattern is invalid or subscription exists */
+    bool
+    subscribe(std::string_view pattern, const Subscriber& subscriber);
+
+    /* Removes subscription, returns false if there is no such subscription */
+    bool
+    unsubscribe(std::string_view pattern, const Subscriber& subscriber);
+
+    /* Removes all subscriptions of subscriber */
+    void
+    unsubscribe(const Subscriber& subscriber);
+
+    /* Replaces content of subscribers with unique subscribers matching topic */
+    void
+    match(std::string_view topic, std::vector<Subscriber>& subscribers) const;
+
+    /* Returns the number of subscriptions */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    struct Hash {
+        using is_transparent = void;
+
+        std::size_t
+        operator()(std::string_view value) const noexcept
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    template<typename Value>
+    using StringMap = std::unordered_map<std::string, Value, Hash, std::equal_to<>>;
+
+    struct Node {
+        StringMap<std::unique_ptr<Node>> children;
+        /* Child of '+' level */
+        std::unique_ptr<Node> anyLevel;
+        /* Subscribers of patterns ending at this node */
+        std::unordered_set<Subscriber> exact;
+        /* Subscribers of patterns ending with '#' after this node */
+        std::unordered_set<Subscriber> anyLevels;
+
+        [[nodiscard]] bool
+        empty() const
+        {
+            return children.empty() && !anyLevel && exact.empty() && anyLevels.empty();
+        }
+    };
+
+    [[nodiscard]] static bool
+    isWildcard(std::string_view pattern);
+
+    /* Splits off the first level of value, returns npos as position after the last one */
+    [[nodiscard]] static std::string_view
+    level(std::string_view value, std::size_t pos, std::size_t& next);
+
+    bool
+    insert(std::string_view pattern, const Subscriber& subscriber);
+
+    bool
+    erase(Node& node, std::string_view pattern, std::size_t pos, const Subscriber& subscriber);
+
+    void
+    collect(const Node& node,
+            std::string_view topic,
+            std::size_t pos,
+            std::vector<Subscriber>& subscribers) const;
+
+private:
+    StringMap<std::unordered_set<Subscriber>> _exact;
+    Node _root;
+    /* Patterns of every subscriber (to unsubscribe from all of them at once) */
+    std::unordered_map<Subscriber, std::unordered_set<std::string>> _patterns;
+    std::size_t _size{0};
+};
+
+//
+// Implementation
+//
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::isValidTopic(std::string_view topic)
+{
+    return !topic.empty() && topic.find_first_of("+#") == std::string_view::npos;
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::isValidPattern(std::string_view pattern)
+{
+    if (pattern.empty()) {
+        return false;
+    }
+    std::size_t pos{0};
+    while (pos != std::string_view::npos) {
+        std::size_t next;
+        const auto value = level(pattern, pos, next);
+        if (value.find_first_of("+#") != std::string_view::npos && value != kAnyLevel
+            && value != kAnyLevels) {
+            /* Wildcard must take the whole level */
+            return false;
+        }
+        if (value == kAnyLevels && next != std::string_view::npos) {
+            /* Multi-level wildcard must be the last level */
+            return false;
+        }
+        pos = next;
+    }
+    return true;
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::subscribe(std::string_view pattern, const Subscriber& subscriber)
+{
+    if (!isValidPattern(pattern)) {
+        return false;
+    }
+
+    bool inserted;
+    if (isWildcard(pattern)) {
+        inserted = insert(pattern, subscriber);
+    } else {
+        auto it = _exact.find(pattern);
+        if (it == _exact.end()) {
+            it = _exact.emplace(std::string{pattern}, std::unordered_set<Subscriber>{}).first;
+        }
+        inserted = it->second.insert(subscriber).second;
+    }
+    if (inserted) {
+        _patterns[subscriber].emplace(pattern);
+        ++_size;
+    }
+    return inserted;
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::unsubscribe(std::string_view pattern, const Subscriber& subscriber)
+{
+    auto patterns = _patterns.find(subscriber);
+    if (patterns == _patterns.end()) {
+        return false;
+    }
+    auto it = patterns->second.find(std::string{pattern});
+    if (it == patterns->second.end()) {
+        return false;
+    }
+
+    if (isWildcard(pattern)) {
+        erase(_root, pattern, 0, subscriber);
+    } else if (auto exact = _exact.find(pattern); exact != _exact.end()) {
+        exact->second.erase(subscriber);
+        if (exact->second.empty()) {
+            _exact.erase(exact);
+        }
+    }
+
+    patterns->second.erase(it);
+    if (patterns->second.empty()) {
+        _patterns.erase(patterns);
+    }
+    --_size;
+    return true;
+}
+
+template<typename Subscriber>
+void
+TopicIndex<Subscriber>::unsubscribe(const Subscriber& subscriber)
+{
+    auto patterns = _patterns.find(subscriber);
+    if (patterns == _patterns.end()) {
+        return;
+    }
+    /* Patterns are copied, since unsubscribing from the last one removes the whole entry */
+    const std::vector<std::string> copy{patterns->second.begin(), patterns->second.end()};
+    for (const auto& pattern : copy) {
+        unsubscribe(pattern, subscriber);
+    }
+}
+
+template<typename Subscriber>
+void
+TopicIndex<Subscriber>::match(std::string_view topic, std::vector<Subscriber>& subscribers) const
+{
+    subscribers.clear();
+    if (!isValidTopic(topic)) {
+        return;
+    }
+
+    if (auto exact = _exact.find(topic); exact != _exact.end()) {
+        subscribers.assign(exact->second.begin(), exact->second.end());
+    }
+    const std::size_t exactNum = subscribers.size();
+    collect(_root, topic, 0, subscribers);
+
+    /* A subscriber might match several patterns, but gets one copy of a message */
+    if (subscribers.size() > exactNum) {
+        std::sort(subscribers.begin(), subscribers.end(), std::less<>{});
+        subscribers.erase(std::unique(subscribers.begin(), subscribers.end()), subscribers.end());
+    }
+}
+
+template<typename Subscriber>
+std::size_t
+TopicIndex<Subscriber>::size() const
+{
+    return _size;
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::isWildcard(std::string_view pattern)
+{
+    return pattern.find_first_of("+#") != std::string_view::npos;
+}
+
+template<typename Subscriber>
+std::string_view
+TopicIndex<Subscriber>::level(std::string_view value, std::size_t pos, std::size_t& next)
+{
+    const std::size_t end = value.find(kSeparator, pos);
+    next = (end == std::string_view::npos) ? std::string_view::npos : end + 1;
+    return value.substr(pos, end - pos);
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::insert(std::string_view pattern, const Subscriber& subscriber)
+{
+    Node* node = &_root;
+    std::size_t pos{0};
+    while (pos != std::string_view::npos) {
+        std::size_t next;
+        const auto value = level(pattern, pos, next);
+        if (value == kAnyLevels) {
+            return node->anyLevels.insert(subscriber).second;
+        }
+        if (value == kAnyLevel) {
+            if (!node->anyLevel) {
+                node->anyLevel = std::make_unique<Node>();
+            }
+            node = node->anyLevel.get();
+        } else {
+            auto it = node->children.find(value);
+            if (it == node->children.end()) {
+                it = node->children.emplace(std::string{value}, std::make_unique<Node>()).first;
+            }
+            node = it->second.get();
+        }
+        pos = next;
+    }
+    return node->exact.insert(subscriber).second;
+}
+
+template<typename Subscriber>
+bool
+TopicIndex<Subscriber>::erase(Node& node,
+                              std::string_view pattern,
+                              std::size_t pos,
+                              const Subscriber& subscriber)
+{
+    /* Returns true if node has become empty and might be pruned */
+    if (pos == std::string_view::npos) {
+        node.exact.erase(subscriber);
+        return node.empty();
+    }
+
+    std::size_t next;
+    const auto value = level(pattern, pos, next);
+    if (value == kAnyLevels) {
+        node.anyLevels.erase(subscriber);
+    } else if (value == kAnyLevel) {
+        if (node.anyLevel && erase(*node.anyLevel, pattern, next, subscriber)) {
+            node.anyLevel.reset();
+        }
+    } else if (auto it = node.children.find(value); it != node.children.end()) {
+        if (erase(*it->second, pattern, next, subscriber)) {
+            node.children.erase(it);
+        }
+    }
+    return node.empty();
+}
+
+template<typename Subscriber>
+void
+TopicIndex<Subscriber>::collect(const Node& node,
+                                std::string_view topic,
+                                std::size_t pos,
+                                std::vector<Subscriber>& subscribers) const
+{
+    /* Multi-level wildcard matches the rest of topic (or nothing) */
+    subscribers.insert(subscribers.end(), node.anyLevels.begin(), node.anyLevels.end());
+    if (pos == std::string_view::npos) {
+        subscribers.insert(subscribers.end(), node.exact.begin(), node.exact.end());
+        return;
+    }
+
+    std::size_t next;
+    const auto value = level(topic, pos, next);
+    if (auto it = node.children.find(value); it != node.children.end()) {
+        collect(*it->second, topic, next, subscribers);
+    }
+    if (node.anyLevel) {
+        collect(*node.anyLevel, topic, next, subscribers);
+    }
+}
\ No newline at end of file
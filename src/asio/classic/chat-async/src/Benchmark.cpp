@@ -0,0 +1,294 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChatServer.hpp"
+#include "ChatSession.hpp"
+#include "HandlerMemory.hpp"
+#include "Message.hpp"
+
+#include "common/HeapMemoryTracker.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Broadcast throughput benchmark of chat sessions
+ *
+ * Every run connects the given number of loopback clients to chat sessions and posts bursts
+ * of messages to all of them, each burst is delivered before the next one. A message is
+ * either copied for every session (which is how broadcast worked before messages became
+ * shared) or shared by all of them. Sessions either write queued messages one by one (as
+ * before) or gather them into one write.
+ *
+ * Receive path run connects clients to chat server, one of them sends lines which the server
+ * broadcasts to all clients. The benchmark is single-threaded, so allocation counts of
+ * HeapMemoryTracker are exact.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9092};
+    std::size_t receivers{100};
+    std::size_t messages{100};
+    std::size_t burst{20};
+    std::size_t messageSize{128};
+};
+
+struct Mode {
+    const char* name;
+    bool shared;
+    bool gather;
+};
+
+constexpr Mode kModes[] = {
+    {"copy", false, false},
+    {"shared", true, false},
+    {"gather", true, true},
+};
+
+struct Client {
+    tcp::socket socket;
+    std::size_t received{0};
+    /* Reads of the client don't count as allocations of the server */
+    HandlerMemory memory;
+};
+
+/* The received data isn't inspected, all clients read into the same buffer */
+char discard[65536];
+
+void
+read(Client& client, std::size_t& total)
+{
+    client.socket.async_read_some(
+        asio::buffer(discard),
+        makeAllocatingHandler(client.memory,
+                              [&client, &total](sys::error_code errorCode, std::size_t bytes) {
+                                  if (!errorCode) {
+                                      total += bytes;
+                                      read(client, total);
+                                  }
+                              }));
+}
+
+bool
+raiseFileLimit(std::size_t clients)
+{
+    /* Each client takes two descriptors (client and server side of a connection) */
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    return (limit.rlim_cur > 2 * clients + 64);
+}
+
+void
+runBenchmark(const BenchOptions& options, std::size_t clientsNum, const Mode& mode)
+{
+    asio::io_context context;
+    tcp::acceptor acceptor{context, tcp::endpoint{asio::ip::address_v4::loopback(), options.port}};
+
+    ChatSession::Limits limits;
+    if (!mode.gather) {
+        limits.writeMessages = 1;
+    }
+
+    std::vector<ChatSession::Ptr> sessions;
+    std::vector<std::unique_ptr<Client>> clients;
+    sessions.reserve(clientsNum);
+    clients.reserve(clientsNum);
+    for (std::size_t n{0}; n < clientsNum; ++n) {
+        auto client = std::make_unique<Client>(tcp::socket{context});
+        client->socket.connect(acceptor.local_endpoint());
+        auto session = std::make_shared<ChatSession>(context, acceptor.accept(), limits);
+        session->start([](std::string_view, std::string_view) {}, []() {});
+        sessions.push_back(std::move(session));
+        clients.push_back(std::move(client));
+    }
+
+    std::size_t received{0};
+    for (auto& client : clients) {
+        read(*client, received);
+    }
+
+    const std::string text(options.messageSize, 'x');
+
+    HeapMemoryTracker::reset();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t posted{0}; posted < options.messages;) {
+        const std::size_t burst = std::min(options.burst, options.messages - posted);
+        for (std::size_t m{0}; m < burst; ++m) {
+            if (mode.shared) {
+                const Message message{text};
+                for (const auto& session : sessions) {
+                    session->post(message);
+                }
+            } else {
+                for (const auto& session : sessions) {
+                    session->post(Message{text});
+                }
+            }
+        }
+        posted += burst;
+
+        const std::size_t expected = clientsNum * posted * text.size();
+        while (received < expected) {
+            context.run_one();
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const std::size_t allocations = HeapMemoryTracker::allocNumber();
+
+    std::size_t writes{0};
+    for (const auto& session : sessions) {
+        writes += session->counters().writes;
+    }
+
+    const double delivered = double(clientsNum * options.messages);
+    std::printf("%8zu %8s %14.0f %14.0f %12.3f %12.3f\n",
+                clientsNum,
+                mode.name,
+                options.messages / elapsed.count(),
+                delivered / elapsed.count(),
+                allocations / delivered,
+                writes / delivered);
+}
+
+void
+runReceiveBenchmark(const BenchOptions& options)
+{
+    /* Sizes of notifications each client gets on its own and later clients join */
+    constexpr std::size_t kWelcomeSize{sizeof("Welcome to chat\n\r") - 1};
+    constexpr std::size_t kNewcomerSize{sizeof("We have a newcomer\n\r") - 1};
+
+    asio::io_context context;
+    ChatServer server{context, options.port};
+    server.listen();
+
+    std::vector<std::unique_ptr<Client>> clients;
+    for (std::size_t n{0}; n < options.receivers; ++n) {
+        clients.push_back(std::make_unique<Client>(tcp::socket{context}));
+        clients.back()->socket.connect(
+            tcp::endpoint{asio::ip::address_v4::loopback(), options.port});
+    }
+
+    std::size_t received{0};
+    for (auto& client : clients) {
+        read(*client, received);
+    }
+    std::size_t expected = options.receivers * kWelcomeSize
+                           + kNewcomerSize * options.receivers * (options.receivers - 1) / 2;
+    while (received < expected) {
+        context.run_one();
+    }
+
+    /* Lines of the first client are broadcast with its address as prefix */
+    tcp::socket& sender = clients.front()->socket;
+    std::ostringstream prefix;
+    prefix << sender.local_endpoint() << ": ";
+    std::string line(options.messageSize - 1, 'x');
+    line.push_back('\n');
+    std::string burst;
+    for (std::size_t n{0}; n < options.burst; ++n) {
+        burst.append(line);
+    }
+
+    HeapMemoryTracker::reset();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t posted{0}; posted < options.messages;) {
+        const std::size_t count = std::min(options.burst, options.messages - posted);
+        asio::write(sender, asio::buffer(burst.data(), count * line.size()));
+        posted += count;
+
+        expected += options.receivers * count * (prefix.str().size() + line.size());
+        while (received < expected) {
+            context.run_one();
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const std::size_t allocations = HeapMemoryTracker::allocNumber();
+
+    std::printf("%8zu %14.0f %14.0f %12.3f\n",
+                options.receivers,
+                options.messages / elapsed.count(),
+                double(options.receivers * options.messages) / elapsed.count(),
+                double(allocations) / options.messages);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::vector<std::size_t> clients;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9092), "Set port")
+        ("clients,c", po::value<std::vector<std::size_t>>(&clients)->multitoken()->default_value({1000, 10000}, "1000 10000"), "Set numbers of clients")
+        ("receivers,r", po::value<std::size_t>(&options.receivers)->default_value(100), "Set number of clients of receive path run")
+        ("messages,m", po::value<std::size_t>(&options.messages)->default_value(100), "Set number of broadcasts per run")
+        ("burst,b", po::value<std::size_t>(&options.burst)->default_value(20), "Set number of broadcasts per burst")
+        ("size,s", po::value<std::size_t>(&options.messageSize)->default_value(128), "Set message size")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.receivers == 0 || options.messages == 0 || options.burst == 0
+        || options.messageSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%8s %8s %14s %14s %12s %12s\n",
+                "clients",
+                "mode",
+                "broadcasts/s",
+                "deliveries/s",
+                "allocs/msg",
+                "writes/msg");
+    for (const std::size_t clientsNum : clients) {
+        if (!raiseFileLimit(clientsNum)) {
+            std::printf("%8zu  skipped: not enough file descriptors\n", clientsNum);
+            continue;
+        }
+        for (const Mode& mode : kModes) {
+            runBenchmark(options, clientsNum, mode);
+        }
+    }
+
+    std::printf("\n%8s %14s %14s %12s\n", "clients", "received/s", "deliveries/s", "allocs/msg");
+    runReceiveBenchmark(options);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChatHistory.hpp"
+
+#include <filesystem>
+#include <iostream>
+
+ChatHistory::ChatHistory(std::size_t capacity)
+    : _entries{capacity}
+{
+}
+
+ChatHistory::ChatHistory(std::size_t capacity,
+                         std::unique_ptr<HistoryLog> log,
+                         const Restore& restore)
+    : _entries{capacity}
+    , _log{std::move(log)}
+{
+    /* The ring keeps only the last messages of the log */
+    _log->forEach([this, &restore](std::string_view text) {
+        Message message = restore(text);
+        const std::size_t textOffset = message.size() - text.size();
+        push(Entry{std::move(message), textOffset});
+    });
+}
+
+void
+ChatHistory::append(const Message& message, std::size_t textOffset)
+{
+    if (_entries.capacity() == 0) {
+        return;
+    }
+
+    push(Entry{message, textOffset});
+    if (_log && !_log->append(message.view().substr(textOffset))) {
+        rewriteLog();
+    }
+}
+
+void
+ChatHistory::limitBytes(std::size_t bytes)
+{
+    _maxBytes = bytes;
+    while (_bytes > _maxBytes) {
+        _bytes -= _entries.front().message.size();
+        _entries.pop_front();
+    }
+}
+
+void
+ChatHistory::copyTo(std::vector<Message>& messages) const
+{
+    for (const Entry& entry : _entries) {
+        messages.push_back(entry.message);
+    }
+}
+
+void
+ChatHistory::push(Entry entry)
+{
+    if (_entries.full()) {
+        _bytes -= _entries.front().message.size();
+    }
+    _bytes += entry.message.size();
+    _entries.push_back(std::move(entry));
+    limitBytes(_maxBytes);
+}
+
+void
+ChatHistory::rewriteLog()
+{
+    std::vector<std::string_view> texts;
+    texts.reserve(_entries.size());
+    for (const Entry& entry : _entries) {
+        texts.push_back(entry.message.view().substr(entry.textOffset));
+    }
+
+    try {
+        _log->rewrite(texts);
+    } catch (const std::exception& e) {
+        /* The history is still kept in memory */
+        std::cerr << "rewriteLog: " << e.what() << std::endl;
+        _log.reset();
+    }
+}
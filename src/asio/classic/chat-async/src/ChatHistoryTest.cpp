@@ -0,0 +1,135 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "ChatHistory.hpp"
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+std::vector<std::string>
+texts(const ChatHistory& history)
+{
+    std::vector<::Message> messages;
+    history.copyTo(messages);
+    std::vector<std::string> result;
+    for (const auto& message : messages) {
+        result.emplace_back(message.view());
+    }
+    return result;
+}
+
+/* Restores message with header as ChatServer does with framing */
+::Message
+restore(std::string_view text)
+{
+    return ::Message{"#", text};
+}
+
+} // namespace
+
+class ChatHistoryTest : public Test {
+public:
+    ChatHistoryTest()
+        : path{std::filesystem::temp_directory_path()
+               / ("chat-history-test-" + std::to_string(::getpid()) + ".log")}
+    {
+        std::filesystem::remove(path);
+    }
+
+    ~ChatHistoryTest() override
+    {
+        std::filesystem::remove(path);
+    }
+
+protected:
+    std::filesystem::path path;
+};
+
+TEST_F(ChatHistoryTest, KeepsLastMessages)
+{
+    ChatHistory history{2};
+    const ::Message first{"first"};
+    history.append(first);
+    history.append(::Message{"second"});
+    history.append(::Message{"third"});
+    EXPECT_THAT(texts(history), ElementsAre("second", "third"));
+
+    /* Messages share buffers with the ones fanned out */
+    std::vector<::Message> messages;
+    ChatHistory shared{1};
+    shared.append(first);
+    shared.copyTo(messages);
+    EXPECT_EQ(messages.front().view().data(), first.view().data());
+}
+
+TEST_F(ChatHistoryTest, KeepsNothingWithoutCapacity)
+{
+    ChatHistory history{0};
+    history.append(::Message{"first"});
+    EXPECT_EQ(history.size(), 0);
+}
+
+TEST_F(ChatHistoryTest, KeepsLastMessagesFittingBytes)
+{
+    ChatHistory history{4};
+    history.limitBytes(10);
+    history.append(::Message{"first"});
+    history.append(::Message{"second"});
+    EXPECT_THAT(texts(history), ElementsAre("second"));
+    history.append(::Message{"abc"});
+    EXPECT_THAT(texts(history), ElementsAre("second", "abc"));
+
+    /* Message over the limit isn't kept at all */
+    history.append(::Message{"eleven char"});
+    EXPECT_EQ(history.size(), 0);
+
+    history.append(::Message{"a"});
+    history.append(::Message{"b"});
+    history.limitBytes(1);
+    EXPECT_THAT(texts(history), ElementsAre("b"));
+}
+
+TEST_F(ChatHistoryTest, RestoresFromLog)
+{
+    {
+        ChatHistory history{2, std::make_unique<HistoryLog>(path, 4096), restore};
+        history.append(restore("first"), 1);
+        history.append(restore("second"), 1);
+        history.append(restore("third"), 1);
+    }
+    ChatHistory history{2, std::make_unique<HistoryLog>(path, 4096), restore};
+    EXPECT_THAT(texts(history), ElementsAre("#second", "#third"));
+}
+
+TEST_F(ChatHistoryTest, RewritesFullLog)
+{
+    constexpr std::size_t kLogBytes{64};
+    {
+        ChatHistory history{2, std::make_unique<HistoryLog>(path, kLogBytes), restore};
+        for (int n = 0; n < 10; ++n) {
+            history.append(restore("message-" + std::to_string(n)), 1);
+        }
+    }
+    ChatHistory history{2, std::make_unique<HistoryLog>(path, kLogBytes), restore};
+    EXPECT_THAT(texts(history), ElementsAre("#message-8", "#message-9"));
+}
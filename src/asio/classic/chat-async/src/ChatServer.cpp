@@ -14,13 +14,103 @@
 
 #include "ChatServer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
 #include <iostream>
 
-ChatServer::ChatServer(asio::io_context& context, std::uint16_t port)
+namespace {
+
+/* The maximum length of sender (peer endpoint) prefixed to logged messages */
+constexpr std::size_t kMaxSenderBytes{64};
+
+/* The first message sent to joining client (followed by the history) */
+constexpr std::string_view kWelcome{"Welcome to chat\n\r"};
+
+/* The maximum number of messages resent at once */
+constexpr std::size_t kMaxResend{64};
+
+/* Splits off the first word of text (separated by space) */
+std::string_view
+nextWord(std::string_view& text)
+{
+    const auto end = std::min(text.find(' '), text.size());
+    const auto word = text.substr(0, end);
+    text.remove_prefix(std::min(end + 1, text.size()));
+    return word;
+}
+
+std::string_view
+trimLineEnd(std::string_view text)
+{
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+ChatServer::ChatServer(asio::io_context& context,
+                       std::uint16_t port,
+                       std::size_t shardsNum,
+                       Framing framing)
     : _context{context}
     , _endpoint{tcp::v4(), port}
     , _acceptor{context}
+    , _clients{context, shardsNum}
+    , _limits{.framing = framing}
+    , _codec{_limits.frameBytes}
+{
+    if (framing == Framing::Length) {
+        _pool = BufferPool::create(_limits.frameBytes);
+    }
+}
+
+void
+ChatServer::keepHistory(std::size_t messages, const std::filesystem::path& log)
+{
+    messages = std::min(messages, _limits.writeMessages - 1);
+    if (log.empty() || messages == 0) {
+        _history.emplace(messages);
+    } else {
+        /* The log takes twice the longest messages the ring holds, so a rewritten log is at
+           most half full and the next rewrite comes after as many appends as the ring holds */
+        const std::size_t textBytes
+            = kMaxSenderBytes + std::string_view{": "}.size()
+              + ((_limits.framing == Framing::Line) ? _limits.lineBytes : _limits.frameBytes);
+        const std::size_t logBytes = HistoryLog::capacityFor(2 * messages, textBytes);
+        _history.emplace(messages,
+                         std::make_unique<HistoryLog>(log, logBytes),
+                         [this](std::string_view text) { return makeMessage({text}); });
+    }
+    /* Long messages take the write limit in bytes before the one in messages */
+    _history->limitBytes(_limits.writeBytes - makeMessage({kWelcome}).size());
+}
+
+void
+ChatServer::multicast(const udp::endpoint& group,
+                      const asio::ip::address_v4& interface,
+                      std::size_t retained)
 {
+    _multicast.emplace(_context, group, interface, retained);
+}
+
+void
+ChatServer::limitRate(double clientRate,
+                      double clientBurst,
+                      double totalRate,
+                      double totalBurst,
+                      ChatSession::RatePolicy policy)
+{
+    _limits.rate = clientRate;
+    _limits.burst = clientBurst;
+    _limits.ratePolicy = policy;
+    _limits.sharedRate.reset();
+    if (totalRate > 0) {
+        _limits.sharedRate = std::make_shared<TokenBucket>(totalRate, totalBurst);
+    }
 }
 
 void
@@ -53,20 +143,31 @@ ChatServer::doAccept()
             return;
         }
 
-        auto client = std::make_shared<ChatSession>(_context, std::move(socket));
-        client->post("Welcome to chat\n\r");
-        post("We have a newcomer\n\r");
-
-        _clients.insert(client);
+        const auto shard = _clients.pick();
+        auto client = std::make_shared<ChatSession>(
+            _clients.strand(shard), std::move(socket), _limits, _pool);
+        post(makeMessage({"We have a newcomer\n\r"}));
+        std::vector<Message> greeting{makeMessage({kWelcome})};
+        if (_history) {
+            std::lock_guard lock{_historyGuard};
+            _history->copyTo(greeting);
+            _clients.add(shard, client, std::move(greeting));
+        } else {
+            _clients.add(shard, client, std::move(greeting));
+        }
 
         client->start(
-            [this](std::string message) {
-                /* Post message for all clients */
-                post(std::move(message));
+            [this, shard, weakClient = std::weak_ptr{client}](std::string_view from,
+                                                               std::string_view text) {
+                if (auto client = weakClient.lock()) {
+                    onMessage(shard, std::move(client), from, text);
+                }
             },
-            [this, weakClient = std::weak_ptr{client}]() {
-                if (auto client = weakClient.lock(); client && _clients.erase(client)) {
-                    post("We are one less\n\r");
+            [this, shard, weakClient = std::weak_ptr{client}]() {
+                if (auto client = weakClient.lock()) {
+                    _clients.remove(shard, std::move(client), [this]() {
+                        post(makeMessage({"We are one less\n\r"}));
+                    });
                 }
             });
 
@@ -75,9 +176,110 @@ ChatServer::doAccept()
 }
 
 void
-ChatServer::post(std::string message)
+ChatServer::onMessage(ClientRegistry::ShardId shard,
+                      ChatSession::Ptr client,
+                      std::string_view from,
+                      std::string_view text)
+{
+    using Topics = TopicIndex<ChatSession*>;
+
+    std::string_view args = trimLineEnd(text);
+    const auto command = nextWord(args);
+    if (command == "/sub" || command == "/unsub") {
+        const auto pattern = nextWord(args);
+        if (!Topics::isValidPattern(pattern)) {
+            _clients.send(shard, std::move(client), makeMessage({"Invalid topic pattern\n\r"}));
+        } else if (command == "/sub") {
+            _clients.subscribe(shard, std::move(client), std::string{pattern});
+        } else {
+            _clients.unsubscribe(shard, std::move(client), std::string{pattern});
+        }
+    } else if (command == "/resend") {
+        resend(shard, std::move(client), args);
+    } else if (command == "/pub") {
+        const auto topic = nextWord(args);
+        if (!Topics::isValidTopic(topic)) {
+            _clients.send(shard, std::move(client), makeMessage({"Invalid topic\n\r"}));
+        } else {
+            /* Deliver message to subscribers only (the text is shared, not copied) */
+            const auto message = makeMessage({"[", topic, "] ", from, ": ", args, "\n"});
+            _clients.publish(message.view().substr(headerSize() + 1, topic.size()), message);
+        }
+    } else {
+        /* Post message for all clients (one allocation, the text is shared, not copied) */
+        const auto message = makeMessage({from, ": ", text});
+        if (_history) {
+            std::lock_guard lock{_historyGuard};
+            _history->append(message, headerSize());
+            post(message);
+        } else {
+            post(message);
+        }
+    }
+}
+
+std::size_t
+ChatServer::headerSize() const
+{
+    return (_limits.framing == Framing::Length) ? FrameCodec::kHeaderSize : 0;
+}
+
+Message
+ChatServer::makeMessage(std::initializer_list<std::string_view> parts) const
+{
+    if (_limits.framing == Framing::Line) {
+        return Message{parts};
+    }
+
+    /* The header is the first part, so a framed message is still one allocation */
+    std::size_t length{0};
+    for (const auto part : parts) {
+        length += part.size();
+    }
+    const auto header = _codec.encode(length);
+    std::array<std::string_view, 8> framed;
+    assert(parts.size() < framed.size());
+    framed[0] = FrameCodec::view(header);
+    std::copy(parts.begin(), parts.end(), framed.begin() + 1);
+    return Message{std::span{framed.data(), parts.size() + 1}};
+}
+
+void
+ChatServer::resend(ClientRegistry::ShardId shard, ChatSession::Ptr client, std::string_view args)
+{
+    std::uint64_t first{0};
+    std::size_t count{1};
+    const auto firstArg = nextWord(args);
+    const auto countArg = nextWord(args);
+    const bool valid
+        = std::from_chars(firstArg.data(), firstArg.data() + firstArg.size(), first).ec
+              == std::errc{}
+          && (countArg.empty()
+              || std::from_chars(countArg.data(), countArg.data() + countArg.size(), count).ec
+                     == std::errc{});
+    if (!_multicast || !valid || count == 0) {
+        _clients.send(shard, std::move(client), makeMessage({"Invalid resend request\n\r"}));
+        return;
+    }
+
+    std::vector<Message> datagrams;
+    _multicast->retained(first, std::min(count, kMaxResend), datagrams);
+    for (const Message& datagram : datagrams) {
+        const auto sequence = std::to_string(MulticastPublisher::sequence(datagram.view()));
+        _clients.send(
+            shard,
+            client,
+            makeMessage({"/resent ", sequence, " ", MulticastPublisher::text(datagram.view())}));
+    }
+}
+
+void
+ChatServer::post(const Message& message)
 {
-    for (const auto& client : _clients) {
-        client->post(message);
+    if (_multicast) {
+        /* One datagram for all clients (the text without framing) */
+        _multicast->publish(message.view().substr(headerSize()));
+    } else {
+        _clients.broadcast(message);
     }
 }
@@ -14,14 +14,55 @@
 
 #include "ChatSession.hpp"
 
+#include <algorithm>
+#include <span>
 #include <sstream>
 #include <iostream>
 
+namespace {
+
+/* The number of queued messages to make room for at once */
+constexpr std::size_t kInitialQueueCapacity{16};
+
+} // namespace
+
 ChatSession::ChatSession(asio::io_context& context, tcp::socket&& socket)
+    : ChatSession{context, std::move(socket), Limits{}}
+{
+}
+
+ChatSession::ChatSession(asio::io_context& context, tcp::socket&& socket, Limits limits)
+    : ChatSession{asio::io_context::strand{context}, std::move(socket), limits}
+{
+}
+
+ChatSession::ChatSession(asio::io_context::strand strand, tcp::socket&& socket, Limits limits)
+    : ChatSession{std::move(strand), std::move(socket), limits, nullptr}
+{
+}
+
+ChatSession::ChatSession(asio::io_context::strand strand,
+                         tcp::socket&& socket,
+                         Limits limits,
+                         std::shared_ptr<BufferPool> pool)
     : _socket{std::move(socket)}
-    , _strandR{context}
-    , _strandW{context}
+    , _strandR{strand.context()}
+    , _strandW{std::move(strand)}
+    , _throttleTimer{_strandR.context()}
+    , _limits{std::move(limits)}
 {
+    if (_limits.rate > 0) {
+        _rate.emplace(_limits.rate, _limits.burst);
+    }
+    _writing.reserve(_limits.writeMessages);
+    if (_limits.framing == Framing::Line) {
+        _framer.emplace(_limits.lineBytes);
+    } else {
+        if (!pool) {
+            pool = BufferPool::create(_limits.frameBytes);
+        }
+        _frames.emplace(FrameCodec{_limits.frameBytes}, std::move(pool));
+    }
 }
 
 void
@@ -29,27 +70,163 @@ ChatSession::start(MessageHandler onMessage, ErrorHandler onError)
 {
     _onMessage = std::move(onMessage);
     _onError = std::move(onError);
+
+    /* Writes are already gathered, delaying them further (Nagle) only stalls small messages
+       until the client acknowledges previous ones */
+    sys::error_code errorCode;
+    _socket.set_option(tcp::no_delay{true}, errorCode);
+
+    /* The sender of every line is the same, so it's formatted once */
+    std::ostringstream peer;
+    peer << _socket.remote_endpoint(errorCode);
+    _peer = peer.str();
+
     read();
 }
 
 void
-ChatSession::post(std::string message)
+ChatSession::post(Message message)
+{
+    const bool idle = _outgoing.empty();
+    enqueue(std::move(message));
+    if (idle && !_outgoing.empty()) {
+        write();
+    }
+}
+
+void
+ChatSession::post(std::span<const Message> messages)
 {
-    bool idle = _outgoing.empty();
-    _outgoing.push(std::move(message));
-    if (idle) {
+    /* Messages are queued before writing starts, so they are gathered into one write */
+    const bool idle = _outgoing.empty();
+    for (const Message& message : messages) {
+        enqueue(message);
+    }
+    if (idle && !_outgoing.empty()) {
         write();
     }
 }
 
+void
+ChatSession::enqueue(Message message)
+{
+    if (!admit(message)) {
+        return;
+    }
+
+    if (_outgoing.full()) {
+        _outgoing.set_capacity(std::max(kInitialQueueCapacity, _outgoing.capacity() * 2));
+    }
+    _queuedBytes += message.size();
+    _outgoing.push_back(std::move(message));
+}
+
+bool
+ChatSession::overflows(std::size_t bytes) const
+{
+    return (_outgoing.size() + 1 > _limits.queueMessages
+            || _queuedBytes + bytes > _limits.queueBytes);
+}
+
+bool
+ChatSession::admit(const Message& message)
+{
+    if (_disconnected) {
+        return false;
+    }
+    if (!overflows(message.size())) {
+        return true;
+    }
+
+    switch (_limits.policy) {
+    case OverflowPolicy::DropOldest:
+        while (overflows(message.size()) && _outgoing.size() > _writing.size()) {
+            dropOldest();
+        }
+        break;
+    case OverflowPolicy::Coalesce:
+        coalesce();
+        break;
+    case OverflowPolicy::Disconnect:
+        disconnect();
+        return false;
+    case OverflowPolicy::DropNewest:
+        break;
+    }
+
+    /* Messages being written are never dropped, so there might be no room still */
+    if (overflows(message.size())) {
+        ++_counters.droppedNewest;
+        return false;
+    }
+    return true;
+}
+
+void
+ChatSession::dropOldest()
+{
+    /* Messages at the front of the queue are being written */
+    if (_outgoing.size() > _writing.size()) {
+        const auto oldest = _outgoing.begin() + _writing.size();
+        _queuedBytes -= oldest->size();
+        _outgoing.erase(oldest);
+        ++_counters.droppedOldest;
+    }
+}
+
+void
+ChatSession::coalesce()
+{
+    const auto first = _outgoing.begin() + _writing.size();
+    const auto count = static_cast<std::size_t>(_outgoing.end() - first);
+    if (count < 2) {
+        return;
+    }
+
+    std::string text;
+    text.reserve(_queuedBytes);
+    for (auto it = first; it != _outgoing.end(); ++it) {
+        text.append(it->view());
+    }
+    _outgoing.erase(first, _outgoing.end());
+    _outgoing.push_back(Message{text});
+    _counters.coalesced += count - 1;
+}
+
+void
+ChatSession::disconnect()
+{
+    _disconnected = true;
+    ++_counters.disconnects;
+
+    /* Release queued messages except ones being written */
+    for (auto it = _outgoing.begin() + _writing.size(); it != _outgoing.end(); ++it) {
+        _queuedBytes -= it->size();
+    }
+    _outgoing.erase(_outgoing.begin() + _writing.size(), _outgoing.end());
+
+    /* Pending operations complete with an error which reports the client to be gone */
+    sys::error_code errorCode;
+    _socket.shutdown(tcp::socket::shutdown_both, errorCode);
+}
+
 void
 ChatSession::read()
 {
-    asio::async_read_until(
-        _socket,
-        _buffer,
-        "\n",
-        asio::bind_executor(_strandR, std::bind_front(&ChatSession::onRead, shared_from_this())));
+    if (_frames) {
+        _frames->read(_socket,
+                      asio::bind_executor(_strandR,
+                                          std::bind_front(&ChatSession::onFrame,
+                                                          shared_from_this())));
+        return;
+    }
+
+    _socket.async_read_some(
+        _framer->prepare(),
+        asio::bind_executor(
+            _strandR,
+            makeAllocatingHandler(
+                _readMemory, std::bind_front(&ChatSession::onRead, shared_from_this()))));
 }
 
 void
@@ -60,21 +237,135 @@ ChatSession::onRead(sys::error_code errorCode, std::size_t bytes)
         _socket.close();
         _onError();
     } else {
-        std::stringstream ss;
-        ss << _socket.remote_endpoint(errorCode) << ": " << std::istream{&_buffer}.rdbuf();
-        _buffer.consume(bytes);
-        _onMessage(ss.str());
+        _framer->commit(bytes);
+        receiveLines();
+    }
+}
+
+void
+ChatSession::receiveLines()
+{
+    /* Lines are handled in place, the received data is valid until the next read */
+    while (const auto line = _framer->next()) {
+        if (!deliver(*line)) {
+            _throttledLine = line;
+            return;
+        }
+    }
+    if (_framer->overflowed()) {
+        std::cerr << "onRead: line exceeds " << _limits.lineBytes << " bytes" << std::endl;
+        _socket.close();
+        _onError();
+        return;
+    }
+    read();
+}
+
+void
+ChatSession::onFrame(sys::error_code errorCode, BufferPool::Buffer payload)
+{
+    if (errorCode) {
+        std::cerr << "onFrame: " << errorCode.message() << std::endl;
+        _socket.close();
+        _onError();
+    } else {
+        /* The payload returns to the pool once handled */
+        if (!deliver(payload.view())) {
+            _throttledFrame = std::move(payload);
+            return;
+        }
         read();
     }
 }
 
+bool
+ChatSession::deliver(std::string_view text)
+{
+    const auto delay = throttle();
+    if (delay == TokenBucket::Clock::duration::zero()) {
+        _onMessage(_peer, text);
+        return true;
+    }
+
+    /* A delayed message is counted once however many times it waits */
+    if (!_throttledLine && !_throttledFrame) {
+        ++_counters.limitedMessages;
+        _counters.limitedBytes += text.size();
+    }
+    if (_limits.ratePolicy == RatePolicy::Drop) {
+        return true;
+    }
+    _throttleTimer.expires_after(delay);
+    _throttleTimer.async_wait(asio::bind_executor(
+        _strandR, std::bind_front(&ChatSession::onThrottled, shared_from_this())));
+    return false;
+}
+
+TokenBucket::Clock::duration
+ChatSession::throttle()
+{
+    const auto now = TokenBucket::Clock::now();
+    if (_rate) {
+        if (const auto delay = _rate->take(1, now); delay != delay.zero()) {
+            return delay;
+        }
+    }
+    if (_limits.sharedRate) {
+        if (const auto delay = _limits.sharedRate->take(1, now); delay != delay.zero()) {
+            /* The message isn't received yet as far as the own limit is concerned */
+            if (_rate) {
+                _rate->give(1);
+            }
+            return delay;
+        }
+    }
+    return TokenBucket::Clock::duration::zero();
+}
+
+void
+ChatSession::onThrottled(sys::error_code errorCode)
+{
+    if (errorCode) {
+        return;
+    }
+
+    if (_throttledFrame) {
+        if (deliver(_throttledFrame->view())) {
+            _throttledFrame.reset();
+            read();
+        }
+    } else if (_throttledLine) {
+        if (deliver(*_throttledLine)) {
+            _throttledLine.reset();
+            receiveLines();
+        }
+    }
+}
+
 void
 ChatSession::write()
 {
+    /* Gather queued messages into one write (always at least one, even if it's over the limit) */
+    std::size_t bytes{0};
+    for (const Message& message : _outgoing) {
+        if (!_writing.empty()
+            && (_writing.size() == _limits.writeMessages
+                || bytes + message.size() > _limits.writeBytes)) {
+            break;
+        }
+        _writing.push_back(message.buffer());
+        bytes += message.size();
+    }
+    ++_counters.writes;
+
+    /* Buffers are passed as a view, so the operation doesn't copy (allocate) the sequence */
     asio::async_write(
         _socket,
-        asio::buffer(_outgoing.front()),
-        asio::bind_executor(_strandW, std::bind_front(&ChatSession::onWrite, shared_from_this())));
+        std::span<const asio::const_buffer>{_writing},
+        asio::bind_executor(
+            _strandW,
+            makeAllocatingHandler(
+                _writeMemory, std::bind_front(&ChatSession::onWrite, shared_from_this()))));
 }
 
 void
@@ -82,10 +373,21 @@ ChatSession::onWrite(sys::error_code errorCode, std::size_t /*bytes*/)
 {
     if (errorCode) {
         std::cerr << "onWrite: " << errorCode.message() << std::endl;
+        /* Nothing is going to be written anymore, release queued messages */
+        _disconnected = true;
+        _outgoing.clear();
+        _writing.clear();
+        _queuedBytes = 0;
         _socket.close();
         _onError();
     } else {
-        _outgoing.pop();
+        /* Release written messages (the queue might grow while writing, not shrink) */
+        _counters.messages += _writing.size();
+        for (std::size_t n{0}; n < _writing.size(); ++n) {
+            _queuedBytes -= _outgoing[n].size();
+        }
+        _outgoing.erase(_outgoing.begin(), _outgoing.begin() + _writing.size());
+        _writing.clear();
         if (!_outgoing.empty()) {
             write();
         }
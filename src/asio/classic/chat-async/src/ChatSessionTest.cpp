@@ -0,0 +1,326 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "ChatSession.hpp"
+
+#include <cstdio>
+
+using namespace testing;
+
+namespace {
+
+/* Socket buffers are kept small, so a client which doesn't read stalls writes quickly */
+constexpr int kSocketBufferSize{4096};
+constexpr std::size_t kMessageSize{64};
+
+::Message
+numbered(std::size_t n)
+{
+    char text[kMessageSize + 1];
+    std::snprintf(text, sizeof(text), "%063zu\n", n);
+    return ::Message{std::string{text, kMessageSize}};
+}
+
+} // namespace
+
+/**
+ * Harness of a chat session connected to a loopback client which reads slowly (or not at all)
+ */
+class ChatSessionTest : public Test {
+public:
+    void
+    connect(ChatSession::Limits limits)
+    {
+        tcp::acceptor acceptor{_context, tcp::endpoint{asio::ip::address_v4::loopback(), 0}};
+        _client.set_option(asio::socket_base::receive_buffer_size{kSocketBufferSize});
+        _client.connect(acceptor.local_endpoint());
+        auto socket = acceptor.accept();
+        socket.set_option(asio::socket_base::send_buffer_size{kSocketBufferSize});
+
+        _session = std::make_shared<ChatSession>(_context, std::move(socket), limits);
+        _session->start(
+            [this](std::string_view, std::string_view text) { _messages.emplace_back(text); },
+            [this]() { ++_errors; });
+    }
+
+    /* Posts messages while client reads the given number of bytes every 16 messages */
+    void
+    post(std::size_t messages, std::size_t readBytes = 0)
+    {
+        for (std::size_t n{0}; n < messages; ++n) {
+            _session->post(numbered(_posted++));
+            _context.poll();
+            if (readBytes > 0 && n % 16 == 0) {
+                read(readBytes);
+            }
+            _maxQueuedBytes = std::max(_maxQueuedBytes, _session->queuedBytes());
+            _maxQueuedMessages = std::max(_maxQueuedMessages, _session->queuedMessages());
+        }
+    }
+
+    /* Sends frame from client */
+    void
+    sendFrame(std::string_view payload, std::size_t length)
+    {
+        const auto header = FrameCodec{length}.encode(length);
+        asio::write(_client, std::array{asio::buffer(header), asio::buffer(payload)});
+    }
+
+    /* Reads available data (up to the given number of bytes) */
+    void
+    read(std::size_t bytes)
+    {
+        std::string chunk(bytes, '\0');
+        sys::error_code error;
+        _client.non_blocking(true);
+        const std::size_t n = _client.read_some(asio::buffer(chunk), error);
+        _received.append(chunk.data(), n);
+        _context.poll();
+    }
+
+    /* Reads everything queued by the session */
+    void
+    drain()
+    {
+        _client.non_blocking(true);
+        while (_session->queuedMessages() > 0 || _client.available() > 0) {
+            read(65536);
+            _context.poll();
+        }
+    }
+
+    /* Returns numbers of received messages */
+    [[nodiscard]] std::vector<std::size_t>
+    received() const
+    {
+        std::vector<std::size_t> numbers;
+        for (std::size_t offset{0}; offset + kMessageSize <= _received.size();
+             offset += kMessageSize) {
+            numbers.push_back(std::stoul(_received.substr(offset, kMessageSize - 1)));
+        }
+        return numbers;
+    }
+
+protected:
+    asio::io_context _context;
+    tcp::socket _client{_context, tcp::v4()};
+    ChatSession::Ptr _session;
+    std::size_t _posted{0};
+    std::size_t _errors{0};
+    std::size_t _maxQueuedBytes{0};
+    std::size_t _maxQueuedMessages{0};
+    std::string _received;
+    std::vector<std::string> _messages;
+};
+
+TEST_F(ChatSessionTest, StalledReaderWithDropNewest)
+{
+    connect({.queueMessages = 64,
+             .queueBytes = 64 * kMessageSize,
+             .policy = ChatSession::OverflowPolicy::DropNewest});
+
+    post(10000);
+    EXPECT_LE(_maxQueuedMessages, 64);
+    EXPECT_LE(_maxQueuedBytes, 64 * kMessageSize);
+    EXPECT_GT(_session->counters().droppedNewest, 0);
+    EXPECT_EQ(_session->counters().droppedOldest, 0);
+
+    /* The oldest messages are delivered, so the received ones start from the first */
+    drain();
+    const auto numbers = received();
+    ASSERT_THAT(numbers, Not(IsEmpty()));
+    EXPECT_EQ(numbers.front(), 0);
+    EXPECT_TRUE(std::ranges::is_sorted(numbers));
+    EXPECT_EQ(numbers.size() + _session->counters().droppedNewest, 10000);
+}
+
+TEST_F(ChatSessionTest, StalledReaderWithDropOldest)
+{
+    connect({.queueMessages = 64,
+             .queueBytes = 64 * kMessageSize,
+             .policy = ChatSession::OverflowPolicy::DropOldest});
+
+    post(10000);
+    EXPECT_LE(_maxQueuedMessages, 64);
+    EXPECT_LE(_maxQueuedBytes, 64 * kMessageSize);
+    EXPECT_GT(_session->counters().droppedOldest, 0);
+
+    /* The newest messages are kept, so the last posted is delivered */
+    drain();
+    const auto numbers = received();
+    ASSERT_THAT(numbers, Not(IsEmpty()));
+    EXPECT_EQ(numbers.back(), 9999);
+    EXPECT_TRUE(std::ranges::is_sorted(numbers));
+    EXPECT_EQ(numbers.size() + _session->counters().droppedOldest
+                  + _session->counters().droppedNewest,
+              10000);
+}
+
+TEST_F(ChatSessionTest, StalledReaderWithCoalesce)
+{
+    connect({.queueMessages = 8,
+             .queueBytes = 256 * kMessageSize,
+             .policy = ChatSession::OverflowPolicy::Coalesce});
+
+    post(1000);
+    EXPECT_LE(_maxQueuedMessages, 8);
+    EXPECT_LE(_maxQueuedBytes, 256 * kMessageSize);
+    EXPECT_GT(_session->counters().coalesced, 0);
+    EXPECT_GT(_session->counters().droppedNewest, 0);
+
+    /* Merged messages are delivered in order and completely */
+    drain();
+    const auto numbers = received();
+    ASSERT_THAT(numbers, Not(IsEmpty()));
+    EXPECT_EQ(numbers.front(), 0);
+    EXPECT_TRUE(std::ranges::is_sorted(numbers));
+    EXPECT_EQ(_received.size() % kMessageSize, 0);
+    EXPECT_EQ(numbers.size() + _session->counters().droppedNewest, 1000);
+}
+
+TEST_F(ChatSessionTest, StalledReaderWithDisconnect)
+{
+    connect({.queueMessages = 64,
+             .queueBytes = 64 * kMessageSize,
+             .policy = ChatSession::OverflowPolicy::Disconnect});
+
+    post(10000);
+    EXPECT_LE(_maxQueuedBytes, 64 * kMessageSize);
+    EXPECT_EQ(_session->counters().disconnects, 1);
+
+    /* The client is reported as gone (by both failed read and write) and nothing is queued */
+    drain();
+    EXPECT_GE(_errors, 1);
+    EXPECT_EQ(_session->queuedMessages(), 0);
+    EXPECT_EQ(_session->queuedBytes(), 0);
+}
+
+TEST_F(ChatSessionTest, SlowReaderStaysBounded)
+{
+    for (const auto policy : {ChatSession::OverflowPolicy::DropOldest,
+                              ChatSession::OverflowPolicy::DropNewest,
+                              ChatSession::OverflowPolicy::Coalesce}) {
+        _posted = 0;
+        _received.clear();
+        _maxQueuedBytes = _maxQueuedMessages = 0;
+        _client = tcp::socket{_context, tcp::v4()};
+        connect({.queueMessages = 32, .queueBytes = 32 * kMessageSize, .policy = policy});
+
+        /* The client reads a half of the posted data, so the queue is always full */
+        post(20000, 8 * kMessageSize);
+        EXPECT_LE(_maxQueuedMessages, 32);
+        EXPECT_LE(_maxQueuedBytes, 32 * kMessageSize);
+        EXPECT_EQ(_session->counters().disconnects, 0);
+        EXPECT_GT(_received.size(), 0);
+    }
+}
+
+TEST_F(ChatSessionTest, FastReaderLosesNothing)
+{
+    connect({.queueMessages = 64,
+             .queueBytes = 64 * kMessageSize,
+             .policy = ChatSession::OverflowPolicy::Disconnect});
+
+    for (int n{0}; n < 100; ++n) {
+        post(10);
+        drain();
+    }
+    EXPECT_EQ(_session->counters().disconnects, 0);
+    EXPECT_EQ(received().size(), 1000);
+}
+
+
+TEST_F(ChatSessionTest, ReceivesFrames)
+{
+    connect(ChatSession::Limits{.framing = Framing::Length, .frameBytes = 16});
+
+    const std::string_view binary{"\0\n\0", 3};
+    sendFrame("first", 5);
+    sendFrame(binary, binary.size());
+    sendFrame("", 0);
+    sendFrame("0123456789abcdef", 16);
+    while (_messages.size() < 4 && _errors == 0) {
+        _context.run_one();
+    }
+
+    EXPECT_THAT(_messages, ElementsAre("first", binary, "", "0123456789abcdef"));
+    EXPECT_EQ(_errors, 0);
+}
+
+TEST_F(ChatSessionTest, RejectsOversizedFrame)
+{
+    connect(ChatSession::Limits{.framing = Framing::Length, .frameBytes = 16});
+
+    sendFrame("first", 5);
+    sendFrame("0123456789abcdefg", 17);
+    while (_errors == 0) {
+        _context.run_one();
+    }
+
+    EXPECT_THAT(_messages, ElementsAre("first"));
+    EXPECT_EQ(_errors, 1);
+}
+
+TEST_F(ChatSessionTest, RateLimitDropsExcess)
+{
+    connect(ChatSession::Limits{
+        .rate = 1, .burst = 3, .ratePolicy = ChatSession::RatePolicy::Drop});
+
+    const std::string lines{"0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n"};
+    asio::write(_client, asio::buffer(lines));
+    while (_messages.size() + _session->counters().limitedMessages < 10) {
+        _context.run_one();
+    }
+
+    EXPECT_THAT(_messages, ElementsAre("0\n", "1\n", "2\n"));
+    EXPECT_EQ(_session->counters().limitedMessages, 7);
+    EXPECT_EQ(_session->counters().limitedBytes, 14);
+}
+
+TEST_F(ChatSessionTest, RateLimitDelaysExcess)
+{
+    connect(ChatSession::Limits{.rate = 100, .burst = 2});
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::string lines{"0\n1\n2\n3\n4\n5\n"};
+    asio::write(_client, asio::buffer(lines));
+    while (_messages.size() < 6) {
+        _context.run_one();
+    }
+
+    /* Messages over the burst are received one per 10 ms */
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{40});
+    EXPECT_THAT(_messages, ElementsAre("0\n", "1\n", "2\n", "3\n", "4\n", "5\n"));
+    EXPECT_GE(_session->counters().limitedMessages, 1);
+    EXPECT_EQ(_errors, 0);
+}
+
+TEST_F(ChatSessionTest, SharedRateLimitsSessions)
+{
+    auto shared = std::make_shared<TokenBucket>(1, 2);
+    connect(ChatSession::Limits{
+        .rate = 100, .ratePolicy = ChatSession::RatePolicy::Drop, .sharedRate = shared});
+    shared->take(1);
+
+    asio::write(_client, asio::buffer(std::string_view{"0\n1\n2\n"}));
+    while (_messages.size() + _session->counters().limitedMessages < 3) {
+        _context.run_one();
+    }
+
+    EXPECT_THAT(_messages, ElementsAre("0\n"));
+    EXPECT_EQ(_session->counters().limitedMessages, 2);
+}
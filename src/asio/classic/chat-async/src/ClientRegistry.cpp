@@ -0,0 +1,142 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ClientRegistry.hpp"
+
+ClientRegistry::Shard::Shard(asio::io_context& context)
+    : strand{context}
+{
+}
+
+ClientRegistry::ClientRegistry(asio::io_context& context, std::size_t shardsNum)
+{
+    assert(shardsNum > 0);
+    _shards.reserve(shardsNum);
+    for (std::size_t n{0}; n < shardsNum; ++n) {
+        _shards.push_back(std::make_unique<Shard>(context));
+    }
+}
+
+ClientRegistry::ShardId
+ClientRegistry::pick()
+{
+    return _next.fetch_add(1, std::memory_order_relaxed) % _shards.size();
+}
+
+asio::io_context::strand
+ClientRegistry::strand(ShardId shard) const
+{
+    return _shards[shard]->strand;
+}
+
+void
+ClientRegistry::add(ShardId shard, ChatSession::Ptr client, std::vector<Message> greeting)
+{
+    Shard& owner = *_shards[shard];
+    asio::post(owner.strand,
+               [this, &owner, client = std::move(client), greeting = std::move(greeting)]() {
+                   if (!greeting.empty()) {
+                       client->post(std::span<const Message>{greeting});
+                   }
+                   if (owner.clients.insert(client).second) {
+                       _size.fetch_add(1, std::memory_order_relaxed);
+                   }
+               });
+}
+
+void
+ClientRegistry::remove(ShardId shard, ChatSession::Ptr client, std::function<void()> onRemoved)
+{
+    Shard& owner = *_shards[shard];
+    asio::post(owner.strand,
+               [this, &owner, client = std::move(client), onRemoved = std::move(onRemoved)]() {
+                   /* Both read and write failures report an error, only the first one counts */
+                   if (owner.clients.erase(client) > 0) {
+                       owner.topics.unsubscribe(client.get());
+                       _size.fetch_sub(1, std::memory_order_relaxed);
+                       if (onRemoved) {
+                           onRemoved();
+                       }
+                   }
+               });
+}
+
+void
+ClientRegistry::send(ShardId shard, ChatSession::Ptr client, Message message)
+{
+    asio::post(_shards[shard]->strand,
+               [client = std::move(client), message = std::move(message)]() {
+                   client->post(message);
+               });
+}
+
+void
+ClientRegistry::broadcast(const Message& message)
+{
+    for (const auto& shard : _shards) {
+        asio::post(shard->strand, [&owner = *shard, message]() {
+            for (const auto& client : owner.clients) {
+                client->post(message);
+            }
+        });
+    }
+}
+
+void
+ClientRegistry::subscribe(ShardId shard, ChatSession::Ptr client, std::string pattern)
+{
+    Shard& owner = *_shards[shard];
+    asio::post(owner.strand,
+               [&owner, client = std::move(client), pattern = std::move(pattern)]() {
+                   /* The client might have gone before subscription is handled */
+                   if (owner.clients.contains(client)) {
+                       owner.topics.subscribe(pattern, client.get());
+                   }
+               });
+}
+
+void
+ClientRegistry::unsubscribe(ShardId shard, ChatSession::Ptr client, std::string pattern)
+{
+    Shard& owner = *_shards[shard];
+    asio::post(owner.strand,
+               [&owner, client = std::move(client), pattern = std::move(pattern)]() {
+                   owner.topics.unsubscribe(pattern, client.get());
+               });
+}
+
+void
+ClientRegistry::publish(std::string_view topic, const Message& message)
+{
+    for (const auto& shard : _shards) {
+        asio::post(shard->strand, [&owner = *shard, topic, message]() {
+            owner.topics.match(topic, owner.matched);
+            for (ChatSession* client : owner.matched) {
+                client->post(message);
+            }
+        });
+    }
+}
+
+std::size_t
+ClientRegistry::shardsNum() const
+{
+    return _shards.size();
+}
+
+std::size_t
+ClientRegistry::size() const
+{
+    return _size.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,185 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HistoryLog.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::string_view kMagic{"CHATLOG1"};
+constexpr std::size_t kLengthSize{sizeof(std::uint32_t)};
+
+[[noreturn]] void
+throwError(const char* what)
+{
+    throw boost::system::system_error{errno, boost::system::system_category(), what};
+}
+
+std::uint32_t
+loadLength(const char* data)
+{
+    std::uint32_t length;
+    std::memcpy(&length, data, sizeof(length));
+    return length;
+}
+
+void
+storeLength(char* data, std::uint32_t length)
+{
+    std::memcpy(data, &length, sizeof(length));
+}
+
+} // namespace
+
+HistoryLog::HistoryLog(std::filesystem::path path, std::size_t capacity)
+    : _path{std::move(path)}
+    , _capacity{capacity}
+{
+    assert(capacity > kMagic.size());
+
+    map(_path);
+    _end = scan(nullptr);
+}
+
+HistoryLog::~HistoryLog()
+{
+    unmap();
+}
+
+void
+HistoryLog::forEach(const std::function<void(std::string_view record)>& handler) const
+{
+    scan(&handler);
+}
+
+bool
+HistoryLog::append(std::string_view record)
+{
+    if (record.empty() || _end + kLengthSize + record.size() > _capacity) {
+        return false;
+    }
+
+    /* The length goes last, until then the record isn't a part of the log */
+    std::memcpy(_data + _end + kLengthSize, record.data(), record.size());
+    storeLength(_data + _end, static_cast<std::uint32_t>(record.size()));
+    _end += kLengthSize + record.size();
+    return true;
+}
+
+void
+HistoryLog::rewrite(std::span<const std::string_view> records)
+{
+    auto path = _path;
+    path += ".tmp";
+
+    /* The oldest records are dropped if all of them don't fit */
+    std::size_t first{records.size()};
+    for (std::size_t bytes{kMagic.size()}; first > 0; --first) {
+        bytes += kLengthSize + records[first - 1].size();
+        if (bytes > _capacity) {
+            break;
+        }
+    }
+
+    unmap();
+    std::filesystem::remove(path);
+    map(path);
+    _end = kMagic.size();
+    for (const auto record : records.subspan(first)) {
+        [[maybe_unused]] const bool appended = append(record);
+    }
+    if (::msync(_data, _capacity, MS_SYNC) < 0) {
+        throwError("msync");
+    }
+    std::filesystem::rename(path, _path);
+}
+
+std::size_t
+HistoryLog::size() const
+{
+    return _end - kMagic.size();
+}
+
+std::size_t
+HistoryLog::capacityFor(std::size_t records, std::size_t recordBytes)
+{
+    return kMagic.size() + records * (kLengthSize + recordBytes);
+}
+
+std::size_t
+HistoryLog::scan(const std::function<void(std::string_view record)>* handler) const
+{
+    std::size_t offset{kMagic.size()};
+    while (offset + kLengthSize <= _capacity) {
+        const std::uint32_t length = loadLength(_data + offset);
+        /* A record cut by resizing the log ends it as well */
+        if (length == 0 || offset + kLengthSize + length > _capacity) {
+            break;
+        }
+        if (handler != nullptr) {
+            (*handler)(std::string_view{_data + offset + kLengthSize, length});
+        }
+        offset += kLengthSize + length;
+    }
+    return offset;
+}
+
+void
+HistoryLog::map(const std::filesystem::path& path)
+{
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throwError("open");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(_capacity)) < 0) {
+        ::close(fd);
+        throwError("ftruncate");
+    }
+    void* data = ::mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* The mapping keeps the file open */
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throwError("mmap");
+    }
+    _data = static_cast<char*>(data);
+
+    /* A new file is zero-filled by ftruncate() */
+    const std::string_view magic{_data, kMagic.size()};
+    if (magic.find_first_not_of('\0') == std::string_view::npos) {
+        std::memcpy(_data, kMagic.data(), kMagic.size());
+    } else if (magic != kMagic) {
+        unmap();
+        throw boost::system::system_error{
+            EINVAL, boost::system::system_category(), "Not a chat history log"};
+    }
+    _end = kMagic.size();
+}
+
+void
+HistoryLog::unmap()
+{
+    if (_data != nullptr) {
+        ::munmap(_data, _capacity);
+        _data = nullptr;
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "HistoryLog.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+constexpr std::size_t kCapacity{64};
+
+std::vector<std::string>
+records(const HistoryLog& log)
+{
+    std::vector<std::string> result;
+    log.forEach([&](std::string_view record) { result.emplace_back(record); });
+    return result;
+}
+
+} // namespace
+
+class HistoryLogTest : public Test {
+public:
+    HistoryLogTest()
+        : path{std::filesystem::temp_directory_path()
+               / ("history-log-test-" + std::to_string(::getpid()) + ".log")}
+    {
+        std::filesystem::remove(path);
+    }
+
+    ~HistoryLogTest() override
+    {
+        std::filesystem::remove(path);
+    }
+
+protected:
+    std::filesystem::path path;
+};
+
+TEST_F(HistoryLogTest, AppendsRecords)
+{
+    HistoryLog log{path, kCapacity};
+    EXPECT_TRUE(log.append("first"));
+    EXPECT_TRUE(log.append("second"));
+    EXPECT_FALSE(log.append(""));
+    EXPECT_THAT(records(log), ElementsAre("first", "second"));
+    EXPECT_EQ(log.size(), 2 * sizeof(std::uint32_t) + 11);
+}
+
+TEST_F(HistoryLogTest, SurvivesReopening)
+{
+    {
+        HistoryLog log{path, kCapacity};
+        EXPECT_TRUE(log.append("first"));
+        EXPECT_TRUE(log.append("second"));
+    }
+    HistoryLog log{path, kCapacity};
+    EXPECT_THAT(records(log), ElementsAre("first", "second"));
+
+    /* Appending continues after the last record */
+    EXPECT_TRUE(log.append("third"));
+    EXPECT_THAT(records(log), ElementsAre("first", "second", "third"));
+}
+
+TEST_F(HistoryLogTest, RejectsRecordOverCapacity)
+{
+    HistoryLog log{path, kCapacity};
+    EXPECT_TRUE(log.append(std::string(40, 'x')));
+    EXPECT_FALSE(log.append(std::string(20, 'y')));
+    EXPECT_TRUE(log.append(std::string(8, 'z')));
+    EXPECT_THAT(records(log), ElementsAre(std::string(40, 'x'), std::string(8, 'z')));
+}
+
+TEST_F(HistoryLogTest, Rewrites)
+{
+    {
+        HistoryLog log{path, kCapacity};
+        EXPECT_TRUE(log.append(std::string(40, 'x')));
+        const std::vector<std::string_view> kept{"second", "third"};
+        log.rewrite(kept);
+        EXPECT_THAT(records(log), ElementsAre("second", "third"));
+        EXPECT_TRUE(log.append("fourth"));
+    }
+    HistoryLog log{path, kCapacity};
+    EXPECT_THAT(records(log), ElementsAre("second", "third", "fourth"));
+}
+
+TEST_F(HistoryLogTest, RewriteKeepsNewestRecords)
+{
+    HistoryLog log{path, kCapacity};
+    const std::string oldest(40, 'x');
+    const std::vector<std::string_view> kept{oldest, "second", "third"};
+    log.rewrite(kept);
+    EXPECT_THAT(records(log), ElementsAre("second", "third"));
+}
+
+TEST_F(HistoryLogTest, ComputesCapacityForRecords)
+{
+    HistoryLog log{path, HistoryLog::capacityFor(2, 8)};
+    EXPECT_TRUE(log.append(std::string(8, 'x')));
+    EXPECT_TRUE(log.append(std::string(8, 'y')));
+    EXPECT_FALSE(log.append("z"));
+}
+
+TEST_F(HistoryLogTest, RejectsForeignFile)
+{
+    std::ofstream{path} << "not a history log";
+    EXPECT_THROW(HistoryLog(path, kCapacity), boost::system::system_error);
+}
@@ -0,0 +1,67 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LineFramer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+LineFramer::LineFramer(std::size_t capacity)
+    : _buffer(capacity)
+{
+    assert(capacity > 0);
+}
+
+asio::mutable_buffer
+LineFramer::prepare()
+{
+    /* Move incomplete line to the beginning to make room for the rest of it */
+    if (_begin > 0) {
+        std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+        _scanned -= _begin;
+        _end -= _begin;
+        _begin = 0;
+    }
+    return asio::buffer(_buffer.data() + _end, _buffer.size() - _end);
+}
+
+void
+LineFramer::commit(std::size_t bytes)
+{
+    assert(_end + bytes <= _buffer.size());
+    _end += bytes;
+}
+
+std::optional<std::string_view>
+LineFramer::next()
+{
+    const auto first = _buffer.begin() + _scanned;
+    const auto last = _buffer.begin() + _end;
+    const auto delimiter = std::find(first, last, '\n');
+    if (delimiter == last) {
+        _scanned = _end;
+        return std::nullopt;
+    }
+
+    const std::size_t end = (delimiter - _buffer.begin()) + 1;
+    const std::string_view line{_buffer.data() + _begin, end - _begin};
+    _begin = _scanned = end;
+    return line;
+}
+
+bool
+LineFramer::overflowed() const
+{
+    return (_begin == 0 && _end == _buffer.size() && _scanned == _end);
+}
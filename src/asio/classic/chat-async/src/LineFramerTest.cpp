@@ -0,0 +1,85 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "LineFramer.hpp"
+
+#include <cstring>
+
+using namespace testing;
+
+namespace {
+
+void
+receive(LineFramer& framer, std::string_view data)
+{
+    const auto buffer = framer.prepare();
+    ASSERT_GE(buffer.size(), data.size());
+    std::memcpy(buffer.data(), data.data(), data.size());
+    framer.commit(data.size());
+}
+
+std::vector<std::string>
+lines(LineFramer& framer)
+{
+    std::vector<std::string> result;
+    while (const auto line = framer.next()) {
+        result.emplace_back(*line);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(LineFramerTest, SplitsLines)
+{
+    LineFramer framer{64};
+    receive(framer, "first\nsecond\nthi");
+    EXPECT_THAT(lines(framer), ElementsAre("first\n", "second\n"));
+    receive(framer, "rd\n\n");
+    EXPECT_THAT(lines(framer), ElementsAre("third\n", "\n"));
+    EXPECT_FALSE(framer.overflowed());
+}
+
+TEST(LineFramerTest, LineReceivedInParts)
+{
+    LineFramer framer{16};
+    for (const char c : std::string_view{"0123456789abcde"}) {
+        receive(framer, std::string_view{&c, 1});
+        EXPECT_THAT(lines(framer), IsEmpty());
+    }
+    receive(framer, "\n");
+    EXPECT_THAT(lines(framer), ElementsAre("0123456789abcde\n"));
+}
+
+TEST(LineFramerTest, ReusesSpaceOfHandledLines)
+{
+    LineFramer framer{8};
+    for (int n{0}; n < 100; ++n) {
+        receive(framer, "abc\nde");
+        EXPECT_THAT(lines(framer), ElementsAre("abc\n"));
+        receive(framer, "\n");
+        EXPECT_THAT(lines(framer), ElementsAre("de\n"));
+    }
+}
+
+TEST(LineFramerTest, Overflow)
+{
+    LineFramer framer{8};
+    receive(framer, "01234567");
+    EXPECT_THAT(lines(framer), IsEmpty());
+    EXPECT_TRUE(framer.overflowed());
+}
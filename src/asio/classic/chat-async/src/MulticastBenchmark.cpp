@@ -0,0 +1,295 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ClientRegistry.hpp"
+#include "MulticastPublisher.hpp"
+#include "MulticastSubscriber.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * CPU cost of a broadcast with TCP fan-out versus UDP multicast
+ *
+ * The server side runs on one thread: it either fans each message out to the given number of
+ * loopback TCP sessions (one shard of client registry) or publishes it once to a multicast
+ * group joined by the same number of loopback subscribers. Receivers run on a separate thread.
+ * The CPU time of the server thread is measured per broadcast. Note that delivery of loopback
+ * multicast to every subscriber socket happens in the sending thread and is charged to it,
+ * on a LAN the copies are made by the network instead.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9094};
+    std::string group{"239.255.0.2"};
+    std::uint16_t groupPort{9095};
+    std::size_t messages{1000};
+    std::size_t burst{20};
+    std::size_t messageSize{128};
+};
+
+struct Result {
+    double broadcastsPerSecond{0};
+    double cpuPerBroadcast{0};
+    double lost{0};
+};
+
+struct Client {
+    tcp::socket socket;
+};
+
+/* How long to wait for lost datagrams of a burst */
+constexpr std::chrono::milliseconds kLossTimeout{200};
+
+/* The received data isn't inspected, all clients read into the same buffer */
+char discard[65536];
+
+void
+read(Client& client, std::atomic<std::size_t>& total)
+{
+    client.socket.async_read_some(asio::buffer(discard),
+                                  [&client, &total](sys::error_code errorCode, std::size_t bytes) {
+                                      if (!errorCode) {
+                                          total.fetch_add(bytes, std::memory_order_relaxed);
+                                          read(client, total);
+                                      }
+                                  });
+}
+
+bool
+raiseFileLimit(std::size_t clients)
+{
+    /* Each client takes two descriptors (client and server side of a connection) */
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    return (limit.rlim_cur > 2 * clients + 64);
+}
+
+/* Returns CPU time consumed by the thread in seconds */
+double
+cpuTime(std::jthread& thread)
+{
+    clockid_t clock{};
+    ::pthread_getcpuclockid(thread.native_handle(), &clock);
+    timespec time{};
+    ::clock_gettime(clock, &time);
+    return double(time.tv_sec) + double(time.tv_nsec) * 1e-9;
+}
+
+/* Posts bursts of broadcasts to the server thread, each burst is delivered (or given up as
+   lost) before the next one, returns the number of units received */
+template<typename Broadcast>
+std::size_t
+runBursts(const BenchOptions& options,
+          asio::io_context& serverContext,
+          Broadcast broadcast,
+          const std::atomic<std::size_t>& received,
+          std::size_t unitsPerBroadcast,
+          bool lossy)
+{
+    for (std::size_t posted{0}; posted < options.messages;) {
+        const std::size_t burst = std::min(options.burst, options.messages - posted);
+        asio::post(serverContext, [&broadcast, burst]() {
+            for (std::size_t m{0}; m < burst; ++m) {
+                broadcast();
+            }
+        });
+        posted += burst;
+
+        const std::size_t expected = unitsPerBroadcast * posted;
+        const auto deadline = std::chrono::steady_clock::now() + kLossTimeout;
+        while (received.load(std::memory_order_relaxed) < expected) {
+            if (lossy && std::chrono::steady_clock::now() > deadline) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    return received.load(std::memory_order_relaxed);
+}
+
+Result
+runTcp(const BenchOptions& options, std::size_t clientsNum)
+{
+    asio::io_context serverContext;
+    asio::io_context clientContext;
+    auto serverGuard = asio::make_work_guard(serverContext);
+    auto clientGuard = asio::make_work_guard(clientContext);
+
+    tcp::acceptor acceptor{serverContext,
+                           tcp::endpoint{asio::ip::address_v4::loopback(), options.port}};
+    ClientRegistry registry{serverContext, 1};
+
+    std::vector<std::unique_ptr<Client>> clients;
+    clients.reserve(clientsNum);
+    for (std::size_t n{0}; n < clientsNum; ++n) {
+        auto client = std::make_unique<Client>(tcp::socket{clientContext});
+        client->socket.connect(acceptor.local_endpoint());
+        const auto shard = registry.pick();
+        auto session = std::make_shared<ChatSession>(
+            registry.strand(shard), acceptor.accept(), ChatSession::Limits{});
+        session->start([](std::string_view, std::string_view) {}, []() {});
+        registry.add(shard, std::move(session));
+        clients.push_back(std::move(client));
+    }
+
+    std::atomic<std::size_t> received{0};
+    for (auto& client : clients) {
+        read(*client, received);
+    }
+
+    std::jthread server{[&]() { serverContext.run(); }};
+    std::jthread receiver{[&]() { clientContext.run(); }};
+    while (registry.size() < clientsNum) {
+        std::this_thread::yield();
+    }
+
+    const Message message{std::string(options.messageSize, 'x')};
+    const double cpuStart = cpuTime(server);
+    const auto start = std::chrono::steady_clock::now();
+    runBursts(
+        options,
+        serverContext,
+        [&]() { registry.broadcast(message); },
+        received,
+        clientsNum * message.size(),
+        false);
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const double cpu = cpuTime(server) - cpuStart;
+
+    serverContext.stop();
+    clientContext.stop();
+    return Result{options.messages / elapsed.count(), cpu / options.messages, 0};
+}
+
+Result
+runMulticast(const BenchOptions& options, std::size_t clientsNum)
+{
+    asio::io_context serverContext;
+    asio::io_context clientContext;
+    auto serverGuard = asio::make_work_guard(serverContext);
+    auto clientGuard = asio::make_work_guard(clientContext);
+
+    const udp::endpoint group{asio::ip::make_address(options.group), options.groupPort};
+    const auto interface = asio::ip::address_v4::loopback();
+    MulticastPublisher publisher{serverContext, group, interface, options.burst};
+
+    std::atomic<std::size_t> received{0};
+    std::vector<std::unique_ptr<MulticastSubscriber>> subscribers;
+    subscribers.reserve(clientsNum);
+    for (std::size_t n{0}; n < clientsNum; ++n) {
+        subscribers.push_back(
+            std::make_unique<MulticastSubscriber>(clientContext, group, interface));
+        subscribers.back()->start(
+            [&received](std::uint64_t, std::string_view) {
+                received.fetch_add(1, std::memory_order_relaxed);
+            },
+            {});
+    }
+
+    std::jthread server{[&]() { serverContext.run(); }};
+    std::jthread receiver{[&]() { clientContext.run(); }};
+
+    const std::string text(options.messageSize, 'x');
+    const double cpuStart = cpuTime(server);
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t delivered = runBursts(
+        options, serverContext, [&]() { publisher.publish(text); }, received, clientsNum, true);
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const double cpu = cpuTime(server) - cpuStart;
+
+    serverContext.stop();
+    clientContext.stop();
+    const double expected = double(clientsNum * options.messages);
+    return Result{options.messages / elapsed.count(),
+                  cpu / options.messages,
+                  (expected - double(delivered)) / expected};
+}
+
+void
+print(std::size_t clientsNum, const char* mode, const Result& result)
+{
+    std::printf("%8zu %10s %14.0f %14.2f %10.2f\n",
+                clientsNum,
+                mode,
+                result.broadcastsPerSecond,
+                result.cpuPerBroadcast * 1e6,
+                result.lost * 100);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::vector<std::size_t> clients;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9094), "Set port")
+        ("group,g", po::value<std::string>(&options.group)->default_value("239.255.0.2"), "Set multicast group")
+        ("group-port", po::value<std::uint16_t>(&options.groupPort)->default_value(9095), "Set port of multicast group")
+        ("clients,c", po::value<std::vector<std::size_t>>(&clients)->multitoken()->default_value({10, 100, 1000}, "10 100 1000"), "Set numbers of clients")
+        ("messages,m", po::value<std::size_t>(&options.messages)->default_value(1000), "Set number of broadcasts per run")
+        ("burst,b", po::value<std::size_t>(&options.burst)->default_value(20), "Set number of broadcasts per burst")
+        ("size,s", po::value<std::size_t>(&options.messageSize)->default_value(128), "Set message size")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.messages == 0 || options.burst == 0 || options.messageSize == 0
+        || std::ranges::count(clients, 0) > 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf(
+        "%8s %10s %14s %14s %10s\n", "clients", "mode", "broadcasts/s", "cpu us/bcast", "lost %");
+    for (const std::size_t clientsNum : clients) {
+        if (!raiseFileLimit(clientsNum)) {
+            std::printf("%8zu  skipped: not enough file descriptors\n", clientsNum);
+            continue;
+        }
+        print(clientsNum, "tcp", runTcp(options, clientsNum));
+        print(clientsNum, "multicast", runMulticast(options, clientsNum));
+    }
+    return EXIT_SUCCESS;
+}
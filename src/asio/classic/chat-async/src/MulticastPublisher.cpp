@@ -0,0 +1,105 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MulticastPublisher.hpp"
+
+#include <algorithm>
+
+namespace {
+
+void
+storeSequence(char* data, std::uint64_t sequence)
+{
+    for (std::size_t n{MulticastPublisher::kSequenceSize}; n > 0; --n) {
+        data[n - 1] = static_cast<char>(sequence & 0xFF);
+        sequence >>= 8;
+    }
+}
+
+} // namespace
+
+MulticastPublisher::MulticastPublisher(asio::io_context& context,
+                                       const udp::endpoint& group,
+                                       const asio::ip::address_v4& interface,
+                                       std::size_t retained)
+    : _socket{context, udp::v4()}
+    , _group{group}
+    , _retained{retained}
+{
+    _socket.set_option(asio::ip::multicast::outbound_interface{interface});
+    _socket.set_option(asio::ip::multicast::enable_loopback{true});
+    /* Datagrams don't leave the local network */
+    _socket.set_option(asio::ip::multicast::hops{1});
+    /* Datagrams are dropped rather than block publishing (subscribers recover gaps) */
+    _socket.non_blocking(true);
+}
+
+std::uint64_t
+MulticastPublisher::publish(std::string_view text)
+{
+    char header[kSequenceSize];
+
+    std::lock_guard lock{_guard};
+    const std::uint64_t sequence = _next++;
+    storeSequence(header, sequence);
+    Message datagram{std::string_view{header, sizeof(header)}, text};
+
+    sys::error_code errorCode;
+    _socket.send_to(datagram.buffer(), _group, 0, errorCode);
+    if (errorCode) {
+        ++_counters.failed;
+    } else {
+        ++_counters.sent;
+    }
+    _retained.push_back(std::move(datagram));
+    return sequence;
+}
+
+void
+MulticastPublisher::retained(std::uint64_t first,
+                             std::size_t count,
+                             std::vector<Message>& datagrams) const
+{
+    std::lock_guard lock{_guard};
+    /* The oldest retained datagram */
+    const std::uint64_t oldest = _next - _retained.size();
+    const std::uint64_t begin = std::max(first, oldest);
+    const std::uint64_t end = std::min(first + count, _next);
+    for (std::uint64_t sequence{begin}; sequence < end; ++sequence) {
+        datagrams.push_back(_retained[sequence - oldest]);
+    }
+}
+
+MulticastPublisher::Counters
+MulticastPublisher::counters() const
+{
+    std::lock_guard lock{_guard};
+    return _counters;
+}
+
+std::uint64_t
+MulticastPublisher::sequence(std::string_view datagram)
+{
+    std::uint64_t sequence{0};
+    for (std::size_t n{0}; n < std::min(kSequenceSize, datagram.size()); ++n) {
+        sequence = (sequence << 8) | static_cast<std::uint8_t>(datagram[n]);
+    }
+    return sequence;
+}
+
+std::string_view
+MulticastPublisher::text(std::string_view datagram)
+{
+    return datagram.substr(std::min(kSequenceSize, datagram.size()));
+}
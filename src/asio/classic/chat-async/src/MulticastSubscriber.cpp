@@ -0,0 +1,86 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MulticastSubscriber.hpp"
+#include "MulticastPublisher.hpp"
+
+#include <iostream>
+
+namespace {
+
+/* The maximum size of UDP datagram */
+constexpr std::size_t kMaxDatagram{65536};
+
+} // namespace
+
+MulticastSubscriber::MulticastSubscriber(asio::io_context& context,
+                                         const udp::endpoint& group,
+                                         const asio::ip::address_v4& interface)
+    : _socket{context, udp::v4()}
+    , _buffer(kMaxDatagram)
+{
+    /* Every subscriber on the host gets its own copy of each datagram */
+    _socket.set_option(udp::socket::reuse_address{true});
+    _socket.bind(udp::endpoint{asio::ip::address_v4::any(), group.port()});
+    _socket.set_option(asio::ip::multicast::join_group{group.address().to_v4(), interface});
+}
+
+void
+MulticastSubscriber::start(MessageHandler onMessage, GapHandler onGap)
+{
+    _onMessage = std::move(onMessage);
+    _onGap = std::move(onGap);
+    receive();
+}
+
+void
+MulticastSubscriber::stop()
+{
+    sys::error_code errorCode;
+    _socket.close(errorCode);
+}
+
+void
+MulticastSubscriber::receive()
+{
+    _socket.async_receive(asio::buffer(_buffer),
+                          std::bind_front(&MulticastSubscriber::onReceive, this));
+}
+
+void
+MulticastSubscriber::onReceive(sys::error_code errorCode, std::size_t bytes)
+{
+    if (errorCode) {
+        if (errorCode != asio::error::operation_aborted) {
+            std::cerr << "onReceive: " << errorCode.message() << std::endl;
+        }
+        return;
+    }
+
+    const std::string_view datagram{_buffer.data(), bytes};
+    if (datagram.size() >= MulticastPublisher::kSequenceSize) {
+        SequenceTracker::Gap gap;
+        const auto sequence = MulticastPublisher::sequence(datagram);
+        if (_tracker.receive(sequence, gap)) {
+            if (gap.count > 0 && _onGap) {
+                _onGap(gap);
+            }
+            _onMessage(sequence, MulticastPublisher::text(datagram));
+        }
+    }
+    /* The handler may have stopped receiving */
+    if (_socket.is_open()) {
+        receive();
+    }
+}
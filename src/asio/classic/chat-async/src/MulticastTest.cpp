@@ -0,0 +1,127 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "MulticastPublisher.hpp"
+#include "MulticastSubscriber.hpp"
+#include "SequenceTracker.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+const asio::ip::address_v4 kLoopback{asio::ip::address_v4::loopback()};
+
+/* A group per process to not mix datagrams of tests running concurrently */
+udp::endpoint
+group()
+{
+    return udp::endpoint{asio::ip::make_address("239.255.0.1"),
+                         static_cast<std::uint16_t>(40000 + ::getpid() % 20000)};
+}
+
+} // namespace
+
+TEST(SequenceTrackerTest, StartsFromFirstReceived)
+{
+    SequenceTracker tracker;
+    SequenceTracker::Gap gap;
+    EXPECT_EQ(tracker.next(), 0);
+    EXPECT_TRUE(tracker.receive(10, gap));
+    EXPECT_EQ(gap.count, 0);
+    EXPECT_EQ(tracker.next(), 11);
+}
+
+TEST(SequenceTrackerTest, ReportsGap)
+{
+    SequenceTracker tracker;
+    SequenceTracker::Gap gap;
+    EXPECT_TRUE(tracker.receive(1, gap));
+    EXPECT_TRUE(tracker.receive(2, gap));
+    EXPECT_EQ(gap.count, 0);
+    EXPECT_TRUE(tracker.receive(5, gap));
+    EXPECT_EQ(gap.first, 3);
+    EXPECT_EQ(gap.count, 2);
+    EXPECT_EQ(tracker.next(), 6);
+}
+
+TEST(SequenceTrackerTest, DropsStale)
+{
+    SequenceTracker tracker;
+    SequenceTracker::Gap gap;
+    EXPECT_TRUE(tracker.receive(1, gap));
+    EXPECT_TRUE(tracker.receive(3, gap));
+    EXPECT_FALSE(tracker.receive(2, gap));
+    EXPECT_FALSE(tracker.receive(3, gap));
+    EXPECT_EQ(tracker.next(), 4);
+}
+
+TEST(MulticastPublisherTest, RetainsLastDatagrams)
+{
+    asio::io_context context;
+    MulticastPublisher publisher{context, group(), kLoopback, 2};
+    EXPECT_EQ(publisher.publish("first"), 1);
+    EXPECT_EQ(publisher.publish("second"), 2);
+    EXPECT_EQ(publisher.publish("third"), 3);
+
+    std::vector<::Message> datagrams;
+    publisher.retained(1, 10, datagrams);
+    ASSERT_THAT(datagrams, SizeIs(2));
+    EXPECT_EQ(MulticastPublisher::sequence(datagrams[0].view()), 2);
+    EXPECT_EQ(MulticastPublisher::text(datagrams[0].view()), "second");
+    EXPECT_EQ(MulticastPublisher::sequence(datagrams[1].view()), 3);
+    EXPECT_EQ(MulticastPublisher::text(datagrams[1].view()), "third");
+
+    datagrams.clear();
+    publisher.retained(3, 1, datagrams);
+    ASSERT_THAT(datagrams, SizeIs(1));
+    EXPECT_EQ(MulticastPublisher::text(datagrams[0].view()), "third");
+
+    datagrams.clear();
+    publisher.retained(4, 1, datagrams);
+    EXPECT_THAT(datagrams, IsEmpty());
+}
+
+TEST(MulticastPublisherTest, DeliversToSubscriber)
+{
+    asio::io_context context;
+    MulticastSubscriber subscriber{context, group(), kLoopback};
+    std::vector<std::pair<std::uint64_t, std::string>> received;
+    subscriber.start(
+        [&](std::uint64_t sequence, std::string_view text) {
+            received.emplace_back(sequence, text);
+            if (received.size() == 2) {
+                subscriber.stop();
+            }
+        },
+        [](const SequenceTracker::Gap&) { FAIL() << "Unexpected gap"; });
+
+    asio::io_context publishing;
+    MulticastPublisher publisher{publishing, group(), kLoopback, 16};
+    publisher.publish("Hello\n\r");
+    publisher.publish("World\n\r");
+
+    context.run_for(std::chrono::seconds{5});
+    EXPECT_THAT(received, ElementsAre(Pair(1, "Hello\n\r"), Pair(2, "World\n\r")));
+    EXPECT_EQ(publisher.counters().sent, 2);
+}
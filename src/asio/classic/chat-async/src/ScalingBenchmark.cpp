@@ -0,0 +1,191 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ClientRegistry.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Broadcast throughput scaling of sharded client registry
+ *
+ * The server context runs on the given number of threads and the registry has one shard
+ * per thread. Loopback clients are drained by a separate context running on the same number
+ * of threads. Broadcasts are posted in bursts, each burst is delivered before the next one.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9093};
+    std::size_t clients{1000};
+    std::size_t messages{200};
+    std::size_t burst{20};
+    std::size_t messageSize{128};
+};
+
+struct Client {
+    tcp::socket socket;
+};
+
+/* The received data isn't inspected, clients of one thread read into the same buffer */
+thread_local char discard[65536];
+
+void
+read(Client& client, std::atomic<std::size_t>& total)
+{
+    client.socket.async_read_some(asio::buffer(discard),
+                                  [&client, &total](sys::error_code errorCode, std::size_t bytes) {
+                                      if (!errorCode) {
+                                          total.fetch_add(bytes, std::memory_order_relaxed);
+                                          read(client, total);
+                                      }
+                                  });
+}
+
+bool
+raiseFileLimit(std::size_t clients)
+{
+    /* Each client takes two descriptors (client and server side of a connection) */
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    return (limit.rlim_cur > 2 * clients + 64);
+}
+
+void
+runBenchmark(const BenchOptions& options, std::size_t threadsNum)
+{
+    asio::io_context serverContext;
+    asio::io_context clientContext;
+    auto serverGuard = asio::make_work_guard(serverContext);
+    auto clientGuard = asio::make_work_guard(clientContext);
+
+    tcp::acceptor acceptor{serverContext,
+                           tcp::endpoint{asio::ip::address_v4::loopback(), options.port}};
+    ClientRegistry registry{serverContext, threadsNum};
+
+    std::vector<std::unique_ptr<Client>> clients;
+    clients.reserve(options.clients);
+    for (std::size_t n{0}; n < options.clients; ++n) {
+        auto client = std::make_unique<Client>(tcp::socket{clientContext});
+        client->socket.connect(acceptor.local_endpoint());
+        const auto shard = registry.pick();
+        auto session = std::make_shared<ChatSession>(
+            registry.strand(shard), acceptor.accept(), ChatSession::Limits{});
+        session->start([](std::string_view, std::string_view) {}, []() {});
+        registry.add(shard, std::move(session));
+        clients.push_back(std::move(client));
+    }
+
+    std::atomic<std::size_t> received{0};
+    for (auto& client : clients) {
+        read(*client, received);
+    }
+
+    std::vector<std::jthread> threads;
+    for (std::size_t n{0}; n < threadsNum; ++n) {
+        threads.emplace_back([&]() { serverContext.run(); });
+        threads.emplace_back([&]() { clientContext.run(); });
+    }
+    while (registry.size() < options.clients) {
+        std::this_thread::yield();
+    }
+
+    const Message message{std::string(options.messageSize, 'x')};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t posted{0}; posted < options.messages;) {
+        const std::size_t burst = std::min(options.burst, options.messages - posted);
+        for (std::size_t m{0}; m < burst; ++m) {
+            registry.broadcast(message);
+        }
+        posted += burst;
+
+        const std::size_t expected = options.clients * posted * message.size();
+        while (received.load(std::memory_order_relaxed) < expected) {
+            std::this_thread::yield();
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    serverContext.stop();
+    clientContext.stop();
+    threads.clear();
+
+    const double delivered = double(options.clients * options.messages);
+    std::printf("%8zu %8zu %14.0f %14.0f\n",
+                threadsNum,
+                options.clients,
+                options.messages / elapsed.count(),
+                delivered / elapsed.count());
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::vector<std::size_t> threads;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9093), "Set port")
+        ("threads,t", po::value<std::vector<std::size_t>>(&threads)->multitoken()->default_value({1, 2, 4, 8}, "1 2 4 8"), "Set numbers of threads")
+        ("clients,c", po::value<std::size_t>(&options.clients)->default_value(1000), "Set number of clients")
+        ("messages,m", po::value<std::size_t>(&options.messages)->default_value(200), "Set number of broadcasts per run")
+        ("burst,b", po::value<std::size_t>(&options.burst)->default_value(20), "Set number of broadcasts per burst")
+        ("size,s", po::value<std::size_t>(&options.messageSize)->default_value(128), "Set message size")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.clients == 0 || options.messages == 0 || options.burst == 0
+        || options.messageSize == 0 || std::ranges::count(threads, 0) > 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!raiseFileLimit(options.clients)) {
+        std::cerr << "Not enough file descriptors for " << options.clients << " clients"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%8s %8s %14s %14s\n", "threads", "clients", "broadcasts/s", "deliveries/s");
+    for (const std::size_t threadsNum : threads) {
+        runBenchmark(options, threadsNum);
+    }
+    return EXIT_SUCCESS;
+}
@@ -16,12 +16,80 @@
 #include "ChatServer.hpp"
 #include "Runner.hpp"
 
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+namespace po = boost::program_options;
+
+/* The number of threads running the context (one shard of clients per thread) */
+constexpr std::size_t kThreadsNum{4};
+
 int
-main()
+main(int argc, char* argv[])
 {
+    std::string framing;
+    std::size_t history{0};
+    std::string historyLog;
+    std::string multicast;
+    std::uint16_t multicastPort{0};
+    std::string multicastInterface;
+    double rate{0};
+    double burst{0};
+    double totalRate{0};
+    double totalBurst{0};
+    std::string ratePolicy;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("framing,f", po::value<std::string>(&framing)->default_value("line"), "Set framing of messages (line or length)")
+        ("history,n", po::value<std::size_t>(&history)->default_value(32), "Set number of last messages replayed to joining clients")
+        ("history-log,l", po::value<std::string>(&historyLog), "Set file to keep history in between restarts")
+        ("multicast,m", po::value<std::string>(&multicast), "Set multicast group to publish messages for all clients to (e.g. 239.255.0.1)")
+        ("multicast-port", po::value<std::uint16_t>(&multicastPort)->default_value(8081), "Set port of multicast group")
+        ("multicast-interface", po::value<std::string>(&multicastInterface)->default_value("127.0.0.1"), "Set address of interface to publish multicast messages via")
+        ("rate", po::value<double>(&rate)->default_value(0), "Set maximum rate of messages per client (per second, unlimited if zero)")
+        ("burst", po::value<double>(&burst)->default_value(16), "Set number of messages per client received at once over the rate")
+        ("total-rate", po::value<double>(&totalRate)->default_value(0), "Set maximum rate of messages from all clients (per second, unlimited if zero)")
+        ("total-burst", po::value<double>(&totalBurst)->default_value(256), "Set number of messages from all clients received at once over the rate")
+        ("rate-policy", po::value<std::string>(&ratePolicy)->default_value("delay"), "Set what to do with messages over the rate (drop or delay)")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if ((framing != "line" && framing != "length")
+        || (ratePolicy != "drop" && ratePolicy != "delay") || rate < 0 || totalRate < 0
+        || burst < 1 || totalBurst < 1) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
     Runner runner;
-    ChatServer server{runner.context(), 8080};
+    ChatServer server{runner.context(),
+                      8080,
+                      kThreadsNum,
+                      (framing == "line") ? Framing::Line : Framing::Length};
+    server.keepHistory(history, historyLog);
+    server.limitRate(rate,
+                     burst,
+                     totalRate,
+                     totalBurst,
+                     (ratePolicy == "drop") ? ChatSession::RatePolicy::Drop
+                                            : ChatSession::RatePolicy::Delay);
+    if (!multicast.empty()) {
+        server.multicast(udp::endpoint{asio::ip::make_address(multicast), multicastPort},
+                         asio::ip::make_address_v4(multicastInterface));
+    }
     server.listen();
-    runner.run(4);
+    runner.run(kThreadsNum);
     return EXIT_SUCCESS;
 }
\ No newline at end of file
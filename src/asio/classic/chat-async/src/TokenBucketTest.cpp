@@ -0,0 +1,79 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "TokenBucket.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+TEST(TokenBucketTest, AllowsBurst)
+{
+    TokenBucket bucket{10, 3};
+    const auto now = TokenBucket::Clock::now();
+    EXPECT_EQ(bucket.take(1, now), 0ns);
+    EXPECT_EQ(bucket.take(2, now), 0ns);
+    EXPECT_EQ(bucket.take(1, now), 100ms);
+    EXPECT_EQ(bucket.take(2, now), 200ms);
+}
+
+TEST(TokenBucketTest, Refills)
+{
+    TokenBucket bucket{10, 2};
+    const auto now = TokenBucket::Clock::now();
+    EXPECT_EQ(bucket.take(2, now), 0ns);
+    EXPECT_EQ(bucket.take(1, now + 50ms), 50ms);
+    EXPECT_EQ(bucket.take(1, now + 100ms), 0ns);
+    EXPECT_EQ(bucket.take(1, now + 100ms), 100ms);
+    /* Tokens don't accumulate over the burst size */
+    EXPECT_EQ(bucket.take(2, now + 10s), 0ns);
+    EXPECT_EQ(bucket.take(1, now + 10s), 100ms);
+}
+
+TEST(TokenBucketTest, TakesBackGiven)
+{
+    TokenBucket bucket{10, 2};
+    const auto now = TokenBucket::Clock::now();
+    EXPECT_EQ(bucket.take(2, now), 0ns);
+    bucket.give(1);
+    EXPECT_EQ(bucket.take(1, now), 0ns);
+    EXPECT_EQ(bucket.take(1, now), 100ms);
+}
+
+TEST(TokenBucketTest, SharedByThreads)
+{
+    constexpr std::size_t kThreads{4};
+    constexpr std::size_t kAttempts{10000};
+
+    TokenBucket bucket{1, 1000};
+    const auto now = TokenBucket::Clock::now();
+    std::atomic<std::size_t> taken{0};
+    std::vector<std::jthread> threads;
+    for (std::size_t n{0}; n < kThreads; ++n) {
+        threads.emplace_back([&]() {
+            for (std::size_t attempt{0}; attempt < kAttempts; ++attempt) {
+                if (bucket.take(1, now) == 0ns) {
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    threads.clear();
+
+    EXPECT_EQ(taken, 1000);
+}
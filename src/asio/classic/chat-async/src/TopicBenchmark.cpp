@@ -0,0 +1,207 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TopicIndex.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Topic matching benchmark
+ *
+ * Subscribers subscribe to topics of "region/category/item" form, a part of subscriptions
+ * use wildcards ("region/+/item" or "region/category/#"). Random topics are published and
+ * matched with the index and with a scan over all subscriptions for comparison.
+ */
+
+namespace {
+
+using Subscriber = std::uint32_t;
+
+struct BenchOptions {
+    std::size_t subscriptions{100000};
+    std::size_t subscriptionsPerClient{10};
+    std::size_t regions{10};
+    std::size_t categories{100};
+    std::size_t items{100};
+    double wildcards{0.1};
+    std::size_t publishes{100000};
+};
+
+struct Subscription {
+    std::string pattern;
+    Subscriber subscriber;
+};
+
+std::string
+topic(std::size_t region, std::size_t category, std::size_t item)
+{
+    return "r" + std::to_string(region) + "/c" + std::to_string(category) + "/i"
+           + std::to_string(item);
+}
+
+/* Reference matching of a pattern against topic level by level */
+bool
+matches(std::string_view pattern, std::string_view topic)
+{
+    while (true) {
+        const auto patternEnd = std::min(pattern.find('/'), pattern.size());
+        const auto topicEnd = std::min(topic.find('/'), topic.size());
+        const auto level = pattern.substr(0, patternEnd);
+        if (level == "#") {
+            return true;
+        }
+        if (level != "+" && level != topic.substr(0, topicEnd)) {
+            return false;
+        }
+        const bool patternLast = (patternEnd == pattern.size());
+        const bool topicLast = (topicEnd == topic.size());
+        if (patternLast || topicLast) {
+            return patternLast && topicLast;
+        }
+        pattern.remove_prefix(patternEnd + 1);
+        topic.remove_prefix(topicEnd + 1);
+    }
+}
+
+std::vector<Subscription>
+makeSubscriptions(const BenchOptions& options, std::mt19937& random)
+{
+    std::uniform_int_distribution<std::size_t> region{0, options.regions - 1};
+    std::uniform_int_distribution<std::size_t> category{0, options.categories - 1};
+    std::uniform_int_distribution<std::size_t> item{0, options.items - 1};
+    std::bernoulli_distribution wildcard{options.wildcards};
+    std::bernoulli_distribution anyCategory{0.5};
+
+    std::vector<Subscription> subscriptions;
+    subscriptions.reserve(options.subscriptions);
+    for (std::size_t n{0}; n < options.subscriptions; ++n) {
+        const auto subscriber = static_cast<Subscriber>(n / options.subscriptionsPerClient);
+        const auto r = region(random), c = category(random), i = item(random);
+        if (!wildcard(random)) {
+            subscriptions.push_back({topic(r, c, i), subscriber});
+        } else if (anyCategory(random)) {
+            subscriptions.push_back(
+                {"r" + std::to_string(r) + "/+/i" + std::to_string(i), subscriber});
+        } else {
+            subscriptions.push_back(
+                {"r" + std::to_string(r) + "/c" + std::to_string(c) + "/#", subscriber});
+        }
+    }
+    return subscriptions;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("subscriptions,n", po::value<std::size_t>(&options.subscriptions)->default_value(100000), "Set number of subscriptions")
+        ("per-client,k", po::value<std::size_t>(&options.subscriptionsPerClient)->default_value(10), "Set number of subscriptions per client")
+        ("wildcards,w", po::value<double>(&options.wildcards)->default_value(0.1), "Set share of wildcard subscriptions")
+        ("publishes,m", po::value<std::size_t>(&options.publishes)->default_value(100000), "Set number of published topics")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.subscriptions == 0 || options.subscriptionsPerClient == 0
+        || options.publishes == 0 || options.wildcards < 0.0 || options.wildcards > 1.0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random{42};
+    const auto subscriptions = makeSubscriptions(options, random);
+
+    TopicIndex<Subscriber> index;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& subscription : subscriptions) {
+        index.subscribe(subscription.pattern, subscription.subscriber);
+    }
+    const std::chrono::duration<double> buildTime{std::chrono::steady_clock::now() - start};
+
+    std::uniform_int_distribution<std::size_t> region{0, options.regions - 1};
+    std::uniform_int_distribution<std::size_t> category{0, options.categories - 1};
+    std::uniform_int_distribution<std::size_t> item{0, options.items - 1};
+    std::vector<std::string> topics;
+    topics.reserve(options.publishes);
+    for (std::size_t n{0}; n < options.publishes; ++n) {
+        topics.push_back(topic(region(random), category(random), item(random)));
+    }
+
+    std::vector<Subscriber> matched;
+    std::size_t indexMatches{0};
+    start = std::chrono::steady_clock::now();
+    for (const auto& topic : topics) {
+        index.match(topic, matched);
+        indexMatches += matched.size();
+    }
+    const std::chrono::duration<double> indexTime{std::chrono::steady_clock::now() - start};
+
+    /* Scan is slow, so it's done for a part of topics only */
+    const std::size_t scanned = std::max<std::size_t>(1, topics.size() / 100);
+    std::size_t scanMatches{0};
+    start = std::chrono::steady_clock::now();
+    for (std::size_t n{0}; n < scanned; ++n) {
+        matched.clear();
+        for (const auto& subscription : subscriptions) {
+            if (matches(subscription.pattern, topics[n])) {
+                matched.push_back(subscription.subscriber);
+            }
+        }
+        std::sort(matched.begin(), matched.end());
+        scanMatches += std::unique(matched.begin(), matched.end()) - matched.begin();
+    }
+    const std::chrono::duration<double> scanTime{std::chrono::steady_clock::now() - start};
+
+    std::printf("%zu subscriptions (%zu in index) built in %.1f ms\n",
+                subscriptions.size(),
+                index.size(),
+                buildTime.count() * 1000);
+    std::printf("%8s %14s %14s %14s\n", "method", "publishes/s", "ns/publish", "matches/pub");
+    std::printf("%8s %14.0f %14.0f %14.2f\n",
+                "index",
+                topics.size() / indexTime.count(),
+                indexTime.count() * 1e9 / topics.size(),
+                double(indexMatches) / topics.size());
+    std::printf("%8s %14.0f %14.0f %14.2f\n",
+                "scan",
+                scanned / scanTime.count(),
+                scanTime.count() * 1e9 / scanned,
+                double(scanMatches) / scanned);
+    return EXIT_SUCCESS;
+}
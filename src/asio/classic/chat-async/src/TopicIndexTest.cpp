@@ -0,0 +1,110 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "TopicIndex.hpp"
+
+using namespace testing;
+
+namespace {
+
+std::vector<int>
+matching(const TopicIndex<int>& index, std::string_view topic)
+{
+    std::vector<int> subscribers;
+    index.match(topic, subscribers);
+    return subscribers;
+}
+
+} // namespace
+
+TEST(TopicIndexTest, Validation)
+{
+    EXPECT_TRUE(TopicIndex<int>::isValidTopic("news/sport"));
+    EXPECT_FALSE(TopicIndex<int>::isValidTopic(""));
+    EXPECT_FALSE(TopicIndex<int>::isValidTopic("news/+"));
+
+    EXPECT_TRUE(TopicIndex<int>::isValidPattern("news/+/football"));
+    EXPECT_TRUE(TopicIndex<int>::isValidPattern("news/#"));
+    EXPECT_TRUE(TopicIndex<int>::isValidPattern("#"));
+    EXPECT_FALSE(TopicIndex<int>::isValidPattern(""));
+    EXPECT_FALSE(TopicIndex<int>::isValidPattern("news/#/football"));
+    EXPECT_FALSE(TopicIndex<int>::isValidPattern("news/sp+rt"));
+}
+
+TEST(TopicIndexTest, ExactTopics)
+{
+    TopicIndex<int> index;
+    EXPECT_TRUE(index.subscribe("news/sport", 1));
+    EXPECT_TRUE(index.subscribe("news/sport", 2));
+    EXPECT_TRUE(index.subscribe("news/weather", 3));
+    EXPECT_FALSE(index.subscribe("news/sport", 1));
+    EXPECT_EQ(index.size(), 3);
+
+    EXPECT_THAT(matching(index, "news/sport"), UnorderedElementsAre(1, 2));
+    EXPECT_THAT(matching(index, "news/weather"), ElementsAre(3));
+    EXPECT_THAT(matching(index, "news"), IsEmpty());
+    EXPECT_THAT(matching(index, "news/sport/football"), IsEmpty());
+}
+
+TEST(TopicIndexTest, Wildcards)
+{
+    TopicIndex<int> index;
+    index.subscribe("news/+/football", 1);
+    index.subscribe("news/#", 2);
+    index.subscribe("#", 3);
+    index.subscribe("+", 4);
+    index.subscribe("news/+", 5);
+
+    EXPECT_THAT(matching(index, "news/sport/football"), ElementsAre(1, 2, 3));
+    EXPECT_THAT(matching(index, "news/sport"), ElementsAre(2, 3, 5));
+    EXPECT_THAT(matching(index, "news"), ElementsAre(2, 3, 4));
+    EXPECT_THAT(matching(index, "weather"), ElementsAre(3, 4));
+    EXPECT_THAT(matching(index, "weather/today"), ElementsAre(3));
+}
+
+TEST(TopicIndexTest, SubscriberMatchedOnce)
+{
+    TopicIndex<int> index;
+    index.subscribe("news/sport", 1);
+    index.subscribe("news/+", 1);
+    index.subscribe("news/#", 1);
+    index.subscribe("news/#", 2);
+
+    EXPECT_THAT(matching(index, "news/sport"), ElementsAre(1, 2));
+}
+
+TEST(TopicIndexTest, Unsubscribe)
+{
+    TopicIndex<int> index;
+    index.subscribe("news/sport", 1);
+    index.subscribe("news/+", 1);
+    index.subscribe("news/#", 2);
+
+    EXPECT_TRUE(index.unsubscribe("news/+", 1));
+    EXPECT_FALSE(index.unsubscribe("news/+", 1));
+    EXPECT_FALSE(index.unsubscribe("news/weather", 1));
+    EXPECT_THAT(matching(index, "news/sport"), ElementsAre(1, 2));
+    EXPECT_THAT(matching(index, "news/weather"), ElementsAre(2));
+
+    index.unsubscribe(2);
+    EXPECT_THAT(matching(index, "news/weather"), IsEmpty());
+    EXPECT_EQ(index.size(), 1);
+
+    index.unsubscribe(1);
+    EXPECT_THAT(matching(index, "news/sport"), IsEmpty());
+    EXPECT_EQ(index.size(), 0);
+}
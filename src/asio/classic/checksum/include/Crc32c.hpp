@@ -0,0 +1,86 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * CRC32C (Castagnoli polynomial, as in iSCSI and ext4) computed incrementally
+ *
+ * The SSE4.2 crc32 instruction over three interleaved streams combined by carry-less multiply
+ * (PCLMULQDQ) is used if the CPU supports both (checked at run time once), slicing-by-8 tables
+ * otherwise. Both implementations give the same value.
+ */
+class Crc32c {
+public:
+    enum class Implementation { Portable, Hardware };
+
+    /* Uses the fastest implementation supported */
+    Crc32c() noexcept;
+
+    /* Uses the given implementation (portable if hardware one isn't supported) */
+    explicit Crc32c(Implementation implementation) noexcept;
+
+    void
+    update(std::string_view data) noexcept;
+
+    void
+    update(const void* data, std::size_t size) noexcept;
+
+    /* Returns checksum of the data so far */
+    [[nodiscard]] std::uint32_t
+    value() const noexcept;
+
+    [[nodiscard]] Implementation
+    implementation() const noexcept;
+
+    [[nodiscard]] static std::uint32_t
+    compute(std::string_view data) noexcept;
+
+    [[nodiscard]] static bool
+    hardwareSupported() noexcept;
+
+    /* Formats checksum as 8 hex digits */
+    [[nodiscard]] static std::string
+    toString(std::uint32_t value);
+
+    [[nodiscard]] static std::optional<std::uint32_t>
+    fromString(std::string_view string) noexcept;
+
+private:
+    using Update = std::uint32_t (*)(std::uint32_t, const unsigned char*, std::size_t);
+
+    Update _update;
+    std::uint32_t _state{0xFFFFFFFF};
+};
+
+//
+// Inlines
+//
+
+inline void
+Crc32c::update(std::string_view data) noexcept
+{
+    update(data.data(), data.size());
+}
+
+inline std::uint32_t
+Crc32c::value() const noexcept
+{
+    return ~_state;
+}
@@ -0,0 +1,189 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Crc32c.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace po = boost::program_options;
+using tcp = asio::ip::tcp;
+
+/**
+ * Cost of CRC32C per GiB against loopback receive rate
+ *
+ * The checksum alone is computed over an in-memory buffer. Then a writer thread streams the
+ * data over a TCP connection and the benchmark thread receives it without checksum or with
+ * one of the implementations updated by every read (as the chunked servers do in onBody).
+ * Rate and CPU time of the receiving thread per GiB show the share of the checksum.
+ */
+
+namespace {
+
+constexpr std::size_t kMiB{1024 * 1024};
+constexpr double kGiB{1024.0 * 1024 * 1024};
+
+struct BenchOptions {
+    std::uint16_t port{9095};
+    std::size_t size{4096 * kMiB};
+    std::size_t bufferSize{256 * 1024};
+};
+
+std::chrono::duration<double>
+threadCpuTime()
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+std::string
+makeData(std::size_t size)
+{
+    std::string data(size, '\0');
+    std::uint32_t seed{1};
+    for (auto& c : data) {
+        seed = seed * 1103515245 + 12345;
+        c = static_cast<char>(seed >> 16);
+    }
+    return data;
+}
+
+/* Returns milliseconds of checksum per GiB */
+double
+measureChecksum(const BenchOptions& options, Crc32c::Implementation implementation)
+{
+    const std::string data = makeData(64 * kMiB);
+    Crc32c crc{implementation};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t done{0}; done < options.size; done += data.size()) {
+        crc.update(data);
+    }
+    const std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now()
+                                                            - start};
+    /* Keeps the result used */
+    std::fprintf(stderr, "%08x\r", crc.value());
+    return elapsed.count() / (options.size / kGiB);
+}
+
+struct ReceiveResult {
+    double mibPerSecond{0};
+    double cpuMsPerGiB{0};
+};
+
+ReceiveResult
+measureReceive(const BenchOptions& options, std::optional<Crc32c::Implementation> implementation)
+{
+    asio::io_context context;
+    tcp::acceptor acceptor{context, {asio::ip::address_v4::loopback(), options.port}};
+    std::jthread writer{[&]() {
+        asio::io_context writerContext;
+        tcp::socket socket{writerContext};
+        socket.connect({asio::ip::address_v4::loopback(), options.port});
+        const std::string data = makeData(options.bufferSize);
+        for (std::size_t sent{0}; sent < options.size; sent += data.size()) {
+            asio::write(socket, asio::buffer(data));
+        }
+    }};
+    tcp::socket socket = acceptor.accept();
+
+    std::vector<char> buffer(options.bufferSize);
+    Crc32c crc{implementation.value_or(Crc32c::Implementation::Portable)};
+    std::size_t received{0};
+    const auto cpuStart = threadCpuTime();
+    const auto start = std::chrono::steady_clock::now();
+    while (received < options.size) {
+        const std::size_t size = socket.read_some(asio::buffer(buffer));
+        if (implementation) {
+            crc.update(buffer.data(), size);
+        }
+        received += size;
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const std::chrono::duration<double, std::milli> cpu{threadCpuTime() - cpuStart};
+    std::fprintf(stderr, "%08x\r", crc.value());
+
+    const double gib = received / kGiB;
+    return {received / kMiB / elapsed.count(), cpu.count() / gib};
+}
+
+void
+printRow(const char* mode, std::optional<double> checksumMs, const ReceiveResult& receive)
+{
+    if (checksumMs) {
+        std::printf("%10s %14.1f", mode, *checksumMs);
+    } else {
+        std::printf("%10s %14s", mode, "-");
+    }
+    std::printf(" %14.1f %18.1f\n", receive.mibPerSecond, receive.cpuMsPerGiB);
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t size{0};
+    std::size_t bufferSize{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9095), "Set port")
+        ("size,s", po::value<std::size_t>(&size)->default_value(4096), "Set data size (MiB)")
+        ("buffer,b", po::value<std::size_t>(&bufferSize)->default_value(256), "Set read buffer size (KiB)")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (size == 0 || bufferSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.size = size * kMiB;
+    options.bufferSize = bufferSize * 1024;
+
+    std::printf(
+        "%10s %14s %14s %18s\n", "checksum", "crc ms/GiB", "recv MiB/s", "recv cpu ms/GiB");
+    printRow("none", std::nullopt, measureReceive(options, std::nullopt));
+    printRow("portable",
+             measureChecksum(options, Crc32c::Implementation::Portable),
+             measureReceive(options, Crc32c::Implementation::Portable));
+    if (Crc32c::hardwareSupported()) {
+        printRow("hardware",
+                 measureChecksum(options, Crc32c::Implementation::Hardware),
+                 measureReceive(options, Crc32c::Implementation::Hardware));
+    }
+    return EXIT_SUCCESS;
+}
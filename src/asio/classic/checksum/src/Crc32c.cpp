@@ -0,0 +1,228 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Crc32c.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+/* Reversed Castagnoli polynomial */
+constexpr std::uint32_t kPolynomial{0x82F63B78};
+
+using Tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+/* Table n maps a byte to its contribution n bytes before the end of 8-byte word */
+constexpr Tables
+makeTables()
+{
+    Tables tables{};
+    for (std::uint32_t byte{0}; byte < 256; ++byte) {
+        std::uint32_t crc = byte;
+        for (int bit{0}; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+        }
+        tables[0][byte] = crc;
+    }
+    for (std::size_t n{1}; n < tables.size(); ++n) {
+        for (std::uint32_t byte{0}; byte < 256; ++byte) {
+            const std::uint32_t prev = tables[n - 1][byte];
+            tables[n][byte] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr Tables kTables = makeTables();
+
+std::uint32_t
+updatePortable(std::uint32_t crc, const unsigned char* data, std::size_t size)
+{
+    static_assert(std::endian::native == std::endian::little);
+
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        word ^= crc;
+        crc = kTables[7][word & 0xFF] ^ kTables[6][(word >> 8) & 0xFF]
+              ^ kTables[5][(word >> 16) & 0xFF] ^ kTables[4][(word >> 24) & 0xFF]
+              ^ kTables[3][(word >> 32) & 0xFF] ^ kTables[2][(word >> 40) & 0xFF]
+              ^ kTables[1][(word >> 48) & 0xFF] ^ kTables[0][word >> 56];
+    }
+    for (; size > 0; ++data, --size) {
+        crc = (crc >> 8) ^ kTables[0][(crc ^ *data) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+/* Returns x^n mod P (reflected) */
+constexpr std::uint32_t
+powerOfX(std::size_t n)
+{
+    std::uint32_t value{0x80000000};
+    for (; n > 0; --n) {
+        value = (value >> 1) ^ ((value & 1) ? kPolynomial : 0);
+    }
+    return value;
+}
+
+/* Lengths of the parts of the three interleaved streams (long and short rounds) */
+constexpr std::size_t kLongPart{8 * 1024};
+constexpr std::size_t kShortPart{256};
+
+/* Constants shifting CRC over the number of zero bytes: x^(8 * bytes - 33) mod P, the carry-less
+   product with the constant is reduced by the crc32 instruction which multiplies by x^32 */
+constexpr std::uint32_t kLongShift1{powerOfX(8 * kLongPart - 33)};
+constexpr std::uint32_t kLongShift2{powerOfX(8 * 2 * kLongPart - 33)};
+constexpr std::uint32_t kShortShift1{powerOfX(8 * kShortPart - 33)};
+constexpr std::uint32_t kShortShift2{powerOfX(8 * 2 * kShortPart - 33)};
+
+__attribute__((target("sse4.2,pclmul"))) std::uint32_t
+shift(std::uint32_t crc, std::uint32_t constant)
+{
+    const __m128i product = _mm_clmulepi64_si128(
+        _mm_cvtsi32_si128(static_cast<int>(crc)), _mm_cvtsi32_si128(static_cast<int>(constant)), 0);
+    return static_cast<std::uint32_t>(
+        _mm_crc32_u64(0, static_cast<std::uint64_t>(_mm_cvtsi128_si64(product))));
+}
+
+__attribute__((target("sse4.2"))) inline std::uint64_t
+load(const unsigned char* data)
+{
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+/* Computes CRC of three consecutive parts at once (the crc32 instruction has latency of three
+   cycles but accepts one per cycle), then combines them shifting by carry-less multiply */
+__attribute__((target("sse4.2,pclmul"))) std::uint32_t
+updateParts(std::uint32_t crc,
+            const unsigned char*& data,
+            std::size_t& size,
+            std::size_t part,
+            std::uint32_t shift1,
+            std::uint32_t shift2)
+{
+    for (; size >= 3 * part; data += 3 * part, size -= 3 * part) {
+        std::uint64_t crc0 = crc;
+        std::uint64_t crc1{0};
+        std::uint64_t crc2{0};
+        for (std::size_t n{0}; n < part; n += 8) {
+            crc0 = _mm_crc32_u64(crc0, load(data + n));
+            crc1 = _mm_crc32_u64(crc1, load(data + part + n));
+            crc2 = _mm_crc32_u64(crc2, load(data + 2 * part + n));
+        }
+        crc = shift(static_cast<std::uint32_t>(crc0), shift2)
+              ^ shift(static_cast<std::uint32_t>(crc1), shift1) ^ static_cast<std::uint32_t>(crc2);
+    }
+    return crc;
+}
+
+__attribute__((target("sse4.2,pclmul"))) std::uint32_t
+updateHardware(std::uint32_t crc, const unsigned char* data, std::size_t size)
+{
+    crc = updateParts(crc, data, size, kLongPart, kLongShift1, kLongShift2);
+    crc = updateParts(crc, data, size, kShortPart, kShortShift1, kShortShift2);
+
+    std::uint64_t crc64 = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        crc64 = _mm_crc32_u64(crc64, load(data));
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+    for (; size > 0; ++data, --size) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+} // namespace
+
+Crc32c::Crc32c() noexcept
+    : Crc32c{hardwareSupported() ? Implementation::Hardware : Implementation::Portable}
+{
+}
+
+Crc32c::Crc32c(Implementation implementation) noexcept
+    : _update{&updatePortable}
+{
+#if defined(__x86_64__)
+    if (implementation == Implementation::Hardware && hardwareSupported()) {
+        _update = &updateHardware;
+    }
+#endif
+}
+
+void
+Crc32c::update(const void* data, std::size_t size) noexcept
+{
+    _state = _update(_state, static_cast<const unsigned char*>(data), size);
+}
+
+Crc32c::Implementation
+Crc32c::implementation() const noexcept
+{
+    return (_update == &updatePortable) ? Implementation::Portable : Implementation::Hardware;
+}
+
+std::uint32_t
+Crc32c::compute(std::string_view data) noexcept
+{
+    Crc32c crc;
+    crc.update(data);
+    return crc.value();
+}
+
+bool
+Crc32c::hardwareSupported() noexcept
+{
+#if defined(__x86_64__)
+    static const bool supported
+        = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+std::string
+Crc32c::toString(std::uint32_t value)
+{
+    std::string string(8, '0');
+    char buffer[8];
+    const auto rv = std::to_chars(std::begin(buffer), std::end(buffer), value, 16);
+    const auto length = static_cast<std::size_t>(rv.ptr - buffer);
+    std::memcpy(string.data() + string.size() - length, buffer, length);
+    return string;
+}
+
+std::optional<std::uint32_t>
+Crc32c::fromString(std::string_view string) noexcept
+{
+    std::uint32_t value{0};
+    const auto rv = std::from_chars(string.data(), string.data() + string.size(), value, 16);
+    if (string.empty() || rv.ec != std::errc{} || rv.ptr != string.data() + string.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
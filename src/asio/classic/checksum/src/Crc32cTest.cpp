@@ -0,0 +1,79 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Crc32c.hpp"
+
+#include <random>
+
+using namespace testing;
+
+TEST(Crc32cTest, ComputesKnownValues)
+{
+    /* Check values of RFC 3720 (iSCSI) */
+    EXPECT_EQ(Crc32c::compute(""), 0x00000000);
+    EXPECT_EQ(Crc32c::compute("123456789"), 0xE3069283);
+    EXPECT_EQ(Crc32c::compute(std::string(32, '\x00')), 0x8A9136AA);
+    EXPECT_EQ(Crc32c::compute(std::string(32, '\xFF')), 0x62A8AB43);
+}
+
+TEST(Crc32cTest, ComputesIncrementally)
+{
+    const std::string data{"The quick brown fox jumps over the lazy dog"};
+    for (std::size_t split{0}; split <= data.size(); ++split) {
+        Crc32c crc;
+        crc.update(std::string_view{data}.substr(0, split));
+        crc.update(std::string_view{data}.substr(split));
+        EXPECT_EQ(crc.value(), 0x22620404);
+    }
+}
+
+TEST(Crc32cTest, ImplementationsAgree)
+{
+    if (!Crc32c::hardwareSupported()) {
+        GTEST_SKIP() << "SSE4.2 or PCLMULQDQ isn't supported";
+    }
+
+    std::mt19937 random{42};
+    std::string data(64 * 1024 + 7, '\0');
+    for (auto& c : data) {
+        c = static_cast<char>(random());
+    }
+    /* Unaligned starts, tails shorter than a word and both lengths of interleaved parts */
+    for (std::size_t offset{0}; offset < 8; ++offset) {
+        for (const std::size_t size : {0, 1, 7, 8, 9, 63, 768, 4096, 24 * 1024 + 5, 64 * 1024}) {
+            const auto part = std::string_view{data}.substr(offset, size);
+            Crc32c portable{Crc32c::Implementation::Portable};
+            Crc32c hardware{Crc32c::Implementation::Hardware};
+            EXPECT_EQ(hardware.implementation(), Crc32c::Implementation::Hardware);
+            portable.update(part);
+            hardware.update(part);
+            EXPECT_EQ(portable.value(), hardware.value()) << offset << " " << size;
+        }
+    }
+}
+
+TEST(Crc32cTest, FormatsAndParses)
+{
+    EXPECT_EQ(Crc32c::toString(0xE3069283), "e3069283");
+    EXPECT_EQ(Crc32c::toString(0x0000ABCD), "0000abcd");
+    EXPECT_THAT(Crc32c::fromString("e3069283"), Optional(0xE3069283));
+    EXPECT_THAT(Crc32c::fromString("E3069283"), Optional(0xE3069283));
+    EXPECT_EQ(Crc32c::fromString(""), std::nullopt);
+    EXPECT_EQ(Crc32c::fromString("e30692831"), std::nullopt);
+    EXPECT_EQ(Crc32c::fromString("xyz"), std::nullopt);
+    EXPECT_EQ(Crc32c::fromString("12 "), std::nullopt);
+}
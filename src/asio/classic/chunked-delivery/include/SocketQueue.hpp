@@ -0,0 +1,58 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Http.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * Bounded queue of accepted connections waiting for a worker
+ *
+ * Pushing blocks while the queue is full, so the acceptor stops accepting and further
+ * connections wait in the listen backlog of the kernel instead of taking a thread each.
+ */
+class SocketQueue {
+public:
+    explicit SocketQueue(std::size_t capacity);
+
+    /* Queues socket, blocks while the queue is full (the socket is dropped if the queue is
+       closed) */
+    void
+    push(tcp::socket&& socket);
+
+    /* Takes the oldest socket, blocks while the queue is empty, returns none once the queue is
+       closed */
+    std::optional<tcp::socket>
+    pop();
+
+    /* Wakes up blocked callers and drops queued sockets, the queue stays closed */
+    void
+    close();
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    const std::size_t _capacity;
+    mutable std::mutex _guard;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+    std::deque<tcp::socket> _sockets;
+    bool _closed{false};
+};
@@ -16,18 +16,70 @@
 
 #include "Http.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <functional>
 #include <string_view>
 
+/**
+ * Synchronous client of chunked uploads
+ *
+ * With zero step chunks grow from kInitialChunkSize (doubling) up to the current size of the
+ * socket send buffer, so large payloads take a few chunk framings and writes per buffer
+ * filled.
+ */
 class TcpClient {
 public:
+    /* The size of the first chunk of adaptive sizing */
+    static constexpr std::size_t kInitialChunkSize{4 * 1024};
+
+    /* Called with the size of every chunk written and the time its write took */
+    using ChunkHandler = std::function<void(std::size_t size, std::chrono::nanoseconds elapsed)>;
+
     explicit TcpClient(net::io_context& context);
 
+    /* Logs every chunk written (on by default) */
+    void
+    verbose(bool enabled);
+
+    void
+    onChunk(ChunkHandler handler);
+
+    /* Uploads message in chunks of the step size (adaptive if zero), CRC32C of the message is
+       sent in the trailer */
     void
     send(std::string_view host,
          std::string_view port,
          std::string_view message,
-         std::size_t step = 5);
+         std::size_t step = 0);
+
+    /* Uploads file content, bodies of chunks are sent by sendfile (without copying to user
+       space, so without checksum) */
+    void
+    sendFile(std::string_view host,
+             std::string_view port,
+             const std::filesystem::path& path,
+             std::size_t step = 0);
+
+    /* Returns the size of the chunk following the one of the previous size (zero if none) */
+    [[nodiscard]] static std::size_t
+    nextChunkSize(const tcp::socket& socket, std::size_t previous, std::size_t step);
+
+private:
+    /* Connects and sends request header (announcing checksum trailer if requested), returns
+       false unless the server accepts the body */
+    bool
+    begin(beast::tcp_stream& stream,
+          std::string_view host,
+          std::string_view port,
+          bool checksum);
+
+    /* Logs and reports chunk of the size written since the given time point */
+    void
+    written(std::size_t size, std::chrono::steady_clock::time_point start);
 
 private:
     net::io_context& _context;
+    bool _verbose{true};
+    ChunkHandler _chunkHandler;
 };
\ No newline at end of file
@@ -15,13 +15,44 @@
 #pragma once
 
 #include "Http.hpp"
+#include "SocketQueue.hpp"
+#include "FileSink.hpp"
 
+#include <atomic>
+#include <filesystem>
+#include <optional>
 #include <string_view>
+#include <thread>
+#include <vector>
 
+/**
+ * Synchronous server of chunked uploads
+ *
+ * Either every accepted connection is served by a thread of its own, or connections are
+ * served by a fixed pool of workers. In the latter case accepted connections wait for a free
+ * worker in a bounded queue, and accepting pauses while the queue is full.
+ */
 class TcpServer {
 public:
+    /* Serves every connection by a thread of its own */
     explicit TcpServer(net::io_context& context);
 
+    /* Serves connections by the given number of workers, up to the given number of accepted
+       connections wait for a worker */
+    TcpServer(net::io_context& context, std::size_t workers, std::size_t queued);
+
+    /* Stops workers (once they finish connections being served) */
+    ~TcpServer();
+
+    /* Writes uploads to files in the directory as they arrive instead of keeping them in
+       memory (must be called before listening) */
+    void
+    storeUploads(std::filesystem::path directory, FileSink::Options options);
+
+    /* Logs every chunk read (on by default, must be called before listening) */
+    void
+    verbose(bool enabled);
+
     [[noreturn]] void
     listen(net::ip::port_type port);
 
@@ -32,6 +63,21 @@ private:
     static void
     handleSession(TcpServer* server, tcp::socket&& socket);
 
+    void
+    work();
+
+    void
+    serve(tcp::socket&& socket);
+
+    [[nodiscard]] std::filesystem::path
+    nextUploadPath();
+
 private:
     net::io_context& _context;
+    std::optional<SocketQueue> _queue;
+    std::vector<std::jthread> _workers;
+    std::filesystem::path _uploads;
+    FileSink::Options _sinkOptions;
+    std::atomic<std::size_t> _uploadsCount{0};
+    bool _verbose{true};
 };
\ No newline at end of file
@@ -0,0 +1,238 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TcpServer.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Connection rate and memory of thread-per-connection versus worker pool server
+ *
+ * The server runs in a child process (its log goes to /dev/null), so its threads and memory
+ * are measured alone: the peak number of threads is sampled, the peak resident and virtual
+ * sizes are reported by the kernel. Clients upload one chunk per connection from the given
+ * number of threads at once, optionally pausing before the body (slow clients keep a server
+ * thread busy longer).
+ */
+
+namespace {
+
+struct BenchOptions {
+    net::ip::port_type port{3340};
+    std::size_t connections{2000};
+    std::size_t concurrency{256};
+    std::size_t workers{8};
+    std::size_t queued{64};
+    std::size_t payloadSize{1024};
+    std::chrono::milliseconds think{0};
+};
+
+struct ServerStats {
+    std::size_t threads{0};
+    std::size_t residentKiB{0};
+    std::size_t virtualKiB{0};
+};
+
+/* Returns value (in its units) of the field of /proc/<pid>/status */
+std::size_t
+statusField(pid_t pid, std::string_view field)
+{
+    std::ifstream status{"/proc/" + std::to_string(pid) + "/status"};
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with(field) && line.size() > field.size() && line[field.size()] == ':') {
+            return std::stoul(line.substr(field.size() + 1));
+        }
+    }
+    return 0;
+}
+
+[[noreturn]] void
+runServer(const BenchOptions& options, bool pool)
+{
+    std::freopen("/dev/null", "w", stdout);
+    net::io_context context;
+    if (pool) {
+        TcpServer server{context, options.workers, options.queued};
+        server.listen(options.port);
+    } else {
+        TcpServer server{context};
+        server.listen(options.port);
+    }
+}
+
+/* Uploads payload as one chunk and waits until the server closes the connection */
+void
+upload(net::io_context& context,
+       const tcp::endpoint& endpoint,
+       std::string_view payload,
+       std::chrono::milliseconds think)
+{
+    beast::tcp_stream stream{context};
+    stream.connect(endpoint);
+    /* The body and the last chunk are small separate writes, delaying them (Nagle) would stall
+       every upload until the server acknowledges */
+    stream.socket().set_option(tcp::no_delay{true});
+
+    http::request<http::empty_body> req{http::verb::post, "/speech", kHttpVersion11};
+    req.set(http::field::transfer_encoding, "chunked");
+    req.set(http::field::expect, "100-continue");
+    http::request_serializer<http::empty_body, http::fields> reqSer{req};
+    http::write_header(stream, reqSer);
+
+    beast::flat_buffer buffer;
+    http::response<http::empty_body> res;
+    http::read(stream, buffer, res);
+
+    std::this_thread::sleep_for(think);
+    net::write(stream.socket(), http::make_chunk(net::buffer(payload)));
+    net::write(stream.socket(), http::make_chunk_last());
+
+    char byte;
+    sys::error_code error;
+    stream.socket().read_some(net::buffer(&byte, 1), error);
+}
+
+void
+runBenchmark(const BenchOptions& options, bool pool)
+{
+    /* Buffered output mustn't be inherited by the server */
+    std::fflush(stdout);
+    const pid_t server = ::fork();
+    if (server == 0) {
+        runServer(options, pool);
+    }
+
+    const tcp::endpoint endpoint{net::ip::address_v4::loopback(), options.port};
+    for (bool ready{false}; !ready;) {
+        net::io_context context;
+        tcp::socket socket{context};
+        sys::error_code error;
+        socket.connect(endpoint, error);
+        ready = !error;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    /* The probe connection above is served too */
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    std::atomic<bool> done{false};
+    ServerStats stats;
+    std::jthread sampler{[&]() {
+        while (!done) {
+            stats.threads = std::max(stats.threads, statusField(server, "Threads"));
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }};
+
+    const std::string payload(options.payloadSize, 'x');
+    std::atomic<std::size_t> started{0};
+    std::atomic<std::size_t> failed{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (std::size_t n{0}; n < options.concurrency; ++n) {
+            clients.emplace_back([&]() {
+                net::io_context context;
+                while (started.fetch_add(1) < options.connections) {
+                    try {
+                        upload(context, endpoint, payload, options.think);
+                    } catch (const sys::system_error&) {
+                        ++failed;
+                    }
+                }
+            });
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    done = true;
+    sampler.join();
+
+    stats.residentKiB = statusField(server, "VmHWM");
+    stats.virtualKiB = statusField(server, "VmPeak");
+    ::kill(server, SIGKILL);
+    ::waitpid(server, nullptr, 0);
+
+    std::printf("%8s %14.0f %10zu %14.1f %14.1f %8zu\n",
+                pool ? "pool" : "thread",
+                options.connections / elapsed.count(),
+                stats.threads,
+                stats.residentKiB / 1024.0,
+                stats.virtualKiB / 1024.0,
+                failed.load());
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t think{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<net::ip::port_type>(&options.port)->default_value(3340), "Set port")
+        ("connections,n", po::value<std::size_t>(&options.connections)->default_value(2000), "Set number of connections")
+        ("concurrency,c", po::value<std::size_t>(&options.concurrency)->default_value(256), "Set number of clients connected at once")
+        ("workers,w", po::value<std::size_t>(&options.workers)->default_value(8), "Set number of server workers")
+        ("queue,q", po::value<std::size_t>(&options.queued)->default_value(64), "Set number of connections waiting for server worker")
+        ("size,s", po::value<std::size_t>(&options.payloadSize)->default_value(1024), "Set payload size")
+        ("think,t", po::value<std::size_t>(&think)->default_value(0), "Set pause of clients before body (ms)")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.connections == 0 || options.concurrency == 0 || options.workers == 0
+        || options.queued == 0 || options.payloadSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.think = std::chrono::milliseconds{think};
+
+    std::printf("%8s %14s %10s %14s %14s %8s\n",
+                "mode",
+                "conns/s",
+                "threads",
+                "peak RSS MiB",
+                "peak VM MiB",
+                "failed");
+    runBenchmark(options, false);
+    ++options.port;
+    runBenchmark(options, true);
+    return EXIT_SUCCESS;
+}
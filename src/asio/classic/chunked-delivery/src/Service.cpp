@@ -17,6 +17,7 @@
 
 #include <boost/program_options.hpp>
 
+#include <optional>
 #include <string>
 
 namespace po = boost::program_options;
@@ -28,17 +29,40 @@ static void
 executeClient(net::io_context& context,
               std::string_view host,
               std::string_view port,
-              std::string_view message)
+              std::string_view message,
+              const std::string& file,
+              std::size_t step,
+              bool verbose)
 {
     TcpClient client{context};
-    client.send(host, port, message);
+    client.verbose(verbose);
+    if (file.empty()) {
+        client.send(host, port, message, step);
+    } else {
+        client.sendFile(host, port, file, step);
+    }
 }
 
 [[noreturn]] static void
-executeServer(net::io_context& context, std::string_view port)
+executeServer(net::io_context& context,
+              std::string_view port,
+              std::size_t workers,
+              std::size_t queued,
+              const std::string& uploads,
+              const FileSink::Options& options,
+              bool verbose)
 {
-    TcpServer server{context};
-    server.listen(port);
+    std::optional<TcpServer> server;
+    if (workers == 0) {
+        server.emplace(context);
+    } else {
+        server.emplace(context, workers, queued);
+    }
+    if (!uploads.empty()) {
+        server->storeUploads(uploads, options);
+    }
+    server->verbose(verbose);
+    server->listen(port);
 }
 
 int
@@ -49,6 +73,13 @@ main(int argc, char* argv[])
     std::string host;
     std::string port;
     std::string data;
+    std::string file;
+    std::size_t step{0};
+    std::size_t workers{0};
+    std::size_t queued{0};
+    std::string uploads;
+    FileSink::Options options;
+    bool quiet{false};
 
     po::options_description desc("Allowed options");
     // clang-format off
@@ -58,6 +89,13 @@ main(int argc, char* argv[])
         ("host,h", po::value<std::string>(&host)->default_value(DefaultHost), "Set host")
         ("port,p", po::value<std::string>(&port)->default_value(DefaultPort), "Set port")
         ("data,d", po::value<std::string>(&data), "Set data")
+        ("file,f", po::value<std::string>(&file), "Set file to upload (instead of data)")
+        ("step", po::value<std::size_t>(&step)->default_value(0), "Set chunk size (adaptive if zero)")
+        ("workers,w", po::value<std::size_t>(&workers)->default_value(0), "Set number of server workers (thread per connection if zero)")
+        ("queue,q", po::value<std::size_t>(&queued)->default_value(64), "Set number of connections waiting for server worker")
+        ("uploads,u", po::value<std::string>(&uploads), "Set directory to store uploads to (kept in memory if empty)")
+        ("direct", po::bool_switch(&options.direct), "Store uploads bypassing page cache (O_DIRECT)")
+        ("quiet", po::bool_switch(&quiet), "Don't log every chunk")
         ;
     // clang-format on
 
@@ -65,16 +103,17 @@ main(int argc, char* argv[])
     po::store(po::parse_command_line(argc, argv, desc), vm);
     po::notify(vm);
 
-    if (!runClient && !runServer) {
+    if ((!runClient && !runServer) || queued == 0
+        || (runClient && data.empty() && file.empty())) {
         return EXIT_FAILURE;
     }
 
     net::io_context context;
     if (runClient) {
-        executeClient(context, host, port, data);
+        executeClient(context, host, port, data, file, step, !quiet);
     }
     if (runServer) {
-        executeServer(context, port);
+        executeServer(context, port, workers, queued, uploads, options, !quiet);
     }
     return EXIT_SUCCESS;
 }
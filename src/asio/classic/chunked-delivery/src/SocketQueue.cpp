@@ -0,0 +1,72 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SocketQueue.hpp"
+
+#include <cassert>
+
+SocketQueue::SocketQueue(std::size_t capacity)
+    : _capacity{capacity}
+{
+    assert(capacity > 0);
+}
+
+void
+SocketQueue::push(tcp::socket&& socket)
+{
+    {
+        std::unique_lock lock{_guard};
+        _notFull.wait(lock, [this]() { return _closed || _sockets.size() < _capacity; });
+        if (_closed) {
+            return;
+        }
+        _sockets.push_back(std::move(socket));
+    }
+    _notEmpty.notify_one();
+}
+
+std::optional<tcp::socket>
+SocketQueue::pop()
+{
+    std::unique_lock lock{_guard};
+    _notEmpty.wait(lock, [this]() { return _closed || !_sockets.empty(); });
+    if (_closed) {
+        return std::nullopt;
+    }
+    tcp::socket socket{std::move(_sockets.front())};
+    _sockets.pop_front();
+    lock.unlock();
+    _notFull.notify_one();
+    return socket;
+}
+
+void
+SocketQueue::close()
+{
+    std::deque<tcp::socket> dropped;
+    {
+        std::lock_guard lock{_guard};
+        _closed = true;
+        dropped.swap(_sockets);
+    }
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+}
+
+std::size_t
+SocketQueue::size() const
+{
+    std::lock_guard lock{_guard};
+    return _sockets.size();
+}
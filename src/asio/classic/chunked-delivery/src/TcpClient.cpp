@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "TcpClient.hpp"
+#include "Crc32c.hpp"
 
+#include <sys/sendfile.h>
+
+#include <algorithm>
 #include <iostream>
 
 TcpClient::TcpClient(net::io_context& context)
@@ -21,6 +25,18 @@ TcpClient::TcpClient(net::io_context& context)
 {
 }
 
+void
+TcpClient::verbose(bool enabled)
+{
+    _verbose = enabled;
+}
+
+void
+TcpClient::onChunk(ChunkHandler handler)
+{
+    _chunkHandler = std::move(handler);
+}
+
 void
 TcpClient::send(std::string_view host,
                 std::string_view port,
@@ -30,14 +46,125 @@ TcpClient::send(std::string_view host,
     assert(!host.empty());
     assert(!port.empty());
     assert(!message.empty());
-    assert(step > 0);
-    assert(message.size() > step);
 
+    beast::tcp_stream stream(_context);
+    if (!begin(stream, host, port, true)) {
+        return;
+    }
+
+    Crc32c checksum;
+    std::size_t pos = 0;
+    std::size_t size = 0;
+    while (pos < message.size()) {
+        size = nextChunkSize(stream.socket(), size, step);
+        const auto chunk = message.substr(pos, size);
+        checksum.update(chunk);
+        const auto start = std::chrono::steady_clock::now();
+        net::write(stream.socket(), http::make_chunk(net::buffer(chunk)));
+        written(chunk.size(), start);
+        pos += size;
+    }
+    std::cout << "Client: Write chunk last\n";
+    http::fields trailer;
+    trailer.set(kChecksumField, Crc32c::toString(checksum.value()));
+    net::write(stream.socket(), http::make_chunk_last(trailer));
+
+    std::cout << "Client: Close\n";
+    stream.close();
+}
+
+void
+TcpClient::sendFile(std::string_view host,
+                    std::string_view port,
+                    const std::filesystem::path& path,
+                    std::size_t step)
+{
+    assert(!host.empty());
+    assert(!port.empty());
+
+    sys::error_code error;
+    beast::file file;
+    file.open(path.c_str(), beast::file_mode::scan, error);
+    if (error) {
+        throw sys::system_error{error, "open"};
+    }
+    const auto fileSize = static_cast<std::size_t>(file.size(error));
+    if (error) {
+        throw sys::system_error{error, "size"};
+    }
+
+    beast::tcp_stream stream(_context);
+    if (!begin(stream, host, port, false)) {
+        return;
+    }
+
+    auto& socket = stream.socket();
+    off_t offset = 0;
+    std::size_t size = 0;
+    while (static_cast<std::size_t>(offset) < fileSize) {
+        size = std::min(nextChunkSize(socket, size, step), fileSize - offset);
+        const auto start = std::chrono::steady_clock::now();
+        net::write(socket, http::chunk_header{size});
+        /* The socket is blocking, so sendfile returns once (a part of) the range is queued */
+        for (std::size_t remain = size; remain > 0;) {
+            const ssize_t sent
+                = ::sendfile(socket.native_handle(), file.native_handle(), &offset, remain);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw sys::system_error{errno, sys::system_category(), "sendfile"};
+            }
+            if (sent == 0) {
+                throw sys::system_error{net::error::eof, "sendfile"};
+            }
+            remain -= static_cast<std::size_t>(sent);
+        }
+        net::write(socket, http::chunk_crlf{});
+        written(size, start);
+    }
+    std::cout << "Client: Write chunk last\n";
+    net::write(socket, http::make_chunk_last());
+
+    std::cout << "Client: Close\n";
+    stream.close();
+}
+
+std::size_t
+TcpClient::nextChunkSize(const tcp::socket& socket, std::size_t previous, std::size_t step)
+{
+    if (step > 0) {
+        return step;
+    }
+    /* The kernel grows the send buffer while the connection is busy, so it's read every time */
+    net::socket_base::send_buffer_size sendBufferSize;
+    socket.get_option(sendBufferSize);
+    const auto limit
+        = std::max(static_cast<std::size_t>(sendBufferSize.value()), kInitialChunkSize);
+    return (previous == 0) ? kInitialChunkSize : std::min(previous * 2, limit);
+}
+
+void
+TcpClient::written(std::size_t size, std::chrono::steady_clock::time_point start)
+{
+    if (_verbose) {
+        std::cout << "Client: Write chunk (" << size << " size)\n";
+    }
+    if (_chunkHandler) {
+        _chunkHandler(size, std::chrono::steady_clock::now() - start);
+    }
+}
+
+bool
+TcpClient::begin(beast::tcp_stream& stream,
+                 std::string_view host,
+                 std::string_view port,
+                 bool checksum)
+{
     tcp::resolver resolver(_context);
     auto const results = resolver.resolve(host, port);
 
     std::cout << "Client: Connect to server\n";
-    beast::tcp_stream stream(_context);
     stream.connect(results);
 
     http::request<http::empty_body> req{http::verb::post, "/speech", kHttpVersion11};
@@ -45,6 +172,9 @@ TcpClient::send(std::string_view host,
     req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
     req.set(http::field::transfer_encoding, "chunked");
     req.set(http::field::expect, "100-continue");
+    if (checksum) {
+        req.set(http::field::trailer, kChecksumField);
+    }
     {
         std::cout << "Client: Write initial request\n";
         http::request_serializer<http::empty_body, http::fields> reqSer{req};
@@ -58,20 +188,7 @@ TcpClient::send(std::string_view host,
     if (res.result() != http::status::continue_) {
         std::cout << "Client: 100 continue expected\n";
         stream.close();
-        return;
-    }
-
-    std::size_t pos = 0;
-    while (pos < message.size()) {
-        auto chunkBuffer = net::buffer(message.substr(pos, step));
-        std::cout << "Client: Write chunk\n";
-        net::write(stream.socket(), http::make_chunk(chunkBuffer));
-        pos += step;
+        return false;
     }
-    std::cout << "Client: Write chunk last\n";
-    net::write(stream.socket(), http::make_chunk_last());
-
-    std::cout << "Client: Close\n";
-    sys::error_code error;
-    stream.close();
+    return true;
 }
\ No newline at end of file
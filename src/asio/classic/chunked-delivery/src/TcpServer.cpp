@@ -13,16 +13,58 @@
 // limitations under the License.
 
 #include "TcpServer.hpp"
+#include "Crc32c.hpp"
 
 #include <thread>
 #include <iostream>
 #include <charconv>
 
+namespace {
+
+constexpr std::size_t kReadBufferSize{64 * 1024};
+
+} // namespace
+
 TcpServer::TcpServer(net::io_context& context)
     : _context{context}
 {
 }
 
+TcpServer::TcpServer(net::io_context& context, std::size_t workers, std::size_t queued)
+    : _context{context}
+{
+    assert(workers > 0);
+    _queue.emplace(queued);
+    _workers.reserve(workers);
+    for (std::size_t n{0}; n < workers; ++n) {
+        _workers.emplace_back(&TcpServer::work, this);
+    }
+}
+
+TcpServer::~TcpServer()
+{
+    /* Idle workers wait for connections, they are joined once they see the queue closed and
+       finish the sessions they serve (before the members these sessions read are destroyed) */
+    if (_queue) {
+        _queue->close();
+    }
+    _workers.clear();
+}
+
+void
+TcpServer::storeUploads(std::filesystem::path directory, FileSink::Options options)
+{
+    std::filesystem::create_directories(directory);
+    _uploads = std::move(directory);
+    _sinkOptions = options;
+}
+
+void
+TcpServer::verbose(bool enabled)
+{
+    _verbose = enabled;
+}
+
 [[noreturn]] void
 TcpServer::listen(net::ip::port_type port)
 {
@@ -31,7 +73,12 @@ TcpServer::listen(net::ip::port_type port)
         tcp::socket socket{_context};
         acceptor.accept(socket);
         std::cout << "Server: New connection incoming\n";
-        std::thread{&TcpServer::handleSession, this, std::move(socket)}.detach();
+        if (_queue) {
+            /* Blocks while all workers are busy and the queue is full */
+            _queue->push(std::move(socket));
+        } else {
+            std::thread{&TcpServer::serve, this, std::move(socket)}.detach();
+        }
     }
 }
 
@@ -46,12 +93,44 @@ TcpServer::listen(std::string_view port)
 }
 
 void
-TcpServer::handleSession(TcpServer* /*server*/, tcp::socket&& socket)
+TcpServer::work()
+{
+    while (auto socket = _queue->pop()) {
+        serve(std::move(*socket));
+    }
+}
+
+void
+TcpServer::serve(tcp::socket&& socket)
+{
+    try {
+        handleSession(this, std::move(socket));
+    } catch (const sys::system_error& e) {
+        /* A failed session mustn't take the process (or the worker) down */
+        std::cout << "Server: Session error (" << e.what() << ")\n";
+    }
+}
+
+std::filesystem::path
+TcpServer::nextUploadPath()
+{
+    return _uploads / ("upload-" + std::to_string(++_uploadsCount) + ".bin");
+}
+
+void
+TcpServer::handleSession(TcpServer* server, tcp::socket&& socket)
 {
     beast::tcp_stream stream{std::move(socket)};
 
     beast::flat_buffer buffer;
+    /* Otherwise the buffer stays at the initial read size and the body is read in pieces of 512
+       bytes */
+    buffer.reserve(kReadBufferSize);
     http::request_parser<http::empty_body> reqPar;
+    if (!server->_uploads.empty()) {
+        /* Stored upload doesn't occupy memory, so its size isn't limited */
+        reqPar.body_limit(boost::none);
+    }
     std::cout << "Server: Read initial request\n";
     http::read_header(stream, buffer, reqPar);
 
@@ -67,14 +146,37 @@ TcpServer::handleSession(TcpServer* /*server*/, tcp::socket&& socket)
         return;
     }
 
+    std::optional<FileSink> sink;
+    if (!server->_uploads.empty()) {
+        sink.emplace(server->nextUploadPath(), server->_sinkOptions);
+    }
+
+    /* The upload is verified as it arrives, so it's never read back */
+    Crc32c checksum;
     std::string chunks;
     auto onHeader = [&](std::uint64_t size, std::string_view extensions, sys::error_code& error) {
-        std::cout << "Server: Header chunk (" << size << " size)\n";
-        chunks.reserve(chunks.size() + size);
+        if (server->_verbose) {
+            std::cout << "Server: Header chunk (" << size << " size)\n";
+        }
+        if (!sink) {
+            chunks.reserve(chunks.size() + size);
+        }
     };
     auto onBody = [&](std::uint64_t remain, std::string_view body, sys::error_code& error) {
-        std::cout << "Server: Body chunk (" << body.size() << " size)\n";
-        chunks.append(body.data(), body.size());
+        if (server->_verbose) {
+            std::cout << "Server: Body chunk (" << body.size() << " size)\n";
+        }
+        checksum.update(body);
+        if (!sink) {
+            chunks.append(body.data(), body.size());
+            return body.size();
+        }
+        try {
+            sink->write(body);
+        } catch (const sys::system_error& e) {
+            error = e.code();
+            return std::size_t{0};
+        }
         return body.size();
     };
     reqPar.on_chunk_header(onHeader);
@@ -82,7 +184,9 @@ TcpServer::handleSession(TcpServer* /*server*/, tcp::socket&& socket)
 
     sys::error_code error;
     while (!reqPar.is_done()) {
-        std::cout << "Server: Read chunk\n";
+        if (server->_verbose) {
+            std::cout << "Server: Read chunk\n";
+        }
         http::read(stream.socket(), buffer, reqPar, error);
         if (error) {
             if (error == http::error::end_of_chunk) {
@@ -96,8 +200,22 @@ TcpServer::handleSession(TcpServer* /*server*/, tcp::socket&& socket)
         }
     }
 
-    std::cout << "Ready to work with chunks\n";
-    std::cout << "> " << chunks << std::endl;
+    if (const auto expected = reqPar.get()[kChecksumField]; !error && !expected.empty()) {
+        if (Crc32c::fromString(expected) == checksum.value()) {
+            std::cout << "Server: Checksum verified (" << expected << ")\n";
+        } else {
+            std::cout << "Server: Checksum mismatch (" << expected << " expected, "
+                      << Crc32c::toString(checksum.value()) << " computed)\n";
+        }
+    }
+
+    if (sink) {
+        sink->close();
+        std::cout << "Server: Stored upload (" << sink->size() << " size)\n";
+    } else if (server->_verbose) {
+        std::cout << "Ready to work with chunks\n";
+        std::cout << "> " << chunks << std::endl;
+    }
 
     std::cout << "Server: Close\n";
     stream.close();
@@ -0,0 +1,225 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TcpClient.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Upload throughput of chunked client by payload size
+ *
+ * Payloads from 1 KiB up to the maximum size (by 16 times) are uploaded in chunks of the fixed
+ * step (up to 1 MiB payloads only, it's slow), in adaptive chunks, and from a file by sendfile
+ * in adaptive chunks. Uploads of a size repeat until 256 MiB is sent (at most 1000 times). The
+ * server runs in a child process and discards the body. The client CPU time per MiB is
+ * reported too (the server isn't counted).
+ */
+
+namespace {
+
+constexpr std::size_t kMiB{1024 * 1024};
+constexpr std::size_t kFixedStepMaxSize{kMiB};
+
+struct BenchOptions {
+    net::ip::port_type port{3350};
+    std::string path{"upload-bench.bin"};
+    std::size_t maxSize{1024 * kMiB};
+    std::size_t step{5};
+};
+
+struct Result {
+    double mibPerSecond{0};
+    double cpuMicrosPerMiB{0};
+};
+
+/* Answers 100-continue and reads bodies until clients close connections */
+[[noreturn]] void
+runServer(const BenchOptions& options)
+{
+    net::io_context context;
+    tcp::acceptor acceptor{context, {net::ip::address_v4::loopback(), options.port}};
+    std::string header;
+    std::vector<char> body(256 * 1024);
+    for (;;) {
+        tcp::socket socket{context};
+        acceptor.accept(socket);
+        sys::error_code error;
+        header.clear();
+        net::read_until(socket, net::dynamic_buffer(header), "\r\n\r\n", error);
+        if (error) {
+            continue;
+        }
+        const std::string_view response{"HTTP/1.1 100 Continue\r\n\r\n"};
+        net::write(socket, net::buffer(response), error);
+        while (!error) {
+            socket.read_some(net::buffer(body), error);
+        }
+    }
+}
+
+double
+cpuMicros()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 + usage.ru_utime.tv_usec
+           + usage.ru_stime.tv_usec;
+}
+
+template<typename Upload>
+Result
+measure(std::size_t size, Upload&& upload)
+{
+    const std::size_t repeats = std::clamp<std::size_t>(256 * kMiB / size, 1, 1000);
+    const double cpuStart = cpuMicros();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t n{0}; n < repeats; ++n) {
+        upload();
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const double mib = static_cast<double>(size) * repeats / kMiB;
+    return {mib / elapsed.count(), (cpuMicros() - cpuStart) / mib};
+}
+
+void
+printResult(const std::optional<Result>& result)
+{
+    if (result) {
+        std::printf(" %10.1f %10.0f", result->mibPerSecond, result->cpuMicrosPerMiB);
+    } else {
+        std::printf(" %10s %10s", "-", "-");
+    }
+}
+
+std::string
+sizeName(std::size_t size)
+{
+    if (size >= kMiB) {
+        return std::to_string(size / kMiB) + " MiB";
+    }
+    return std::to_string(size / 1024) + " KiB";
+}
+
+void
+runBenchmark(const BenchOptions& options)
+{
+    /* Buffered output mustn't be inherited by the server */
+    std::fflush(stdout);
+    const pid_t server = ::fork();
+    if (server == 0) {
+        runServer(options);
+    }
+
+    const std::string port = std::to_string(options.port);
+    for (bool ready{false}; !ready;) {
+        net::io_context context;
+        tcp::socket socket{context};
+        sys::error_code error;
+        socket.connect({net::ip::address_v4::loopback(), options.port}, error);
+        ready = !error;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    /* The client logs every chunk */
+    std::cout.rdbuf(nullptr);
+
+    net::io_context context;
+    TcpClient client{context};
+    for (std::size_t size{1024}; size <= options.maxSize; size *= 16) {
+        const std::string payload(size, 'x');
+        std::ofstream{options.path, std::ios::binary | std::ios::trunc} << payload;
+
+        std::optional<Result> fixed;
+        if (size <= kFixedStepMaxSize) {
+            fixed = measure(size, [&]() {
+                client.send("127.0.0.1", port, payload, options.step);
+            });
+        }
+        const auto adaptive = measure(size, [&]() { client.send("127.0.0.1", port, payload); });
+        const auto sendfile
+            = measure(size, [&]() { client.sendFile("127.0.0.1", port, options.path); });
+
+        std::printf("%8s", sizeName(size).c_str());
+        printResult(fixed);
+        printResult(adaptive);
+        printResult(sendfile);
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    std::filesystem::remove(options.path);
+
+    ::kill(server, SIGKILL);
+    ::waitpid(server, nullptr, 0);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t maxSize{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<net::ip::port_type>(&options.port)->default_value(3350), "Set port")
+        ("path", po::value<std::string>(&options.path)->default_value("upload-bench.bin"), "Set file to upload by sendfile")
+        ("max,m", po::value<std::size_t>(&maxSize)->default_value(1024), "Set maximum payload size (MiB)")
+        ("step", po::value<std::size_t>(&options.step)->default_value(5), "Set fixed chunk size")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (maxSize == 0 || options.step == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.maxSize = maxSize * kMiB;
+
+    std::printf("%8s %21s %21s %21s\n", "", "fixed step", "adaptive", "sendfile");
+    std::printf("%8s", "payload");
+    for (int n{0}; n < 3; ++n) {
+        std::printf(" %10s %10s", "MiB/s", "cpu us/MiB");
+    }
+    std::printf("\n");
+    runBenchmark(options);
+    return EXIT_SUCCESS;
+}
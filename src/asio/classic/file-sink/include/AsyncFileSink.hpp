@@ -0,0 +1,318 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "BufferPool.hpp"
+#include "FileSink.hpp"
+
+#include <boost/asio.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+/**
+ * Writes an upload to a file as chunks arrive, keeping several writes in flight
+ *
+ * With asio file support (io_uring backend) up to the window of writes are in flight at once,
+ * each owning its data: a chunk buffer (returned to the pool when written) or an aligned block
+ * of direct writes (reused). Without file support writes are run on the blocking executor if
+ * given (keeping the window in flight the same way), otherwise they complete before returning
+ * and block the thread of the sink. The sink
+ * must be used from one strand (or thread) and closed before destruction. A failed write is
+ * thrown as boost::system::system_error by close() (further writes are skipped), so writes in
+ * flight are always waited for. Defined in header, so asio backend is the one of the including
+ * program.
+ */
+class AsyncFileSink {
+public:
+    using Options = FileSink::Options;
+
+    AsyncFileSink(asio::any_io_executor executor,
+                  const std::filesystem::path& path,
+                  Options options);
+
+    /* Runs writes on the blocking executor (a thread pool) unless asio has file support */
+    AsyncFileSink(asio::any_io_executor executor,
+                  asio::any_io_executor blocking,
+                  const std::filesystem::path& path,
+                  Options options);
+
+    AsyncFileSink(const AsyncFileSink&) = delete;
+
+    AsyncFileSink&
+    operator=(const AsyncFileSink&) = delete;
+
+    ~AsyncFileSink();
+
+    /* Writes chunk, waits while the window of writes in flight is full */
+    asio::awaitable<void>
+    write(BufferPool::Buffer chunk);
+
+    /* Writes staged data, waits for writes in flight, truncates the file to the written size
+       and closes it */
+    asio::awaitable<void>
+    close();
+
+    /* Returns the number of bytes written */
+    [[nodiscard]] std::uint64_t
+    size() const noexcept;
+
+    [[nodiscard]] bool
+    direct() const noexcept;
+
+private:
+    /* Data of a write in flight */
+    struct Pending {
+        BufferPool::Buffer chunk;
+        FileSink::Block block;
+    };
+
+    asio::awaitable<void>
+    submit(Pending pending, const char* data, std::size_t size);
+
+    void
+    complete(boost::system::error_code errorCode, Pending pending);
+
+    /* Waits until a write in flight completes */
+    asio::awaitable<void>
+    waitWrite();
+
+    void
+    throwIfFailed() const;
+
+private:
+#if defined(BOOST_ASIO_HAS_FILE)
+    asio::random_access_file _file;
+#else
+    int _fd{-1};
+    std::optional<asio::any_io_executor> _blocking;
+#endif
+    Options _options;
+    /* Never expires, cancelled when a write completes */
+    asio::steady_timer _written;
+    std::size_t _inFlight{0};
+    boost::system::error_code _error;
+    FileSink::Block _block;
+    std::size_t _staged{0};
+    std::vector<FileSink::Block> _freeBlocks;
+    /* The offset of the next write (staged data isn't written yet) */
+    std::uint64_t _offset{0};
+    std::uint64_t _size{0};
+};
+
+//
+// Inlines
+//
+
+inline AsyncFileSink::AsyncFileSink(asio::any_io_executor executor,
+                                    const std::filesystem::path& path,
+                                    Options options)
+#if defined(BOOST_ASIO_HAS_FILE)
+    : _file{executor}
+    , _options{options}
+#else
+    : _options{options}
+#endif
+    , _written{executor}
+{
+    assert(_options.window > 0);
+    assert(_options.blockSize > 0 && _options.blockSize % FileSink::kAlignment == 0);
+    const int fd = FileSink::open(path, _options.direct);
+#if defined(BOOST_ASIO_HAS_FILE)
+    _file.assign(fd);
+#else
+    _fd = fd;
+#endif
+}
+
+inline AsyncFileSink::AsyncFileSink(asio::any_io_executor executor,
+                                    [[maybe_unused]] asio::any_io_executor blocking,
+                                    const std::filesystem::path& path,
+                                    Options options)
+    : AsyncFileSink{std::move(executor), path, options}
+{
+#if !defined(BOOST_ASIO_HAS_FILE)
+    _blocking = std::move(blocking);
+#endif
+}
+
+inline AsyncFileSink::~AsyncFileSink()
+{
+    assert(_inFlight == 0);
+#if !defined(BOOST_ASIO_HAS_FILE)
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+}
+
+inline asio::awaitable<void>
+AsyncFileSink::write(BufferPool::Buffer chunk)
+{
+    _size += chunk.size();
+    if (chunk.size() == 0) {
+        co_return;
+    }
+    if (!_options.direct) {
+        /* The chunk is written as is, data stays valid as the buffer moves */
+        const char* data = chunk.data();
+        const std::size_t size = chunk.size();
+        Pending pending{std::move(chunk), {}};
+        co_await submit(std::move(pending), data, size);
+        co_return;
+    }
+
+    std::string_view data = chunk.view();
+    while (!data.empty()) {
+        if (!_block) {
+            if (_freeBlocks.empty()) {
+                _block = FileSink::allocateBlock(_options.blockSize);
+            } else {
+                _block = std::move(_freeBlocks.back());
+                _freeBlocks.pop_back();
+            }
+        }
+        const std::size_t size = std::min(data.size(), _options.blockSize - _staged);
+        std::memcpy(_block.get() + _staged, data.data(), size);
+        _staged += size;
+        data.remove_prefix(size);
+        if (_staged == _options.blockSize) {
+            const char* block = _block.get();
+            Pending pending{{}, std::move(_block)};
+            co_await submit(std::move(pending), block, std::exchange(_staged, 0));
+        }
+    }
+}
+
+inline asio::awaitable<void>
+AsyncFileSink::close()
+{
+    if (_staged > 0) {
+        const char* block = _block.get();
+        const std::size_t size = FileSink::pad(_block.get(), std::exchange(_staged, 0));
+        Pending pending{{}, std::move(_block)};
+        co_await submit(std::move(pending), block, size);
+    }
+    while (_inFlight > 0) {
+        co_await waitWrite();
+    }
+    throwIfFailed();
+
+#if defined(BOOST_ASIO_HAS_FILE)
+    if (_options.direct) {
+        _file.resize(_size);
+    }
+    _file.close();
+#else
+    if (_options.direct && ::ftruncate(_fd, static_cast<off_t>(_size)) != 0) {
+        throw boost::system::system_error{
+            boost::system::error_code{errno, boost::system::system_category()}, "ftruncate"};
+    }
+    ::close(std::exchange(_fd, -1));
+#endif
+}
+
+inline std::uint64_t
+AsyncFileSink::size() const noexcept
+{
+    return _size;
+}
+
+inline bool
+AsyncFileSink::direct() const noexcept
+{
+    return _options.direct;
+}
+
+inline asio::awaitable<void>
+AsyncFileSink::submit(Pending pending, const char* data, std::size_t size)
+{
+    while (_inFlight == _options.window) {
+        co_await waitWrite();
+    }
+    if (_error) {
+        co_return;
+    }
+
+    const std::uint64_t offset = _offset;
+    _offset += size;
+    ++_inFlight;
+#if defined(BOOST_ASIO_HAS_FILE)
+    asio::async_write_at(
+        _file,
+        offset,
+        asio::buffer(data, size),
+        [this, pending = std::move(pending)](boost::system::error_code errorCode,
+                                             std::size_t /*bytes*/) mutable {
+            complete(errorCode, std::move(pending));
+        });
+#else
+    auto write = [fd = _fd, data, size, offset]() {
+        boost::system::error_code errorCode;
+        try {
+            FileSink::writeAt(fd, data, size, offset);
+        } catch (const boost::system::system_error& e) {
+            errorCode = e.code();
+        }
+        return errorCode;
+    };
+    if (!_blocking) {
+        complete(write(), std::move(pending));
+        co_return;
+    }
+    /* Completes on the executor of the sink, as file writes do */
+    asio::post(*_blocking,
+               [this, write, pending = std::move(pending)]() mutable {
+                   asio::post(_written.get_executor(),
+                              [this, errorCode = write(), pending = std::move(pending)]() mutable {
+                                  complete(errorCode, std::move(pending));
+                              });
+               });
+#endif
+}
+
+inline void
+AsyncFileSink::complete(boost::system::error_code errorCode, Pending pending)
+{
+    --_inFlight;
+    if (errorCode && !_error) {
+        _error = errorCode;
+    }
+    if (pending.block) {
+        _freeBlocks.push_back(std::move(pending.block));
+    }
+    _written.cancel();
+}
+
+inline asio::awaitable<void>
+AsyncFileSink::waitWrite()
+{
+    boost::system::error_code errorCode;
+    _written.expires_at(asio::steady_timer::time_point::max());
+    co_await _written.async_wait(asio::redirect_error(asio::use_awaitable, errorCode));
+}
+
+inline void
+AsyncFileSink::throwIfFailed() const
+{
+    if (_error) {
+        throw boost::system::system_error{_error, "write"};
+    }
+}
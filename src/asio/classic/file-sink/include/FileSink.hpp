@@ -0,0 +1,126 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+/**
+ * Writes an upload to a file as it arrives
+ *
+ * Data is either appended as is (through the page cache) or, with direct I/O, staged into
+ * aligned blocks written with O_DIRECT. The last block of direct writes is padded and the file
+ * is truncated to the written size on close. Memory use doesn't depend on the upload size.
+ * Failures are thrown as boost::system::system_error.
+ */
+class FileSink {
+public:
+    /* Alignment of buffers, offsets and sizes of direct writes */
+    static constexpr std::size_t kAlignment{4096};
+
+    struct Options {
+        /* Write with O_DIRECT (buffered if the file system doesn't support it) */
+        bool direct{false};
+        /* The size of staging blocks of direct writes (multiple of kAlignment) */
+        std::size_t blockSize{1024 * 1024};
+        /* The maximum number of writes in flight (AsyncFileSink) */
+        std::size_t window{4};
+    };
+
+    struct BlockDeleter {
+        void
+        operator()(char* data) const noexcept
+        {
+            std::free(data);
+        }
+    };
+
+    /* Staging block aligned for direct writes */
+    using Block = std::unique_ptr<char, BlockDeleter>;
+
+    explicit FileSink(const std::filesystem::path& path);
+
+    FileSink(const std::filesystem::path& path, Options options);
+
+    FileSink(const FileSink&) = delete;
+
+    FileSink&
+    operator=(const FileSink&) = delete;
+
+    /* Closes the file (without throwing) unless closed already */
+    ~FileSink();
+
+    void
+    write(std::string_view data);
+
+    /* Writes staged data, truncates the file to the written size and closes it */
+    void
+    close();
+
+    /* Returns the number of bytes written */
+    [[nodiscard]] std::uint64_t
+    size() const noexcept;
+
+    /* Returns true if writes bypass the page cache */
+    [[nodiscard]] bool
+    direct() const noexcept;
+
+    /* Creates (truncates) file for writing, direct is reset if O_DIRECT isn't supported */
+    [[nodiscard]] static int
+    open(const std::filesystem::path& path, bool& direct);
+
+    [[nodiscard]] static Block
+    allocateBlock(std::size_t size);
+
+    /* Writes all data at the offset */
+    static void
+    writeAt(int fd, const char* data, std::size_t size, std::uint64_t offset);
+
+    /* Returns size of staged data padded for a direct write (the padding is zeroed) */
+    [[nodiscard]] static std::size_t
+    pad(char* block, std::size_t staged) noexcept;
+
+private:
+    void
+    flush();
+
+private:
+    int _fd{-1};
+    Options _options;
+    Block _block;
+    std::size_t _staged{0};
+    /* The offset of the next write (staged data isn't written yet) */
+    std::uint64_t _offset{0};
+    std::uint64_t _size{0};
+};
+
+//
+// Inlines
+//
+
+inline std::uint64_t
+FileSink::size() const noexcept
+{
+    return _size;
+}
+
+inline bool
+FileSink::direct() const noexcept
+{
+    return _options.direct;
+}
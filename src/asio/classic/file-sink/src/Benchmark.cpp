@@ -0,0 +1,172 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncFileSink.hpp"
+#include "FileSink.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+
+/**
+ * Sustained throughput and peak memory of writing multi-GB uploads to a file
+ *
+ * Chunks are copied into pooled buffers (as the chunked-delivery servers receive them) and
+ * written by the synchronous or asynchronous sink, buffered or direct. Every mode runs in a
+ * child process, so its peak resident size is its own. The time includes flushing the file to
+ * the disk. Asynchronous writes are in flight at once only with the io_uring backend
+ * (asio-file-sink-bench-io-uring), otherwise they complete one by one.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::filesystem::path path{"file-sink-bench.bin"};
+    std::uint64_t size{2ULL * 1024 * 1024 * 1024};
+    std::size_t chunkSize{64 * 1024};
+    std::size_t blockSize{1024 * 1024};
+    std::size_t window{4};
+};
+
+struct Mode {
+    const char* name;
+    bool async;
+    bool direct;
+};
+
+constexpr Mode kModes[] = {
+    {"sync", false, false},
+    {"sync", false, true},
+    {"async", true, false},
+    {"async", true, true},
+};
+
+/* Returns true if writes were direct */
+bool
+runSink(const BenchOptions& options, const Mode& mode)
+{
+    const FileSink::Options sinkOptions{
+        .direct = mode.direct, .blockSize = options.blockSize, .window = options.window};
+    auto pool = BufferPool::create(options.chunkSize);
+    const std::string source(options.chunkSize, 'x');
+    if (!mode.async) {
+        FileSink sink{options.path, sinkOptions};
+        for (std::uint64_t offset{0}; offset < options.size; offset += options.chunkSize) {
+            auto chunk = pool->acquire(
+                std::min<std::uint64_t>(options.chunkSize, options.size - offset));
+            std::memcpy(chunk.data(), source.data(), chunk.size());
+            sink.write(chunk.view());
+        }
+        sink.close();
+        return sink.direct();
+    }
+
+    bool direct{false};
+    asio::io_context context;
+    asio::co_spawn(
+        context,
+        [&]() -> asio::awaitable<void> {
+            AsyncFileSink sink{co_await asio::this_coro::executor, options.path, sinkOptions};
+            for (std::uint64_t offset{0}; offset < options.size; offset += options.chunkSize) {
+                auto chunk = pool->acquire(
+                    std::min<std::uint64_t>(options.chunkSize, options.size - offset));
+                std::memcpy(chunk.data(), source.data(), chunk.size());
+                co_await sink.write(std::move(chunk));
+            }
+            co_await sink.close();
+            direct = sink.direct();
+        },
+        asio::detached);
+    context.run();
+    return direct;
+}
+
+void
+runBenchmark(const BenchOptions& options, const Mode& mode)
+{
+    std::fflush(stdout);
+    if (const pid_t child = ::fork(); child != 0) {
+        ::waitpid(child, nullptr, 0);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool direct = runSink(options, mode);
+    ::sync();
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    std::printf("%8s %8s %12.1f %14.1f\n",
+                mode.name,
+                direct ? "direct" : "buffered",
+                double(options.size) / (1024 * 1024) / elapsed.count(),
+                double(usage.ru_maxrss) / 1024);
+    std::filesystem::remove(options.path);
+    std::fflush(stdout);
+    ::_exit(EXIT_SUCCESS);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::string path;
+    std::uint64_t sizeMiB{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("path,p", po::value<std::string>(&path)->default_value("file-sink-bench.bin"), "Set file to write")
+        ("size,s", po::value<std::uint64_t>(&sizeMiB)->default_value(2048), "Set upload size (MiB)")
+        ("chunk,c", po::value<std::size_t>(&options.chunkSize)->default_value(64 * 1024), "Set chunk size")
+        ("block,b", po::value<std::size_t>(&options.blockSize)->default_value(1024 * 1024), "Set block size of direct writes")
+        ("window,w", po::value<std::size_t>(&options.window)->default_value(4), "Set number of writes in flight")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (sizeMiB == 0 || options.chunkSize == 0 || options.window == 0
+        || options.blockSize % FileSink::kAlignment != 0 || options.blockSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.path = path;
+    options.size = sizeMiB * 1024 * 1024;
+
+    std::printf("%8s %8s %12s %14s\n", "sink", "writes", "MiB/s", "peak RSS MiB");
+    for (const Mode& mode : kModes) {
+        runBenchmark(options, mode);
+    }
+    return EXIT_SUCCESS;
+}
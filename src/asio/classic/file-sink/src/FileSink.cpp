@@ -0,0 +1,161 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FileSink.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace sys = boost::system;
+
+namespace {
+
+[[noreturn]] void
+throwErrno(const char* what)
+{
+    throw sys::system_error{sys::error_code{errno, sys::system_category()}, what};
+}
+
+} // namespace
+
+FileSink::FileSink(const std::filesystem::path& path)
+    : FileSink{path, Options{}}
+{
+}
+
+FileSink::FileSink(const std::filesystem::path& path, Options options)
+    : _options{options}
+{
+    assert(_options.blockSize > 0 && _options.blockSize % kAlignment == 0);
+    _fd = open(path, _options.direct);
+    if (_options.direct) {
+        _block = allocateBlock(_options.blockSize);
+    }
+}
+
+FileSink::~FileSink()
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+}
+
+void
+FileSink::write(std::string_view data)
+{
+    assert(_fd >= 0);
+    _size += data.size();
+    if (!_options.direct) {
+        writeAt(_fd, data.data(), data.size(), _offset);
+        _offset += data.size();
+        return;
+    }
+
+    while (!data.empty()) {
+        const std::size_t size = std::min(data.size(), _options.blockSize - _staged);
+        std::memcpy(_block.get() + _staged, data.data(), size);
+        _staged += size;
+        data.remove_prefix(size);
+        if (_staged == _options.blockSize) {
+            flush();
+        }
+    }
+}
+
+void
+FileSink::close()
+{
+    assert(_fd >= 0);
+    if (_staged > 0) {
+        _staged = pad(_block.get(), _staged);
+        flush();
+    }
+    if (_options.direct && ::ftruncate(_fd, static_cast<off_t>(_size)) != 0) {
+        throwErrno("ftruncate");
+    }
+    ::close(std::exchange(_fd, -1));
+}
+
+void
+FileSink::flush()
+{
+    writeAt(_fd, _block.get(), _staged, _offset);
+    _offset += _staged;
+    _staged = 0;
+}
+
+int
+FileSink::open(const std::filesystem::path& path, bool& direct)
+{
+    constexpr int kFlags{O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC};
+    if (direct) {
+        if (const int fd = ::open(path.c_str(), kFlags | O_DIRECT, 0644); fd >= 0) {
+            return fd;
+        }
+        /* E.g. tmpfs doesn't support direct I/O */
+        if (errno != EINVAL) {
+            throwErrno("open");
+        }
+        direct = false;
+    }
+    const int fd = ::open(path.c_str(), kFlags, 0644);
+    if (fd < 0) {
+        throwErrno("open");
+    }
+    return fd;
+}
+
+FileSink::Block
+FileSink::allocateBlock(std::size_t size)
+{
+    Block block{static_cast<char*>(std::aligned_alloc(kAlignment, size))};
+    if (!block) {
+        throw std::bad_alloc{};
+    }
+    return block;
+}
+
+void
+FileSink::writeAt(int fd, const char* data, std::size_t size, std::uint64_t offset)
+{
+    while (size > 0) {
+        const ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("pwrite");
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += static_cast<std::uint64_t>(written);
+    }
+}
+
+std::size_t
+FileSink::pad(char* block, std::size_t staged) noexcept
+{
+    const std::size_t padded = (staged + kAlignment - 1) / kAlignment * kAlignment;
+    std::memset(block + staged, 0, padded - staged);
+    return padded;
+}
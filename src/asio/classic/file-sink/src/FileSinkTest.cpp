@@ -0,0 +1,165 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "AsyncFileSink.hpp"
+#include "FileSink.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+std::string
+pattern(std::size_t size)
+{
+    std::string data(size, '\0');
+    for (std::size_t n{0}; n < size; ++n) {
+        data[n] = static_cast<char>('a' + n % 26);
+    }
+    return data;
+}
+
+std::string
+readFile(const std::filesystem::path& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+} // namespace
+
+class FileSinkTest : public Test {
+public:
+    FileSinkTest()
+        : path{std::filesystem::current_path()
+               / ("file-sink-test-" + std::to_string(::getpid()) + ".bin")}
+    {
+    }
+
+    ~FileSinkTest() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    /* Writes data in parts of the given sizes (repeated) asynchronously (on the blocking pool
+       if given) */
+    void
+    writeAsync(std::string_view data,
+               std::vector<std::size_t> parts,
+               FileSink::Options options,
+               asio::thread_pool* blocking = nullptr)
+    {
+        asio::io_context context;
+        auto pool = BufferPool::create(65536);
+        asio::co_spawn(
+            context,
+            [&]() -> asio::awaitable<void> {
+                auto executor = co_await asio::this_coro::executor;
+                std::optional<AsyncFileSink> sink;
+                if (blocking) {
+                    sink.emplace(executor, blocking->get_executor(), path, options);
+                } else {
+                    sink.emplace(executor, path, options);
+                }
+                std::string_view rest = data;
+                for (std::size_t n{0}; !rest.empty(); ++n) {
+                    const std::size_t size = std::min(rest.size(), parts[n % parts.size()]);
+                    auto chunk = pool->acquire(size);
+                    std::memcpy(chunk.data(), rest.data(), size);
+                    rest.remove_prefix(size);
+                    co_await sink->write(std::move(chunk));
+                }
+                co_await sink->close();
+                EXPECT_EQ(sink->size(), data.size());
+            },
+            asio::detached);
+        context.run();
+    }
+
+protected:
+    std::filesystem::path path;
+};
+
+TEST_F(FileSinkTest, WritesBuffered)
+{
+    const auto data = pattern(100000);
+    FileSink sink{path};
+    sink.write(std::string_view{data}.substr(0, 10));
+    sink.write(std::string_view{data}.substr(10));
+    sink.close();
+
+    EXPECT_EQ(sink.size(), data.size());
+    EXPECT_EQ(readFile(path), data);
+}
+
+TEST_F(FileSinkTest, WritesDirect)
+{
+    /* Blocks are written whole, the padded tail is truncated (or writes are buffered if the
+       file system doesn't support direct I/O) */
+    const auto data = pattern(3 * FileSink::kAlignment + 100);
+    FileSink sink{path, FileSink::Options{.direct = true, .blockSize = 2 * FileSink::kAlignment}};
+    sink.write(std::string_view{data}.substr(0, 5000));
+    sink.write(std::string_view{data}.substr(5000));
+    sink.close();
+
+    EXPECT_EQ(readFile(path), data);
+    EXPECT_EQ(std::filesystem::file_size(path), data.size());
+}
+
+TEST_F(FileSinkTest, WritesAsyncBuffered)
+{
+    const auto data = pattern(300000);
+    writeAsync(data, {1, 65536, 1000}, FileSink::Options{.window = 2});
+
+    EXPECT_EQ(readFile(path), data);
+}
+
+TEST_F(FileSinkTest, WritesAsyncDirect)
+{
+    const auto data = pattern(10 * FileSink::kAlignment + 1);
+    writeAsync(data,
+               {100, 7000},
+               FileSink::Options{.direct = true, .blockSize = FileSink::kAlignment, .window = 3});
+
+    EXPECT_EQ(readFile(path), data);
+    EXPECT_EQ(std::filesystem::file_size(path), data.size());
+}
+
+TEST_F(FileSinkTest, WritesAsyncOnBlockingPool)
+{
+    asio::thread_pool blocking{2};
+    const auto data = pattern(10 * FileSink::kAlignment + 1);
+    writeAsync(data, {100, 7000}, FileSink::Options{.window = 3}, &blocking);
+    writeAsync(data,
+               {100, 7000},
+               FileSink::Options{.direct = true, .blockSize = FileSink::kAlignment, .window = 3},
+               &blocking);
+
+    EXPECT_EQ(readFile(path), data);
+    EXPECT_EQ(std::filesystem::file_size(path), data.size());
+}
+
+TEST_F(FileSinkTest, ThrowsIfFileCantBeCreated)
+{
+    EXPECT_THROW(FileSink{path / "missing" / "upload.bin"}, boost::system::system_error);
+}
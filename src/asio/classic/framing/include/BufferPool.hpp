@@ -0,0 +1,138 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace asio = boost::asio;
+
+/**
+ * Pool of receive buffers grouped into power-of-two size classes
+ *
+ * A buffer of the smallest class fitting the requested size is handed out and returns to
+ * the pool when released, so receiving frames of similar sizes doesn't allocate in steady
+ * state. The pool is shared by sessions (guarded by mutex) and must be created with
+ * BufferPool::create(), buffers keep it alive.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool> {
+public:
+    static constexpr std::size_t kMinSize{256};
+
+    class Buffer {
+    public:
+        Buffer() = default;
+
+        Buffer(Buffer&& other) noexcept;
+
+        Buffer&
+        operator=(Buffer&& other) noexcept;
+
+        ~Buffer();
+
+        [[nodiscard]] char*
+        data() const noexcept;
+
+        /* Returns requested size (not capacity of the buffer) */
+        [[nodiscard]] std::size_t
+        size() const noexcept;
+
+        [[nodiscard]] std::string_view
+        view() const noexcept;
+
+        [[nodiscard]] asio::mutable_buffer
+        buffer() const noexcept;
+
+    private:
+        friend class BufferPool;
+
+        void
+        release();
+
+        std::shared_ptr<BufferPool> _pool;
+        std::unique_ptr<char[]> _data;
+        std::size_t _size{0};
+        std::size_t _sizeClass{0};
+    };
+
+    /* Creates pool of buffers up to maxSize bytes keeping at most maxCached free buffers
+       of each class */
+    [[nodiscard]] static std::shared_ptr<BufferPool>
+    create(std::size_t maxSize, std::size_t maxCached = 64);
+
+    /* Returns buffer of given size (up to the maximum), empty buffer for zero size */
+    [[nodiscard]] Buffer
+    acquire(std::size_t size);
+
+    [[nodiscard]] std::size_t
+    maxSize() const noexcept;
+
+    /* Returns the number of free buffers in the pool */
+    [[nodiscard]] std::size_t
+    cached() const;
+
+private:
+    BufferPool(std::size_t maxSize, std::size_t maxCached);
+
+    [[nodiscard]] static std::size_t
+    sizeClass(std::size_t size) noexcept;
+
+    void
+    release(std::size_t sizeClass, std::unique_ptr<char[]> data);
+
+private:
+    std::size_t _maxSize;
+    std::size_t _maxCached;
+    mutable std::mutex _guard;
+    std::vector<std::vector<std::unique_ptr<char[]>>> _free;
+};
+
+//
+// Inlines
+//
+
+inline std::size_t
+BufferPool::maxSize() const noexcept
+{
+    return _maxSize;
+}
+
+inline char*
+BufferPool::Buffer::data() const noexcept
+{
+    return _data.get();
+}
+
+inline std::size_t
+BufferPool::Buffer::size() const noexcept
+{
+    return _size;
+}
+
+inline std::string_view
+BufferPool::Buffer::view() const noexcept
+{
+    return std::string_view{_data.get(), _size};
+}
+
+inline asio::mutable_buffer
+BufferPool::Buffer::buffer() const noexcept
+{
+    return asio::buffer(_data.get(), _size);
+}
@@ -0,0 +1,110 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace asio = boost::asio;
+namespace sys = boost::system;
+
+/* How messages are delimited on the wire */
+enum class Framing {
+    /* Text lines ending with '\n' */
+    Line,
+    /* Binary frames prefixed with header (see FrameCodec) */
+    Length
+};
+
+enum class FrameError {
+    BadMagic = 1,
+    BadVersion,
+    BadFlags,
+    TooLarge
+};
+
+[[nodiscard]] const sys::error_category&
+frameCategory() noexcept;
+
+[[nodiscard]] sys::error_code
+make_error_code(FrameError error) noexcept;
+
+namespace boost::system {
+
+template<>
+struct is_error_code_enum<FrameError> : std::true_type { };
+
+} // namespace boost::system
+
+/**
+ * Length-prefixed framing
+ *
+ * Each frame starts with 8-byte header (integers are big-endian):
+ *  magic   (2 bytes) - 0x4652 ("FR"), rejects peers speaking another protocol
+ *  version (1 byte)  - 1
+ *  flags   (1 byte)  - reserved, must be zero
+ *  length  (4 bytes) - the number of payload bytes following the header
+ *
+ * The length is validated against the maximum frame size before anything is allocated
+ * for the payload, so a peer can't make the receiver reserve arbitrary memory.
+ */
+class FrameCodec {
+public:
+    static constexpr std::size_t kHeaderSize{8};
+    static constexpr std::uint16_t kMagic{0x4652};
+    static constexpr std::uint8_t kVersion{1};
+
+    using Header = std::array<char, kHeaderSize>;
+
+    explicit FrameCodec(std::size_t maxFrame);
+
+    [[nodiscard]] std::size_t
+    maxFrame() const noexcept;
+
+    /* Encodes header of frame with given payload size (the maximum applies to received
+       frames only, the size must fit into 32 bits) */
+    [[nodiscard]] Header
+    encode(std::size_t length) const;
+
+    /* Decodes and validates header, returns payload size */
+    [[nodiscard]] sys::error_code
+    decode(const Header& header, std::size_t& length) const;
+
+    [[nodiscard]] static std::string_view
+    view(const Header& header) noexcept;
+
+private:
+    std::size_t _maxFrame;
+};
+
+//
+// Inlines
+//
+
+inline std::size_t
+FrameCodec::maxFrame() const noexcept
+{
+    return _maxFrame;
+}
+
+inline std::string_view
+FrameCodec::view(const Header& header) noexcept
+{
+    return std::string_view{header.data(), header.size()};
+}
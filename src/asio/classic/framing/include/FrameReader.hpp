@@ -0,0 +1,137 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "BufferPool.hpp"
+#include "FrameCodec.hpp"
+
+#include <boost/asio.hpp>
+
+#include <array>
+#include <memory>
+#include <utility>
+
+/**
+ * Reads length-prefixed frames from a stream
+ *
+ * The header is read into a fixed array and validated, then exactly the payload is read
+ * into a buffer taken from the pool. The payload read scatters into the header array as
+ * well, so the header of the next frame usually arrives with the payload of the current
+ * one (one read per frame). Nothing is read past the next header, so no data is buffered
+ * between frames. Only one read may be outstanding at a time.
+ */
+class FrameReader {
+public:
+    FrameReader(FrameCodec codec, std::shared_ptr<BufferPool> pool);
+
+    /* Reads next frame and calls handler(sys::error_code, BufferPool::Buffer payload) on the
+       executor associated with the handler */
+    template<typename Stream, typename Handler>
+    void
+    read(Stream& stream, Handler&& handler);
+
+    [[nodiscard]] const FrameCodec&
+    codec() const noexcept;
+
+private:
+    template<typename Stream, typename Handler>
+    void
+    readPayload(Stream& stream, Handler&& handler);
+
+private:
+    FrameCodec _codec;
+    std::shared_ptr<BufferPool> _pool;
+    FrameCodec::Header _header{};
+    /* The number of header bytes received so far */
+    std::size_t _headerBytes{0};
+};
+
+//
+// Inlines
+//
+
+inline FrameReader::FrameReader(FrameCodec codec, std::shared_ptr<BufferPool> pool)
+    : _codec{codec}
+    , _pool{std::move(pool)}
+{
+}
+
+inline const FrameCodec&
+FrameReader::codec() const noexcept
+{
+    return _codec;
+}
+
+template<typename Stream, typename Handler>
+void
+FrameReader::read(Stream& stream, Handler&& handler)
+{
+    if (_headerBytes == _header.size()) {
+        readPayload(stream, std::forward<Handler>(handler));
+        return;
+    }
+
+    const auto executor = asio::get_associated_executor(handler, stream.get_executor());
+    asio::async_read(
+        stream,
+        asio::buffer(_header) + _headerBytes,
+        asio::bind_executor(executor,
+                            [this, &stream, handler = std::forward<Handler>(handler)](
+                                sys::error_code errorCode, std::size_t bytes) mutable {
+                                _headerBytes += bytes;
+                                if (errorCode) {
+                                    handler(errorCode, BufferPool::Buffer{});
+                                } else {
+                                    readPayload(stream, std::move(handler));
+                                }
+                            }));
+}
+
+template<typename Stream, typename Handler>
+void
+FrameReader::readPayload(Stream& stream, Handler&& handler)
+{
+    std::size_t length{0};
+    if (const auto errorCode = _codec.decode(_header, length)) {
+        /* The stream can't be resynchronized, leave the header to fail following reads */
+        asio::post(stream.get_executor(),
+                   asio::bind_executor(
+                       asio::get_associated_executor(handler, stream.get_executor()),
+                       [handler = std::forward<Handler>(handler), errorCode]() mutable {
+                           handler(errorCode, BufferPool::Buffer{});
+                       }));
+        return;
+    }
+    _headerBytes = 0;
+
+    auto payload = _pool->acquire(length);
+    const std::array<asio::mutable_buffer, 2> buffers{payload.buffer(), asio::buffer(_header)};
+    const auto executor = asio::get_associated_executor(handler, stream.get_executor());
+    asio::async_read(stream,
+                     buffers,
+                     asio::transfer_at_least(length),
+                     asio::bind_executor(executor,
+                                         [this,
+                                          handler = std::forward<Handler>(handler),
+                                          payload = std::move(payload)](
+                                             sys::error_code errorCode,
+                                             std::size_t bytes) mutable {
+                                             if (bytes >= payload.size()) {
+                                                 _headerBytes = bytes - payload.size();
+                                                 errorCode = {};
+                                             }
+                                             handler(errorCode, std::move(payload));
+                                         }));
+}
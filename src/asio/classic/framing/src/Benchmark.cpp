@@ -0,0 +1,211 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FrameReader.hpp"
+
+#include "common/HeapMemoryTracker.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace po = boost::program_options;
+using tcp = asio::ip::tcp;
+
+/**
+ * Loopback receive throughput of newline vs length-prefixed framing
+ *
+ * A writer thread streams pre-encoded messages over a TCP connection, the receiver splits
+ * them in the benchmark thread either by async_read_until('\n') into a streambuf (as
+ * TcpAsyncService does) or by FrameReader. CPU time of the receiving thread per message
+ * shows the cost of each framing.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9093};
+    std::size_t messages{1'000'000};
+    std::size_t messageSize{1024};
+    std::size_t batch{64};
+};
+
+std::chrono::duration<double>
+threadCpuTime()
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+/* Encodes batch of messages as they appear on the wire */
+std::string
+encodeBatch(const BenchOptions& options, Framing framing)
+{
+    std::string batch;
+    for (std::size_t n{0}; n < options.batch; ++n) {
+        if (framing == Framing::Line) {
+            batch.append(options.messageSize - 1, 'x');
+            batch.push_back('\n');
+        } else {
+            const FrameCodec codec{options.messageSize};
+            batch.append(FrameCodec::view(codec.encode(options.messageSize)));
+            batch.append(options.messageSize, 'x');
+        }
+    }
+    return batch;
+}
+
+class LineReceiver {
+public:
+    LineReceiver(tcp::socket& socket, std::size_t maxLine)
+        : _socket{socket}
+        , _buffer{maxLine}
+    {
+    }
+
+    void
+    read(std::size_t& received)
+    {
+        asio::async_read_until(_socket,
+                               _buffer,
+                               '\n',
+                               [this, &received](sys::error_code errorCode, std::size_t bytes) {
+                                   if (!errorCode) {
+                                       _buffer.consume(bytes);
+                                       ++received;
+                                       read(received);
+                                   }
+                               });
+    }
+
+private:
+    tcp::socket& _socket;
+    asio::streambuf _buffer;
+};
+
+class FrameReceiver {
+public:
+    FrameReceiver(tcp::socket& socket, std::size_t maxFrame)
+        : _socket{socket}
+        , _reader{FrameCodec{maxFrame}, BufferPool::create(maxFrame)}
+    {
+    }
+
+    void
+    read(std::size_t& received)
+    {
+        _reader.read(_socket,
+                     [this, &received](sys::error_code errorCode, BufferPool::Buffer /*payload*/) {
+                         if (!errorCode) {
+                             ++received;
+                             read(received);
+                         }
+                     });
+    }
+
+private:
+    tcp::socket& _socket;
+    FrameReader _reader;
+};
+
+void
+runBenchmark(const BenchOptions& options, Framing framing)
+{
+    asio::io_context context;
+    tcp::acceptor acceptor{context, tcp::endpoint{asio::ip::address_v4::loopback(), options.port}};
+    tcp::socket output{context};
+    output.connect(acceptor.local_endpoint());
+    tcp::socket input = acceptor.accept();
+
+    const std::string batch = encodeBatch(options, framing);
+    const std::size_t batches = options.messages / options.batch;
+    std::jthread writer{[&] {
+        for (std::size_t n{0}; n < batches; ++n) {
+            asio::write(output, asio::buffer(batch));
+        }
+        output.shutdown(tcp::socket::shutdown_send);
+    }};
+
+    LineReceiver lines{input, options.messageSize};
+    FrameReceiver frames{input, options.messageSize};
+
+    std::size_t received{0};
+    HeapMemoryTracker::reset();
+    const auto cpuStart = threadCpuTime();
+    const auto start = std::chrono::steady_clock::now();
+    if (framing == Framing::Line) {
+        lines.read(received);
+    } else {
+        frames.read(received);
+    }
+    context.run();
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const auto cpuTime = threadCpuTime() - cpuStart;
+    const std::size_t allocations = HeapMemoryTracker::allocNumber();
+
+    std::printf("%8s %12.0f %10.1f %12.0f %12.3f\n",
+                (framing == Framing::Line) ? "line" : "length",
+                received / elapsed.count(),
+                double(batches * batch.size()) / elapsed.count() / (1 << 20),
+                cpuTime.count() * 1e9 / received,
+                double(allocations) / received);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9093), "Set port")
+        ("messages,m", po::value<std::size_t>(&options.messages)->default_value(1'000'000), "Set number of messages per run")
+        ("size,s", po::value<std::size_t>(&options.messageSize)->default_value(1024), "Set message size")
+        ("batch,b", po::value<std::size_t>(&options.batch)->default_value(64), "Set number of messages per write")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.messageSize < 2 || options.batch == 0 || options.messages < options.batch) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%8s %12s %10s %12s %12s\n",
+                "framing",
+                "msgs/s",
+                "MiB/s",
+                "cpu ns/msg",
+                "allocs/msg");
+    runBenchmark(options, Framing::Line);
+    runBenchmark(options, Framing::Length);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BufferPool.hpp"
+
+#include <bit>
+#include <cassert>
+#include <utility>
+
+std::shared_ptr<BufferPool>
+BufferPool::create(std::size_t maxSize, std::size_t maxCached)
+{
+    return std::shared_ptr<BufferPool>{new BufferPool{maxSize, maxCached}};
+}
+
+BufferPool::BufferPool(std::size_t maxSize, std::size_t maxCached)
+    : _maxSize{maxSize}
+    , _maxCached{maxCached}
+    , _free(sizeClass(maxSize) + 1)
+{
+}
+
+BufferPool::Buffer
+BufferPool::acquire(std::size_t size)
+{
+    assert(size <= _maxSize);
+
+    Buffer buffer;
+    if (size == 0) {
+        return buffer;
+    }
+
+    buffer._sizeClass = sizeClass(size);
+    {
+        std::lock_guard lock{_guard};
+        auto& free = _free[buffer._sizeClass];
+        if (!free.empty()) {
+            buffer._data = std::move(free.back());
+            free.pop_back();
+        }
+    }
+    if (!buffer._data) {
+        buffer._data = std::make_unique_for_overwrite<char[]>(kMinSize << buffer._sizeClass);
+    }
+    buffer._pool = shared_from_this();
+    buffer._size = size;
+    return buffer;
+}
+
+std::size_t
+BufferPool::cached() const
+{
+    std::lock_guard lock{_guard};
+    std::size_t count{0};
+    for (const auto& free : _free) {
+        count += free.size();
+    }
+    return count;
+}
+
+std::size_t
+BufferPool::sizeClass(std::size_t size) noexcept
+{
+    /* Classes are kMinSize, 2 * kMinSize, 4 * kMinSize, ... */
+    return (size <= kMinSize) ? 0 : std::bit_width((size - 1) / kMinSize);
+}
+
+void
+BufferPool::release(std::size_t sizeClass, std::unique_ptr<char[]> data)
+{
+    std::lock_guard lock{_guard};
+    auto& free = _free[sizeClass];
+    if (free.size() < _maxCached) {
+        free.push_back(std::move(data));
+    }
+}
+
+BufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : _pool{std::move(other._pool)}
+    , _data{std::move(other._data)}
+    , _size{std::exchange(other._size, 0)}
+    , _sizeClass{other._sizeClass}
+{
+}
+
+BufferPool::Buffer&
+BufferPool::Buffer::operator=(Buffer&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        _pool = std::move(other._pool);
+        _data = std::move(other._data);
+        _size = std::exchange(other._size, 0);
+        _sizeClass = other._sizeClass;
+    }
+    return *this;
+}
+
+BufferPool::Buffer::~Buffer()
+{
+    release();
+}
+
+void
+BufferPool::Buffer::release()
+{
+    if (_pool) {
+        _pool->release(_sizeClass, std::move(_data));
+        _pool.reset();
+    }
+    _size = 0;
+}
@@ -0,0 +1,87 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "BufferPool.hpp"
+
+using namespace testing;
+
+TEST(BufferPoolTest, ReusesReleasedBuffer)
+{
+    auto pool = BufferPool::create(4096);
+    const char* data{nullptr};
+    {
+        auto buffer = pool->acquire(1000);
+        EXPECT_EQ(buffer.size(), 1000);
+        EXPECT_EQ(buffer.buffer().size(), 1000);
+        data = buffer.data();
+    }
+    EXPECT_EQ(pool->cached(), 1);
+
+    /* Sizes of the same class share buffers */
+    auto buffer = pool->acquire(600);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(buffer.size(), 600);
+    EXPECT_EQ(pool->cached(), 0);
+}
+
+TEST(BufferPoolTest, SeparatesSizeClasses)
+{
+    auto pool = BufferPool::create(4096);
+    const char* data{nullptr};
+    {
+        auto buffer = pool->acquire(BufferPool::kMinSize);
+        data = buffer.data();
+    }
+    auto buffer = pool->acquire(BufferPool::kMinSize + 1);
+    EXPECT_NE(buffer.data(), data);
+    EXPECT_EQ(pool->cached(), 1);
+
+    auto largest = pool->acquire(4096);
+    EXPECT_EQ(largest.size(), 4096);
+}
+
+TEST(BufferPoolTest, LimitsCachedBuffers)
+{
+    auto pool = BufferPool::create(4096, 2);
+    {
+        std::vector<BufferPool::Buffer> buffers;
+        for (int n = 0; n < 4; ++n) {
+            buffers.push_back(pool->acquire(100));
+        }
+    }
+    EXPECT_EQ(pool->cached(), 2);
+}
+
+TEST(BufferPoolTest, BufferOutlivesPool)
+{
+    auto pool = BufferPool::create(4096);
+    auto buffer = pool->acquire(100);
+    pool.reset();
+    EXPECT_EQ(buffer.size(), 100);
+
+    auto moved = std::move(buffer);
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(BufferPoolTest, EmptyBuffer)
+{
+    auto pool = BufferPool::create(4096);
+    auto buffer = pool->acquire(0);
+    EXPECT_EQ(buffer.data(), nullptr);
+    EXPECT_EQ(buffer.buffer().size(), 0);
+}
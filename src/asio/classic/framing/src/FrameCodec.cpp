@@ -0,0 +1,118 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FrameCodec.hpp"
+
+#include <cassert>
+#include <limits>
+#include <string>
+
+namespace {
+
+class FrameCategory final : public sys::error_category {
+public:
+    [[nodiscard]] const char*
+    name() const noexcept override
+    {
+        return "frame";
+    }
+
+    [[nodiscard]] std::string
+    message(int value) const override
+    {
+        switch (static_cast<FrameError>(value)) {
+        case FrameError::BadMagic:
+            return "Bad frame magic";
+        case FrameError::BadVersion:
+            return "Unsupported frame version";
+        case FrameError::BadFlags:
+            return "Unknown frame flags";
+        case FrameError::TooLarge:
+            return "Frame exceeds maximum size";
+        }
+        return "Unknown frame error";
+    }
+};
+
+std::uint32_t
+readUint(const char* data, std::size_t size)
+{
+    std::uint32_t value{0};
+    for (std::size_t n{0}; n < size; ++n) {
+        value = (value << 8) | static_cast<std::uint8_t>(data[n]);
+    }
+    return value;
+}
+
+void
+writeUint(char* data, std::size_t size, std::uint32_t value)
+{
+    for (std::size_t n{size}; n > 0; --n) {
+        data[n - 1] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+} // namespace
+
+const sys::error_category&
+frameCategory() noexcept
+{
+    static const FrameCategory category;
+    return category;
+}
+
+sys::error_code
+make_error_code(FrameError error) noexcept
+{
+    return sys::error_code{static_cast<int>(error), frameCategory()};
+}
+
+FrameCodec::FrameCodec(std::size_t maxFrame)
+    : _maxFrame{maxFrame}
+{
+    assert(maxFrame <= std::numeric_limits<std::uint32_t>::max());
+}
+
+FrameCodec::Header
+FrameCodec::encode(std::size_t length) const
+{
+    assert(length <= std::numeric_limits<std::uint32_t>::max());
+
+    Header header{};
+    writeUint(&header[0], 2, kMagic);
+    writeUint(&header[2], 1, kVersion);
+    writeUint(&header[3], 1, 0);
+    writeUint(&header[4], 4, static_cast<std::uint32_t>(length));
+    return header;
+}
+
+sys::error_code
+FrameCodec::decode(const Header& header, std::size_t& length) const
+{
+    if (readUint(&header[0], 2) != kMagic) {
+        return FrameError::BadMagic;
+    }
+    if (readUint(&header[2], 1) != kVersion) {
+        return FrameError::BadVersion;
+    }
+    if (readUint(&header[3], 1) != 0) {
+        return FrameError::BadFlags;
+    }
+    length = readUint(&header[4], 4);
+    if (length > _maxFrame) {
+        return FrameError::TooLarge;
+    }
+    return {};
+}
@@ -0,0 +1,68 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "FrameCodec.hpp"
+
+using namespace testing;
+
+TEST(FrameCodecTest, EncodesHeader)
+{
+    const FrameCodec codec{1024};
+    const auto header = codec.encode(0x0102);
+    EXPECT_EQ(FrameCodec::view(header), std::string_view("FR\x01\x00\x00\x00\x01\x02", 8));
+
+    std::size_t length{0};
+    EXPECT_FALSE(codec.decode(header, length));
+    EXPECT_EQ(length, 0x0102);
+}
+
+TEST(FrameCodecTest, AcceptsMaximumFrame)
+{
+    const FrameCodec codec{1024};
+    std::size_t length{0};
+    EXPECT_FALSE(codec.decode(codec.encode(0), length));
+    EXPECT_EQ(length, 0);
+    EXPECT_FALSE(codec.decode(codec.encode(1024), length));
+    EXPECT_EQ(length, 1024);
+}
+
+TEST(FrameCodecTest, RejectsInvalidHeader)
+{
+    const FrameCodec codec{1024};
+    std::size_t length{0};
+
+    auto header = codec.encode(16);
+    header[0] = 'G';
+    EXPECT_EQ(codec.decode(header, length), FrameError::BadMagic);
+
+    header = codec.encode(16);
+    header[2] = 2;
+    EXPECT_EQ(codec.decode(header, length), FrameError::BadVersion);
+
+    header = codec.encode(16);
+    header[3] = 1;
+    EXPECT_EQ(codec.decode(header, length), FrameError::BadFlags);
+
+    EXPECT_EQ(codec.decode(codec.encode(1025), length), FrameError::TooLarge);
+}
+
+TEST(FrameCodecTest, DescribesErrors)
+{
+    const sys::error_code errorCode = FrameError::TooLarge;
+    EXPECT_STREQ(errorCode.category().name(), "frame");
+    EXPECT_EQ(errorCode.message(), "Frame exceeds maximum size");
+}
@@ -0,0 +1,107 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "FrameReader.hpp"
+
+#include <string>
+
+using namespace testing;
+
+namespace {
+
+using Socket = asio::local::stream_protocol::socket;
+
+class FrameReaderTest : public Test {
+public:
+    FrameReaderTest()
+        : reader{FrameCodec{64}, BufferPool::create(64)}
+        , input{context}
+        , output{context}
+    {
+        asio::local::connect_pair(input, output);
+    }
+
+    void
+    send(std::string_view payload)
+    {
+        const auto header = reader.codec().encode(payload.size());
+        asio::write(output, std::array{asio::buffer(header), asio::buffer(payload)});
+    }
+
+    /* Reads frames until an error */
+    void
+    readAll()
+    {
+        reader.read(input, [this](sys::error_code errorCode, BufferPool::Buffer payload) {
+            if (errorCode) {
+                error = errorCode;
+                return;
+            }
+            frames.emplace_back(payload.view());
+            readAll();
+        });
+    }
+
+    asio::io_context context;
+    FrameReader reader;
+    Socket input;
+    Socket output;
+    std::vector<std::string> frames;
+    sys::error_code error;
+};
+
+} // namespace
+
+TEST_F(FrameReaderTest, ReadsFrames)
+{
+    send("first");
+    send("");
+    send(std::string(64, 'x'));
+    send(std::string_view{"\0\n\0", 3});
+    output.close();
+
+    readAll();
+    context.run();
+
+    EXPECT_THAT(frames,
+                ElementsAre("first", "", std::string(64, 'x'), std::string_view{"\0\n\0", 3}));
+    EXPECT_EQ(error, asio::error::eof);
+}
+
+TEST_F(FrameReaderTest, RejectsTooLargeFrame)
+{
+    send("first");
+    const auto header = reader.codec().encode(65);
+    asio::write(output, asio::buffer(header));
+
+    readAll();
+    context.run();
+
+    EXPECT_THAT(frames, ElementsAre("first"));
+    EXPECT_EQ(error, FrameError::TooLarge);
+}
+
+TEST_F(FrameReaderTest, RejectsForeignProtocol)
+{
+    asio::write(output, asio::buffer(std::string_view{"GET / HTTP/1.1\r\n"}));
+
+    readAll();
+    context.run();
+
+    EXPECT_TRUE(frames.empty());
+    EXPECT_EQ(error, FrameError::BadMagic);
+}
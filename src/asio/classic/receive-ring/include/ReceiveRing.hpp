@@ -0,0 +1,211 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace asio = boost::asio;
+
+/**
+ * Pool of equal receive buffers registered with the io_context
+ *
+ * The whole pool is one contiguous region registered once, so any part of a slot can be
+ * used as registered (fixed) buffer. With io_uring backend the kernel doesn't have to map
+ * user pages on every receive, with epoll backend registered buffers are ordinary buffers.
+ * If the pool is exhausted the slot falls back to heap memory (not registered).
+ *
+ * Registered buffers only pay off with io_uring backend, so with epoll backend a session
+ * may take a heap slot (see allocate()) instead of keeping the whole pool allocated.
+ *
+ * Not thread-safe: slots must be acquired and released on the context thread. Header-only,
+ * so it's built with asio backend and debugging options of the executable using it.
+ */
+class ReceiveRing : public std::enable_shared_from_this<ReceiveRing> {
+public:
+    class Slot {
+    public:
+        Slot() = default;
+
+        Slot(Slot&& other) noexcept = default;
+
+        Slot&
+        operator=(Slot&& other) noexcept;
+
+        ~Slot();
+
+        [[nodiscard]] std::span<char>
+        data() const;
+
+        /** Returns true if the slot belongs to the registered region */
+        [[nodiscard]] bool
+        registered() const;
+
+        /** Returns registered buffer for the part of the slot memory */
+        [[nodiscard]] asio::mutable_registered_buffer
+        registered(asio::mutable_buffer buffer) const;
+
+    private:
+        friend class ReceiveRing;
+
+        void
+        release();
+
+    private:
+        std::shared_ptr<ReceiveRing> _ring;
+        std::size_t _index{0};
+        std::span<char> _data;
+        std::unique_ptr<char[]> _heap;
+    };
+
+    ReceiveRing(asio::io_context& context, std::size_t slots, std::size_t slotSize);
+
+    [[nodiscard]] Slot
+    acquire();
+
+    /** Returns slot of heap memory (not registered) which doesn't belong to any ring */
+    [[nodiscard]] static Slot
+    allocate(std::size_t size);
+
+    [[nodiscard]] std::size_t
+    slotSize() const;
+
+private:
+    void
+    release(std::size_t index);
+
+private:
+    std::size_t _slotSize;
+    std::vector<char> _storage;
+    std::vector<std::size_t> _free;
+    std::optional<asio::buffer_registration<std::vector<asio::mutable_buffer>>> _registration;
+};
+
+//
+// Inlines
+//
+
+inline ReceiveRing::ReceiveRing(asio::io_context& context,
+                                std::size_t slots,
+                                std::size_t slotSize)
+    : _slotSize{slotSize}
+    , _storage(slots * slotSize)
+{
+    assert(slots > 0);
+    assert(slotSize > 0);
+
+    _free.reserve(slots);
+    for (std::size_t n{slots}; n > 0; --n) {
+        _free.push_back(n - 1);
+    }
+
+    try {
+        _registration.emplace(asio::register_buffers(
+            context, std::vector<asio::mutable_buffer>{asio::buffer(_storage)}));
+    } catch (const boost::system::system_error& e) {
+        /* E.g. registered memory exceeds RLIMIT_MEMLOCK, slots are still usable */
+        std::cerr << "ReceiveRing: " << e.what() << std::endl;
+    }
+}
+
+inline ReceiveRing::Slot
+ReceiveRing::acquire()
+{
+    if (_free.empty()) {
+        return allocate(_slotSize);
+    }
+
+    Slot slot;
+    slot._ring = shared_from_this();
+    slot._index = _free.back();
+    slot._data = std::span<char>{&_storage[slot._index * _slotSize], _slotSize};
+    _free.pop_back();
+    return slot;
+}
+
+inline ReceiveRing::Slot
+ReceiveRing::allocate(std::size_t size)
+{
+    Slot slot;
+    slot._heap = std::make_unique<char[]>(size);
+    slot._data = std::span<char>{slot._heap.get(), size};
+    return slot;
+}
+
+inline std::size_t
+ReceiveRing::slotSize() const
+{
+    return _slotSize;
+}
+
+inline void
+ReceiveRing::release(std::size_t index)
+{
+    _free.push_back(index);
+}
+
+inline ReceiveRing::Slot&
+ReceiveRing::Slot::operator=(Slot&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        _ring = std::move(other._ring);
+        _index = other._index;
+        _data = other._data;
+        _heap = std::move(other._heap);
+    }
+    return *this;
+}
+
+inline ReceiveRing::Slot::~Slot()
+{
+    release();
+}
+
+inline std::span<char>
+ReceiveRing::Slot::data() const
+{
+    return _data;
+}
+
+inline bool
+ReceiveRing::Slot::registered() const
+{
+    return (_ring && _ring->_registration);
+}
+
+inline asio::mutable_registered_buffer
+ReceiveRing::Slot::registered(asio::mutable_buffer buffer) const
+{
+    assert(registered());
+    const auto offset = static_cast<char*>(buffer.data()) - _ring->_storage.data();
+    assert(offset >= 0 && offset + buffer.size() <= _ring->_storage.size());
+    return asio::buffer((*_ring->_registration)[0] + offset, buffer.size());
+}
+
+inline void
+ReceiveRing::Slot::release()
+{
+    if (_ring) {
+        _ring->release(_index);
+        _ring.reset();
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "ReceiveRing.hpp"
+
+using namespace testing;
+
+TEST(ReceiveRingTest, AcquiresSlotsOfRegion)
+{
+    asio::io_context context;
+    auto ring = std::make_shared<ReceiveRing>(context, 2, 1024);
+    EXPECT_EQ(ring->slotSize(), 1024);
+
+    auto first = ring->acquire();
+    auto second = ring->acquire();
+    EXPECT_EQ(first.data().size(), 1024);
+    EXPECT_EQ(second.data().size(), 1024);
+    /* Slots are the adjacent parts of one region */
+    EXPECT_EQ(std::abs(first.data().data() - second.data().data()), 1024);
+}
+
+TEST(ReceiveRingTest, FallsBackToHeapIfExhausted)
+{
+    asio::io_context context;
+    auto ring = std::make_shared<ReceiveRing>(context, 1, 1024);
+
+    auto slot = ring->acquire();
+    auto overflow = ring->acquire();
+    EXPECT_EQ(overflow.data().size(), 1024);
+    EXPECT_FALSE(overflow.registered());
+    EXPECT_NE(overflow.data().data(), slot.data().data());
+}
+
+TEST(ReceiveRingTest, ReusesReleasedSlot)
+{
+    asio::io_context context;
+    auto ring = std::make_shared<ReceiveRing>(context, 1, 1024);
+
+    char* data{nullptr};
+    {
+        auto slot = ring->acquire();
+        data = slot.data().data();
+    }
+    auto slot = ring->acquire();
+    EXPECT_EQ(slot.data().data(), data);
+
+    /* Moved slot is released once */
+    ReceiveRing::Slot moved{std::move(slot)};
+    slot = ReceiveRing::Slot{};
+    EXPECT_EQ(moved.data().data(), data);
+}
+
+TEST(ReceiveRingTest, AllocatesUnregisteredSlot)
+{
+    auto slot = ReceiveRing::allocate(512);
+    EXPECT_EQ(slot.data().size(), 512);
+    EXPECT_FALSE(slot.registered());
+}
@@ -0,0 +1,79 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * Identifier of multiplexed request on the wire
+ *
+ * The payload of length-prefixed frame starts with the identifier of request (8 bytes,
+ * big-endian) and the response carries the identifier of its request, so responses to
+ * requests sharing a connection may be matched in any order.
+ */
+class RequestTag {
+public:
+    static constexpr std::size_t kSize{8};
+
+    using Bytes = std::array<char, kSize>;
+
+    [[nodiscard]] static Bytes
+    encode(std::uint64_t id) noexcept;
+
+    /* Returns the identifier the payload starts with (none if the payload is too short) */
+    [[nodiscard]] static std::optional<std::uint64_t>
+    decode(std::string_view payload) noexcept;
+
+    /* Returns the payload following the identifier */
+    [[nodiscard]] static std::string_view
+    strip(std::string_view payload) noexcept;
+};
+
+//
+// Inlines
+//
+
+inline RequestTag::Bytes
+RequestTag::encode(std::uint64_t id) noexcept
+{
+    Bytes bytes{};
+    for (std::size_t n{kSize}; n > 0; --n) {
+        bytes[n - 1] = static_cast<char>(id & 0xFF);
+        id >>= 8;
+    }
+    return bytes;
+}
+
+inline std::optional<std::uint64_t>
+RequestTag::decode(std::string_view payload) noexcept
+{
+    if (payload.size() < kSize) {
+        return std::nullopt;
+    }
+    std::uint64_t id{0};
+    for (std::size_t n{0}; n < kSize; ++n) {
+        id = (id << 8) | static_cast<std::uint8_t>(payload[n]);
+    }
+    return id;
+}
+
+inline std::string_view
+RequestTag::strip(std::string_view payload) noexcept
+{
+    return payload.substr(kSize);
+}
@@ -15,9 +15,13 @@
 
 #pragma once
 
+#include "FrameCodec.hpp"
+#include "BufferPool.hpp"
+
 #include <boost/asio.hpp>
 
 #include <atomic>
+#include <memory>
 #include <optional>
 
 namespace net = boost::asio;
@@ -25,7 +29,10 @@ namespace sys = boost::system;
 
 class TcpAsyncAcceptor {
 public:
-    TcpAsyncAcceptor(net::io_context& context, net::ip::port_type port);
+    TcpAsyncAcceptor(net::io_context& context,
+                     net::ip::port_type port,
+                     Framing framing = Framing::Line,
+                     bool multiplexed = false);
 
     void
     start();
@@ -46,4 +53,8 @@ private:
     net::ip::tcp::acceptor _acceptor;
     net::ip::tcp::endpoint _endpoint;
     std::optional<net::ip::tcp::socket> _socket;
+    /* Receive buffers of all connections (length-prefixed framing only) */
+    std::shared_ptr<BufferPool> _pool;
+    /* Whether requests are tagged (length-prefixed framing only) */
+    bool _multiplexed;
 };
\ No newline at end of file
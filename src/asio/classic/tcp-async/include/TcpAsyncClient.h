@@ -14,37 +14,97 @@
 
 #pragma once
 
+#include "FrameReader.hpp"
+
 #include <boost/asio.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <chrono>
 #include <thread>
 #include <mutex>
 #include <map>
 #include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
 
 namespace net = boost::asio;
 namespace sys = boost::system;
 
+/**
+ * Asynchronous client of request-response servers
+ *
+ * Connections are kept open after a response and reused by next requests to the same
+ * endpoint, so a request pays for a TCP handshake (and teardown) only if no idle connection
+ * is pooled. Pooled connections are closed once idle for longer than the timeout, and are
+ * checked for being closed by the server before reuse. A request failed on a reused
+ * connection before any response is retried once on a new one.
+ *
+ * Multiplexed requests to an endpoint share one connection instead: they carry RequestTag on
+ * the wire, the ones issued while another write is in flight are written at once, and
+ * responses are matched to them in any order.
+ */
 class TcpAsyncClient : public boost::noncopyable {
 public:
     using RequestId = std::uint64_t;
     using RequestCallback
         = std::function<void(const RequestId, std::string response, const sys::error_code)>;
 
-    explicit TcpAsyncClient(std::size_t numberOfThread = std::thread::hardware_concurrency());
+    /* How requests to an endpoint share connections */
+    enum class Mode {
+        /* A request at a time per connection, idle connections are pooled */
+        Pooled,
+        /* Requests share one connection (length-prefixed framing) */
+        Multiplexed
+    };
+
+    struct PoolOptions {
+        /* The number of idle connections kept per endpoint (connection per request if zero) */
+        std::size_t maxIdle{8};
+        /* The time idle connection is kept for */
+        std::chrono::milliseconds idleTimeout{std::chrono::seconds{30}};
+        /* Checks idle connection wasn't closed by the server before reusing it */
+        bool healthCheck{true};
+    };
+
+    struct Counters {
+        /* The number of connections established */
+        std::size_t connected{0};
+        /* The number of requests sent over pooled connections */
+        std::size_t reused{0};
+        /* The number of pooled connections closed (expired, failed check or pool full) */
+        std::size_t discarded{0};
+        /* The number of requests retried after reused connection failed */
+        std::size_t retried{0};
+        /* The number of writes of multiplexed requests (requests queued meanwhile coalesce) */
+        std::size_t writes{0};
+    };
+
+    explicit TcpAsyncClient(std::size_t numberOfThread = std::thread::hardware_concurrency(),
+                            Framing framing = Framing::Line);
 
+    TcpAsyncClient(std::size_t numberOfThread, Framing framing, PoolOptions pool);
+
+    TcpAsyncClient(std::size_t numberOfThread, Mode mode);
+
+    /* Sends message, the callback gets the response (message_size error, without sending, if
+       the message doesn't fit a frame with length-prefixed framing) */
     [[maybe_unused]] RequestId
     communicate(std::string message,
                 std::string_view address,
                 net::ip::port_type port,
                 RequestCallback callback);
 
+    /* Cancels request, multiplexed request is only forgotten (its response is ignored) */
     void
     cancel(RequestId requestId);
 
     void
     close();
 
+    [[nodiscard]] Counters
+    counters() const;
+
 private:
     struct Session {
         using Ptr = std::shared_ptr<Session>;
@@ -59,7 +119,7 @@ private:
             , request{std::move(request)}
             , callback{std::move(callback)}
             , endpoint{net::ip::make_address(address), port}
-            , socket{context, endpoint.protocol()}
+            , socket{context}
         {
         }
 
@@ -67,17 +127,119 @@ private:
         const std::string request;
         RequestCallback callback;
         bool cancel{false};
+        /* Whether the connection was taken from the pool */
+        bool reused{false};
         net::streambuf responseBuffer;
+        /* Header of request and reader of response (length-prefixed framing only) */
+        FrameCodec::Header header{};
+        std::optional<FrameReader> frames;
         std::string response;
         net::ip::tcp::endpoint endpoint;
         net::ip::tcp::socket socket;
         std::mutex guard;
     };
 
+    /* Connection kept open between requests (with the reader of its frames) */
+    struct IdleConnection {
+        net::ip::tcp::socket socket;
+        std::optional<FrameReader> frames;
+        std::chrono::steady_clock::time_point since;
+    };
+
     static RequestId
     getRequestId();
 
+    /* Connection shared by multiplexed requests to an endpoint, used on its strand */
+    struct Channel {
+        using Ptr = std::shared_ptr<Channel>;
+
+        Channel(net::ip::tcp::endpoint endpoint,
+                net::io_context& context,
+                FrameCodec codec,
+                std::shared_ptr<BufferPool> pool)
+            : endpoint{endpoint}
+            , strand{net::make_strand(context)}
+            , socket{strand}
+            , frames{codec, std::move(pool)}
+        {
+        }
+
+        const net::ip::tcp::endpoint endpoint;
+        net::strand<net::io_context::executor_type> strand;
+        net::ip::tcp::socket socket;
+        FrameReader frames;
+        bool connected{false};
+        bool failed{false};
+        /* Requests queued while the others are written */
+        std::string pending;
+        std::string writing;
+        /* Requests sent over the connection and not answered yet */
+        std::unordered_set<RequestId> requests;
+    };
+
+    /* Returns false unless the server closed the connection or sent unexpected data */
+    static bool
+    isAlive(net::ip::tcp::socket& socket);
+
 private:
+    /* Sends request of the session over pooled connection or a new one */
+    void
+    start(const Session::Ptr& session);
+
+    void
+    connect(const Session::Ptr& session);
+
+    /* Moves idle connection to the endpoint of session into it, returns false if none */
+    bool
+    acquire(Session& session);
+
+    /* Keeps connection of session for next requests (closes it if the pool is full) */
+    void
+    release(Session& session);
+
+    /* Closes connections idle for longer than timeout */
+    void
+    sweep();
+
+    void
+    scheduleSweep();
+
+    /* Sends request of the session over the channel to its endpoint */
+    void
+    multiplex(const Session::Ptr& session);
+
+    /* Returns the channel to the endpoint (connecting a new one if there is none) */
+    Channel::Ptr
+    channelTo(const net::ip::tcp::endpoint& endpoint);
+
+    /* Queues request of the session, must be called on the channel strand */
+    void
+    enqueue(const Channel::Ptr& channel, const Session::Ptr& session);
+
+    /* Writes requests queued meanwhile, must be called on the channel strand */
+    void
+    flush(const Channel::Ptr& channel);
+
+    void
+    onChannelConnectDone(const Channel::Ptr& channel, sys::error_code ec);
+
+    void
+    onChannelWriteDone(const Channel::Ptr& channel, sys::error_code ec);
+
+    void
+    readResponse(const Channel::Ptr& channel);
+
+    void
+    onResponseDone(const Channel::Ptr& channel, BufferPool::Buffer response, sys::error_code ec);
+
+    /* Completes requests of the channel with the error, next requests take a new channel */
+    void
+    failChannel(const Channel::Ptr& channel, sys::error_code ec);
+
+    /* Removes session of the request, returns null if it's complete or cancelled */
+    Session::Ptr
+    takeSession(RequestId id);
+
     void
     onConnectDone(const Session::Ptr& session, sys::error_code ec);
 
@@ -87,12 +249,25 @@ private:
     void
     onReadDone(const Session::Ptr& session, std::size_t bytesRead, sys::error_code ec);
 
+    void
+    onFrameDone(const Session::Ptr& session, BufferPool::Buffer response, sys::error_code ec);
+
     void
     onComplete(const Session::Ptr& session, sys::error_code ec);
 
 private:
+    Mode _mode{Mode::Pooled};
+    Framing _framing;
+    std::shared_ptr<BufferPool> _pool;
     net::io_context _context;
     std::vector<std::thread> _threads;
     std::mutex _sessionsGuard;
     std::map<RequestId, Session::Ptr> _sessions;
+    PoolOptions _poolOptions;
+    net::steady_timer _sweeper;
+    mutable std::mutex _idleGuard;
+    std::map<net::ip::tcp::endpoint, std::vector<IdleConnection>> _idle;
+    Counters _counters;
+    std::mutex _channelsGuard;
+    std::map<net::ip::tcp::endpoint, Channel::Ptr> _channels;
 };
\ No newline at end of file
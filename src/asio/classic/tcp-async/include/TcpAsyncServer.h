@@ -27,7 +27,10 @@ namespace sys = boost::system;
 
 class TcpAsyncServer final : boost::noncopyable {
 public:
-    explicit TcpAsyncServer(net::io_context& context);
+    /* Multiplexed requests are tagged by RequestTag (length-prefixed framing only) */
+    explicit TcpAsyncServer(net::io_context& context,
+                            Framing framing = Framing::Line,
+                            bool multiplexed = false);
 
     ~TcpAsyncServer();
 
@@ -40,6 +43,8 @@ public:
 
 private:
     net::io_context& _context;
+    Framing _framing;
+    bool _multiplexed;
     std::vector<std::thread> _threads;
     std::unique_ptr<TcpAsyncAcceptor> _acceptor;
 };
\ No newline at end of file
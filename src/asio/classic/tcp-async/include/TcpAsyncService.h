@@ -14,28 +14,71 @@
 
 #pragma once
 
+#include "FrameReader.hpp"
+
 #include <boost/asio.hpp>
 
 namespace net = boost::asio;
 namespace sys = boost::system;
 
 #include <memory>
+#include <optional>
+#include <string>
 
 class TcpAsyncService : public std::enable_shared_from_this<TcpAsyncService> {
 public:
     explicit TcpAsyncService(net::ip::tcp::socket&& socket);
 
+    /* Creates service receiving length-prefixed frames into buffers of given pool, multiplexed
+       requests (tagged by RequestTag) are read while responses to previous ones are written,
+       responses waiting for the write in flight are written at once (reading pauses while too
+       many of them wait) */
+    TcpAsyncService(net::ip::tcp::socket&& socket,
+                    std::shared_ptr<BufferPool> pool,
+                    bool multiplexed = false);
+
+    /* Serves requests of the connection one after another until the client closes it */
     void
     handle();
 
 private:
+    void
+    read();
+
     void
     onReadDone(const sys::error_code& ec, std::size_t bytesRead);
 
+    void
+    onFrameDone(const sys::error_code& ec, BufferPool::Buffer request);
+
+    void
+    onTaggedFrameDone(const sys::error_code& ec, BufferPool::Buffer request);
+
+    /* Writes responses queued meanwhile (must be called on the strand) */
+    void
+    flush();
+
+    void
+    onFlushDone(const sys::error_code& ec);
+
+    void
+    respond(std::string_view request);
+
     void
     onWriteDone(const sys::error_code& ec, std::size_t bytesWritten);
 
 private:
     net::ip::tcp::socket _socket;
     net::streambuf _buffer;
+    std::optional<FrameReader> _frames;
+    FrameCodec::Header _header{};
+    std::string _response;
+    bool _multiplexed{false};
+    /* Serializes reading and writing of multiplexed requests and responses */
+    net::strand<net::any_io_executor> _strand{_socket.get_executor()};
+    /* Responses queued while the others are written (multiplexed requests only) */
+    std::string _pending;
+    std::string _writing;
+    /* Reading is paused until the responses queued are written */
+    bool _readPaused{false};
 };
\ No newline at end of file
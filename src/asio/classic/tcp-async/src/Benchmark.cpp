@@ -0,0 +1,234 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TcpAsyncClient.h"
+#include "TcpAsyncServer.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Request rate and latency of TcpAsyncClient with and without connection pooling
+ *
+ * The server runs in this process (its log is dropped). The given number of requests is kept
+ * outstanding, every response issues the next request until all of them are done, either
+ * over a new connection per request, over connections reused from the pool or multiplexed
+ * over a single connection.
+ */
+
+namespace {
+
+enum class Transport { Connect, Pool, Multiplex };
+
+struct BenchOptions {
+    net::ip::port_type port{3400};
+    std::size_t requests{20000};
+    std::size_t concurrency{64};
+    std::size_t threads{2};
+    Framing framing{Framing::Line};
+};
+
+struct Result {
+    double requestsPerSecond;
+    std::chrono::nanoseconds p50;
+    std::chrono::nanoseconds p99;
+    TcpAsyncClient::Counters counters;
+    std::size_t failed;
+};
+
+/* Returns the value the given share of values doesn't exceed (reorders values) */
+std::chrono::nanoseconds
+percentile(std::vector<std::chrono::nanoseconds>& values, double share)
+{
+    const auto nth = values.begin() + static_cast<std::ptrdiff_t>((values.size() - 1) * share);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+const char*
+toString(Transport transport)
+{
+    switch (transport) {
+    case Transport::Connect:
+        return "connect";
+    case Transport::Pool:
+        return "pool";
+    case Transport::Multiplex:
+        return "multiplex";
+    }
+    return "";
+}
+
+std::unique_ptr<TcpAsyncClient>
+makeClient(const BenchOptions& options, Transport transport)
+{
+    if (transport == Transport::Multiplex) {
+        return std::make_unique<TcpAsyncClient>(options.threads,
+                                                TcpAsyncClient::Mode::Multiplexed);
+    }
+    TcpAsyncClient::PoolOptions pool;
+    pool.maxIdle = (transport == Transport::Pool) ? options.concurrency : 0;
+    return std::make_unique<TcpAsyncClient>(options.threads, options.framing, pool);
+}
+
+Result
+runBenchmark(const BenchOptions& options, Transport transport)
+{
+    const bool multiplexed{transport == Transport::Multiplex};
+    net::io_context serverContext;
+    TcpAsyncServer server{
+        serverContext, multiplexed ? Framing::Length : options.framing, multiplexed};
+    server.start(options.port, options.threads);
+
+    auto client = makeClient(options, transport);
+
+    std::vector<std::chrono::nanoseconds> latencies(options.requests);
+    std::atomic<std::size_t> issued{0};
+    std::atomic<std::size_t> completed{0};
+    std::atomic<std::size_t> failed{0};
+    std::mutex doneGuard;
+    std::condition_variable whenDone;
+
+    std::function<void()> issue = [&]() {
+        if (issued++ >= options.requests) {
+            return;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        client->communicate(
+            "Ping",
+            "127.0.0.1",
+            options.port,
+            [&, start](const auto, std::string response, const sys::error_code ec) {
+                const auto index = completed++;
+                latencies[index] = std::chrono::steady_clock::now() - start;
+                if (ec || response != "Pong") {
+                    ++failed;
+                }
+                if (index + 1 == options.requests) {
+                    std::lock_guard lock{doneGuard};
+                    whenDone.notify_one();
+                } else {
+                    issue();
+                }
+            });
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t n{0}; n < std::min(options.concurrency, options.requests); ++n) {
+        issue();
+    }
+    std::unique_lock lock{doneGuard};
+    whenDone.wait(lock, [&]() { return completed == options.requests; });
+    lock.unlock();
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    Result result{};
+    result.requestsPerSecond = options.requests / elapsed.count();
+    result.p50 = percentile(latencies, 0.5);
+    result.p99 = percentile(latencies, 0.99);
+    result.counters = client->counters();
+    result.failed = failed;
+
+    client->close();
+    server.stop();
+    return result;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::string framing;
+    std::vector<std::string> modes;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<net::ip::port_type>(&options.port)->default_value(3400), "Set first port")
+        ("requests,n", po::value<std::size_t>(&options.requests)->default_value(20000), "Set number of requests")
+        ("concurrency,c", po::value<std::size_t>(&options.concurrency)->default_value(64), "Set number of outstanding requests")
+        ("threads,t", po::value<std::size_t>(&options.threads)->default_value(2), "Set number of client (and server) threads")
+        ("framing,f", po::value<std::string>(&framing)->default_value("line"), "Set framing of messages (line or length)")
+        ("mode,m", po::value<std::vector<std::string>>(&modes)->multitoken(), "Set modes to run (connect, pool or multiplex), all by default")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.requests == 0 || options.concurrency == 0 || options.threads == 0
+        || (framing != "line" && framing != "length")) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.framing = (framing == "line") ? Framing::Line : Framing::Length;
+
+    std::vector<Transport> transports;
+    for (const auto transport : {Transport::Connect, Transport::Pool, Transport::Multiplex}) {
+        if (modes.empty() || std::ranges::count(modes, toString(transport)) > 0) {
+            transports.push_back(transport);
+        }
+    }
+    if (transports.size() < std::max<std::size_t>(modes.size(), 1)) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* The server logs every connection */
+    std::cout.rdbuf(nullptr);
+    std::cerr.rdbuf(nullptr);
+
+    std::printf("%10s %12s %10s %10s %10s %8s %8s\n",
+                "mode",
+                "requests/s",
+                "p50 us",
+                "p99 us",
+                "connected",
+                "writes",
+                "failed");
+    for (const auto transport : transports) {
+        const auto result = runBenchmark(options, transport);
+        std::printf("%10s %12.0f %10.1f %10.1f %10zu %8zu %8zu\n",
+                    toString(transport),
+                    result.requestsPerSecond,
+                    std::chrono::duration<double, std::micro>(result.p50).count(),
+                    std::chrono::duration<double, std::micro>(result.p99).count(),
+                    result.counters.connected,
+                    result.counters.writes,
+                    result.failed);
+        ++options.port;
+    }
+    return EXIT_SUCCESS;
+}
@@ -30,13 +30,16 @@ namespace po = boost::program_options;
 using namespace std::chrono_literals;
 
 static void
-executeClient(std::string message)
+executeClient(std::string message, Framing framing, bool multiplexed)
 {
     bool exit{false};
     std::mutex exitMutex;
     std::condition_variable whenExit;
 
-    TcpAsyncClient client;
+    const auto threads = std::thread::hardware_concurrency();
+    TcpAsyncClient client = multiplexed
+                                ? TcpAsyncClient{threads, TcpAsyncClient::Mode::Multiplexed}
+                                : TcpAsyncClient{threads, framing};
     client.communicate(std::move(message),
                        "127.0.0.1",
                        3333,
@@ -60,7 +63,7 @@ executeClient(std::string message)
 }
 
 static void
-executeServer()
+executeServer(Framing framing, bool multiplexed)
 {
     bool exit{false};
     std::mutex exitMutex;
@@ -79,7 +82,7 @@ executeServer()
         whenExit.notify_one();
     });
 
-    TcpAsyncServer server{context};
+    TcpAsyncServer server{context, framing, multiplexed};
     server.start(3333);
 
     std::unique_lock lock{exitMutex};
@@ -92,6 +95,7 @@ int
 main(int argc, char* argv[])
 {
     std::string message;
+    std::string framing;
     bool runClient{false};
     bool runServer{false};
 
@@ -102,6 +106,7 @@ main(int argc, char* argv[])
         ("client,c", po::bool_switch(&runClient), "Run client")
         ("server,s", po::bool_switch(&runServer), "Run server")
         ("message,m", po::value<std::string>(&message)->default_value("Ping"), "Message to send")
+        ("framing,f", po::value<std::string>(&framing)->default_value("line"), "Set framing of messages (line, length or multiplexed)")
         ;
     // clang-format on
 
@@ -112,12 +117,19 @@ main(int argc, char* argv[])
     if (!runClient && !runServer) {
         return EXIT_FAILURE;
     }
+    if (framing != "line" && framing != "length" && framing != "multiplexed") {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
 
+    /* Multiplexed requests are tagged inside length-prefixed frames */
+    const auto selected = (framing == "line") ? Framing::Line : Framing::Length;
+    const bool multiplexed{framing == "multiplexed"};
     if (runClient) {
-        executeClient(std::move(message));
+        executeClient(std::move(message), selected, multiplexed);
     }
     if (runServer) {
-        executeServer();
+        executeServer(selected, multiplexed);
     }
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -18,12 +18,27 @@
 
 #include <iostream>
 
-TcpAsyncAcceptor::TcpAsyncAcceptor(net::io_context& context, net::ip::port_type port)
+namespace {
+
+/* The maximum size of cached receive buffer */
+constexpr std::size_t kMaxPooledBuffer{65536};
+
+} // namespace
+
+TcpAsyncAcceptor::TcpAsyncAcceptor(net::io_context& context,
+                                   net::ip::port_type port,
+                                   Framing framing,
+                                   bool multiplexed)
     : _stop{false}
     , _context{context}
     , _acceptor{context}
     , _endpoint{net::ip::tcp::v4(), port}
+    , _multiplexed{multiplexed}
 {
+    assert(!multiplexed || framing == Framing::Length);
+    if (framing == Framing::Length) {
+        _pool = BufferPool::create(kMaxPooledBuffer);
+    }
 }
 
 void
@@ -74,7 +89,12 @@ TcpAsyncAcceptor::onAcceptDone(const sys::error_code& ec)
         std::cerr << "onAcceptDone: " << ec.what() << std::endl;
     } else {
         /* Handle current connection */
-        std::make_shared<TcpAsyncService>(std::move(*_socket))->handle();
+        if (_pool) {
+            std::make_shared<TcpAsyncService>(std::move(*_socket), _pool, _multiplexed)
+                ->handle();
+        } else {
+            std::make_shared<TcpAsyncService>(std::move(*_socket))->handle();
+        }
     }
 
     if (_stop) {
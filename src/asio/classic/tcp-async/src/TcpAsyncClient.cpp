@@ -13,6 +13,14 @@
 // limitations under the License.
 
 #include "TcpAsyncClient.h"
+#include "RequestTag.h"
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
 
 namespace {
 
@@ -25,35 +33,92 @@ spawnThread(net::io_context& context)
     }};
 }
 
+/* The maximum size of response frame */
+constexpr std::size_t kMaxFrame{65535};
+
+/* Returns true if the error means the server closed connection (which was idle in the pool) */
+bool
+isStale(sys::error_code ec)
+{
+    return ec == net::error::eof || ec == net::error::connection_reset
+           || ec == net::error::broken_pipe;
+}
+
 } // namespace
 
-TcpAsyncClient::TcpAsyncClient(std::size_t numberOfThread)
+TcpAsyncClient::TcpAsyncClient(std::size_t numberOfThread, Framing framing)
+    : TcpAsyncClient{numberOfThread, framing, PoolOptions{}}
 {
+}
+
+TcpAsyncClient::TcpAsyncClient(std::size_t numberOfThread, Framing framing, PoolOptions pool)
+    : _framing{framing}
+    , _poolOptions{pool}
+    , _sweeper{_context}
+{
+    if (_framing == Framing::Length) {
+        _pool = BufferPool::create(kMaxFrame);
+    }
+    if (_poolOptions.maxIdle > 0) {
+        scheduleSweep();
+    }
+
     assert(numberOfThread > 0);
     while (numberOfThread--) {
         _threads.push_back(spawnThread(_context));
     }
 }
 
+TcpAsyncClient::TcpAsyncClient(std::size_t numberOfThread, Mode mode)
+    /* Multiplexed requests don't pool connections, so idle ones aren't swept either */
+    : TcpAsyncClient{numberOfThread,
+                     mode == Mode::Multiplexed ? Framing::Length : Framing::Line,
+                     mode == Mode::Multiplexed ? PoolOptions{.maxIdle = 0} : PoolOptions{}}
+{
+    _mode = mode;
+}
+
 TcpAsyncClient::RequestId
 TcpAsyncClient::communicate(std::string message,
                             std::string_view address,
                             net::ip::port_type port,
                             RequestCallback callback)
 {
-    /* Add terminal message symbol */
-    message.push_back('\n');
+    if (_framing == Framing::Line) {
+        /* Add terminal message symbol */
+        message.push_back('\n');
+    }
+
+    const auto id{getRequestId()};
+    if (_framing == Framing::Length) {
+        /* The server would close the connection, failing multiplexed requests sharing it too */
+        const std::size_t limit
+            = kMaxFrame - ((_mode == Mode::Multiplexed) ? RequestTag::kSize : 0);
+        if (message.size() > limit) {
+            if (callback) {
+                net::post(_context, [id, callback = std::move(callback)]() {
+                    callback(id, {}, net::error::message_size);
+                });
+            }
+            return id;
+        }
+    }
 
     auto session = std::make_shared<Session>(
-        0, std::move(message), address, port, std::move(callback), _context);
+        id, std::move(message), address, port, std::move(callback), _context);
+    if (_framing == Framing::Length && _mode == Mode::Pooled) {
+        session->header = FrameCodec{kMaxFrame}.encode(session->request.size());
+    }
 
-    const auto id{getRequestId()};
     std::unique_lock lock{_sessionsGuard};
     _sessions[id] = session;
     lock.unlock();
 
-    session->socket.async_connect(
-        session->endpoint, [this, session](sys::error_code ec) { onConnectDone(session, ec); });
+    if (_mode == Mode::Multiplexed) {
+        multiplex(session);
+    } else {
+        start(session);
+    }
 
     return id;
 }
@@ -61,12 +126,23 @@ TcpAsyncClient::communicate(std::string message,
 void
 TcpAsyncClient::cancel(RequestId requestId)
 {
+    if (_mode == Mode::Multiplexed) {
+        /* The connection is shared, so the request is sent anyway and its response dropped */
+        if (auto session = takeSession(requestId); session && session->callback) {
+            net::post(_context, [session]() {
+                session->callback(session->id, {}, net::error::operation_aborted);
+            });
+        }
+        return;
+    }
+
     std::lock_guard lock{_sessionsGuard};
     if (auto it = _sessions.find(requestId); it != _sessions.end()) {
         const auto [_, session] = *it;
         std::lock_guard sessionLock{session->guard};
         session->cancel = true;
-        session->socket.cancel();
+        sys::error_code ignored;
+        session->socket.cancel(ignored);
     }
 }
 
@@ -82,6 +158,299 @@ TcpAsyncClient::close()
     }
 }
 
+TcpAsyncClient::Counters
+TcpAsyncClient::counters() const
+{
+    std::lock_guard lock{_idleGuard};
+    return _counters;
+}
+
+bool
+TcpAsyncClient::isAlive(net::ip::tcp::socket& socket)
+{
+    char byte;
+    const auto bytes = ::recv(socket.native_handle(), &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    return bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+void
+TcpAsyncClient::start(const Session::Ptr& session)
+{
+    if (acquire(*session)) {
+        /* The request is written as the connection was just established */
+        onConnectDone(session, sys::error_code{});
+    } else {
+        connect(session);
+    }
+}
+
+void
+TcpAsyncClient::connect(const Session::Ptr& session)
+{
+    if (_framing == Framing::Length) {
+        session->frames.emplace(FrameCodec{kMaxFrame}, _pool);
+    }
+    std::unique_lock lock{_idleGuard};
+    ++_counters.connected;
+    lock.unlock();
+
+    session->socket.async_connect(
+        session->endpoint, [this, session](sys::error_code ec) { onConnectDone(session, ec); });
+}
+
+bool
+TcpAsyncClient::acquire(Session& session)
+{
+    if (_poolOptions.maxIdle == 0) {
+        return false;
+    }
+
+    /* The session is published already, so cancel() may touch its socket meanwhile */
+    std::lock_guard sessionLock{session.guard};
+    std::lock_guard lock{_idleGuard};
+    auto it = _idle.find(session.endpoint);
+    if (it == _idle.end()) {
+        return false;
+    }
+    auto& connections = it->second;
+    const auto expired = std::chrono::steady_clock::now() - _poolOptions.idleTimeout;
+    /* The most recently used connection is taken, as the others are more likely to expire */
+    while (!connections.empty()) {
+        auto connection = std::move(connections.back());
+        connections.pop_back();
+        if (connection.since < expired
+            || (_poolOptions.healthCheck && !isAlive(connection.socket))) {
+            sys::error_code ignored;
+            connection.socket.close(ignored);
+            ++_counters.discarded;
+            continue;
+        }
+        session.socket = std::move(connection.socket);
+        session.frames = std::move(connection.frames);
+        session.reused = true;
+        ++_counters.reused;
+        return true;
+    }
+    return false;
+}
+
+void
+TcpAsyncClient::release(Session& session)
+{
+    std::lock_guard sessionLock{session.guard};
+    std::lock_guard lock{_idleGuard};
+    auto& connections = _idle[session.endpoint];
+    if (connections.size() >= _poolOptions.maxIdle) {
+        sys::error_code ignored;
+        session.socket.close(ignored);
+        ++_counters.discarded;
+        return;
+    }
+    connections.push_back(IdleConnection{std::move(session.socket),
+                                         std::move(session.frames),
+                                         std::chrono::steady_clock::now()});
+}
+
+void
+TcpAsyncClient::sweep()
+{
+    std::lock_guard lock{_idleGuard};
+    const auto expired = std::chrono::steady_clock::now() - _poolOptions.idleTimeout;
+    for (auto& [_, connections] : _idle) {
+        /* Connections are kept in order they were released, so the expired ones go first */
+        const auto end
+            = std::find_if(connections.begin(), connections.end(), [&](const auto& connection) {
+                  return connection.since >= expired;
+              });
+        for (auto it = connections.begin(); it != end; ++it) {
+            sys::error_code ignored;
+            it->socket.close(ignored);
+            ++_counters.discarded;
+        }
+        connections.erase(connections.begin(), end);
+    }
+}
+
+void
+TcpAsyncClient::scheduleSweep()
+{
+    _sweeper.expires_after(_poolOptions.idleTimeout);
+    _sweeper.async_wait([this](sys::error_code ec) {
+        if (ec) {
+            return;
+        }
+        sweep();
+        scheduleSweep();
+    });
+}
+
+void
+TcpAsyncClient::multiplex(const Session::Ptr& session)
+{
+    auto channel = channelTo(session->endpoint);
+    net::dispatch(channel->strand, [this, channel, session]() { enqueue(channel, session); });
+}
+
+TcpAsyncClient::Channel::Ptr
+TcpAsyncClient::channelTo(const net::ip::tcp::endpoint& endpoint)
+{
+    std::lock_guard lock{_channelsGuard};
+    if (auto it = _channels.find(endpoint); it != _channels.end()) {
+        return it->second;
+    }
+
+    auto channel = std::make_shared<Channel>(endpoint, _context, FrameCodec{kMaxFrame}, _pool);
+    _channels.emplace(endpoint, channel);
+    std::unique_lock countersLock{_idleGuard};
+    ++_counters.connected;
+    countersLock.unlock();
+
+    /* Handlers run on the channel strand, as it's the socket executor */
+    channel->socket.async_connect(
+        endpoint, [this, channel](sys::error_code ec) { onChannelConnectDone(channel, ec); });
+    return channel;
+}
+
+void
+TcpAsyncClient::enqueue(const Channel::Ptr& channel, const Session::Ptr& session)
+{
+    if (channel->failed) {
+        /* The channel failed after the request took it, so it's sent over a new one */
+        multiplex(session);
+        return;
+    }
+
+    const auto tag = RequestTag::encode(session->id);
+    const auto header = FrameCodec{kMaxFrame}.encode(tag.size() + session->request.size());
+    channel->pending.append(header.data(), header.size());
+    channel->pending.append(tag.data(), tag.size());
+    channel->pending.append(session->request);
+    channel->requests.insert(session->id);
+
+    if (channel->connected && channel->writing.empty()) {
+        flush(channel);
+    }
+}
+
+void
+TcpAsyncClient::flush(const Channel::Ptr& channel)
+{
+    assert(channel->writing.empty());
+    std::swap(channel->pending, channel->writing);
+    std::unique_lock lock{_idleGuard};
+    ++_counters.writes;
+    lock.unlock();
+
+    net::async_write(channel->socket,
+                     net::buffer(channel->writing),
+                     [this, channel](sys::error_code ec, std::size_t /*bytesWritten*/) {
+                         onChannelWriteDone(channel, ec);
+                     });
+}
+
+void
+TcpAsyncClient::onChannelConnectDone(const Channel::Ptr& channel, sys::error_code ec)
+{
+    if (ec) {
+        failChannel(channel, ec);
+        return;
+    }
+
+    channel->connected = true;
+    channel->socket.set_option(net::ip::tcp::no_delay{true}, ec);
+    readResponse(channel);
+    if (!channel->pending.empty()) {
+        flush(channel);
+    }
+}
+
+void
+TcpAsyncClient::onChannelWriteDone(const Channel::Ptr& channel, sys::error_code ec)
+{
+    if (ec) {
+        failChannel(channel, ec);
+        return;
+    }
+
+    channel->writing.clear();
+    if (!channel->pending.empty()) {
+        flush(channel);
+    }
+}
+
+void
+TcpAsyncClient::readResponse(const Channel::Ptr& channel)
+{
+    channel->frames.read(channel->socket,
+                         [this, channel](sys::error_code ec, BufferPool::Buffer response) {
+                             onResponseDone(channel, std::move(response), ec);
+                         });
+}
+
+void
+TcpAsyncClient::onResponseDone(const Channel::Ptr& channel,
+                               BufferPool::Buffer response,
+                               sys::error_code ec)
+{
+    if (ec) {
+        failChannel(channel, ec);
+        return;
+    }
+
+    const auto id = RequestTag::decode(response.view());
+    if (!id || channel->requests.erase(*id) == 0) {
+        /* The response doesn't belong to any request sent, the stream is out of sync */
+        failChannel(channel, sys::errc::make_error_code(sys::errc::bad_message));
+        return;
+    }
+
+    /* The session is gone if the request was cancelled */
+    if (auto session = takeSession(*id); session && session->callback) {
+        session->callback(*id, std::string{RequestTag::strip(response.view())}, ec);
+    }
+    readResponse(channel);
+}
+
+void
+TcpAsyncClient::failChannel(const Channel::Ptr& channel, sys::error_code ec)
+{
+    if (channel->failed) {
+        return;
+    }
+    channel->failed = true;
+    sys::error_code ignored;
+    channel->socket.shutdown(net::socket_base::shutdown_both, ignored);
+    channel->socket.close(ignored);
+
+    std::unique_lock lock{_channelsGuard};
+    if (auto it = _channels.find(channel->endpoint);
+        it != _channels.end() && it->second == channel) {
+        _channels.erase(it);
+    }
+    lock.unlock();
+
+    for (const auto id : channel->requests) {
+        if (auto session = takeSession(id); session && session->callback) {
+            session->callback(id, {}, ec);
+        }
+    }
+    channel->requests.clear();
+    channel->pending.clear();
+}
+
+TcpAsyncClient::Session::Ptr
+TcpAsyncClient::takeSession(RequestId id)
+{
+    std::lock_guard lock{_sessionsGuard};
+    auto it = _sessions.find(id);
+    if (it == _sessions.end()) {
+        return nullptr;
+    }
+    auto session = std::move(it->second);
+    _sessions.erase(it);
+    return session;
+}
+
 void
 TcpAsyncClient::onConnectDone(const Session::Ptr& session, sys::error_code ec)
 {
@@ -96,11 +465,17 @@ TcpAsyncClient::onConnectDone(const Session::Ptr& session, sys::error_code ec)
         return;
     }
 
-    net::async_write(session->socket,
-                     net::buffer(session->request),
-                     [this, session](sys::error_code ec, std::size_t bytesWritten) {
-                         onWriteDone(session, bytesWritten, ec);
-                     });
+    auto onWritten = [this, session](sys::error_code ec, std::size_t bytesWritten) {
+        onWriteDone(session, bytesWritten, ec);
+    };
+    if (session->frames) {
+        net::async_write(session->socket,
+                         std::array<net::const_buffer, 2>{net::buffer(session->header),
+                                                           net::buffer(session->request)},
+                         std::move(onWritten));
+    } else {
+        net::async_write(session->socket, net::buffer(session->request), std::move(onWritten));
+    }
 }
 
 void
@@ -119,6 +494,14 @@ TcpAsyncClient::onWriteDone(const Session::Ptr& session,
     }
 
     assert(session);
+    if (session->frames) {
+        session->frames->read(session->socket,
+                              [this, session](sys::error_code ec, BufferPool::Buffer response) {
+                                  onFrameDone(session, std::move(response), ec);
+                              });
+        return;
+    }
+
     net::async_read_until(session->socket,
                           session->responseBuffer,
                           '\n',
@@ -140,12 +523,44 @@ TcpAsyncClient::onReadDone(const Session::Ptr& session,
     onComplete(session, ec);
 }
 
+void
+TcpAsyncClient::onFrameDone(const Session::Ptr& session,
+                            BufferPool::Buffer response,
+                            sys::error_code ec)
+{
+    if (!ec) {
+        assert(session);
+        session->response = response.view();
+    }
+    onComplete(session, ec);
+}
+
 void
 TcpAsyncClient::onComplete(const Session::Ptr& session, sys::error_code ec)
 {
     assert(session);
-    session->socket.shutdown(net::socket_base::shutdown_both);
-    session->socket.close();
+    if (ec && session->reused && !session->cancel && isStale(ec)) {
+        /* The server closed the pooled connection meanwhile, the request wasn't handled */
+        session->reused = false;
+        sys::error_code ignored;
+        session->socket.close(ignored);
+        session->responseBuffer.consume(session->responseBuffer.size());
+        std::unique_lock lock{_idleGuard};
+        ++_counters.retried;
+        lock.unlock();
+        connect(session);
+        return;
+    }
+
+    /* Data left in the buffer means the connection is out of sync with the server */
+    if (!ec && !session->cancel && _poolOptions.maxIdle > 0
+        && session->responseBuffer.size() == 0) {
+        release(*session);
+    } else {
+        sys::error_code ignored;
+        session->socket.shutdown(net::socket_base::shutdown_both, ignored);
+        session->socket.close(ignored);
+    }
 
     std::unique_lock lock{_sessionsGuard};
     _sessions.erase(session->id);
@@ -159,6 +574,6 @@ TcpAsyncClient::onComplete(const Session::Ptr& session, sys::error_code ec)
 TcpAsyncClient::RequestId
 TcpAsyncClient::getRequestId()
 {
-    static RequestId id{0};
+    static std::atomic<RequestId> id{0};
     return ++id;
 }
\ No newline at end of file
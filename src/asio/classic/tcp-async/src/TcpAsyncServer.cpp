@@ -27,8 +27,10 @@ spawnContextThread(net::io_context& context)
 
 } // namespace
 
-TcpAsyncServer::TcpAsyncServer(net::io_context& context)
+TcpAsyncServer::TcpAsyncServer(net::io_context& context, Framing framing, bool multiplexed)
     : _context{context}
+    , _framing{framing}
+    , _multiplexed{multiplexed}
 {
 }
 
@@ -40,7 +42,7 @@ TcpAsyncServer::~TcpAsyncServer()
 void
 TcpAsyncServer::start(net::ip::port_type port, std::size_t threadsNum)
 {
-    _acceptor = std::make_unique<TcpAsyncAcceptor>(_context, port);
+    _acceptor = std::make_unique<TcpAsyncAcceptor>(_context, port, _framing, _multiplexed);
 
     assert(threadsNum > 0);
     while (threadsNum--) {
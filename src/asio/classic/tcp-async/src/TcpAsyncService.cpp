@@ -13,25 +13,29 @@
 // limitations under the License.
 
 #include "TcpAsyncService.h"
+#include "RequestTag.h"
 
+#include <array>
 #include <iostream>
 #include <tuple>
 
 namespace {
 
+/* The maximum size of request frame */
+constexpr std::size_t kMaxFrame{65535};
+
+/* The size of responses queued to multiplexed client pausing reading of its requests */
+constexpr std::size_t kPendingHighWatermark{256 * 1024};
+
 std::tuple<bool, std::string>
-getResponse(net::streambuf& input, std::size_t bytes)
+getResponse(std::string_view request)
 {
-    std::istream is{&input};
-    std::string request;
-    std::getline(is, request);
     if (request == "Ping") {
-        return std::make_tuple(true, "Pong\n");
+        return std::make_tuple(true, "Pong");
     }
     if (request == "Pong") {
-        return std::make_tuple(true, "Ping\n");
+        return std::make_tuple(true, "Ping");
     }
-    input.consume(bytes);
     return std::make_tuple(false, "");
 }
 
@@ -43,6 +47,15 @@ TcpAsyncService::TcpAsyncService(net::ip::tcp::socket&& socket)
 {
 }
 
+TcpAsyncService::TcpAsyncService(net::ip::tcp::socket&& socket,
+                                 std::shared_ptr<BufferPool> pool,
+                                 bool multiplexed)
+    : _socket{std::move(socket)}
+    , _frames{std::in_place, FrameCodec{kMaxFrame}, std::move(pool)}
+    , _multiplexed{multiplexed}
+{
+}
+
 void
 TcpAsyncService::handle()
 {
@@ -50,6 +63,30 @@ TcpAsyncService::handle()
     std::cout << "Local  :" << _socket.local_endpoint() << '\n';
     std::cout << "Remote :" << _socket.remote_endpoint() << '\n';
 
+    read();
+}
+
+void
+TcpAsyncService::read()
+{
+    if (_multiplexed) {
+        _frames->read(
+            _socket,
+            net::bind_executor(
+                _strand,
+                [self = shared_from_this()](sys::error_code ec, BufferPool::Buffer request) {
+                    self->onTaggedFrameDone(ec, std::move(request));
+                }));
+        return;
+    }
+    if (_frames) {
+        _frames->read(_socket,
+                      [self = shared_from_this()](sys::error_code ec, BufferPool::Buffer request) {
+                          self->onFrameDone(ec, std::move(request));
+                      });
+        return;
+    }
+
     net::async_read_until(_socket,
                           _buffer,
                           '\n',
@@ -68,18 +105,126 @@ TcpAsyncService::onReadDone(const sys::error_code& ec, std::size_t bytesRead)
             std::cerr << "onReadDone: " << ec.what() << std::endl;
         }
     } else {
-        const auto [ok, response] = getResponse(_buffer, bytesRead);
-        if (ok) {
-            net::async_write(
-                _socket,
-                net::buffer(response),
-                [self = shared_from_this()](sys::error_code ec, std::size_t bytesWritten) {
-                    self->onWriteDone(ec, bytesWritten);
-                });
+        std::istream is{&_buffer};
+        std::string request;
+        std::getline(is, request);
+        respond(request);
+    }
+}
+
+void
+TcpAsyncService::onFrameDone(const sys::error_code& ec, BufferPool::Buffer request)
+{
+    if (ec) {
+        if (ec == net::error::eof) {
+            std::cout << "onFrameDone: EoS" << std::endl;
+        } else {
+            std::cerr << "onFrameDone: " << ec.what() << std::endl;
+            _socket.close();
+        }
+    } else {
+        respond(request.view());
+    }
+}
+
+void
+TcpAsyncService::onTaggedFrameDone(const sys::error_code& ec, BufferPool::Buffer request)
+{
+    if (ec) {
+        if (ec == net::error::eof) {
+            std::cout << "onTaggedFrameDone: EoS" << std::endl;
         } else {
-            std::cout << "Invalid request string" << std::endl;
+            std::cerr << "onTaggedFrameDone: " << ec.what() << std::endl;
             _socket.close();
         }
+        return;
+    }
+
+    const auto id = RequestTag::decode(request.view());
+    auto [ok, response] = id ? getResponse(RequestTag::strip(request.view()))
+                             : std::make_tuple(false, std::string{});
+    if (!ok) {
+        std::cout << "Invalid request string" << std::endl;
+        _socket.close();
+        return;
+    }
+
+    const auto tag = RequestTag::encode(*id);
+    const auto header = _frames->codec().encode(tag.size() + response.size());
+    _pending.append(header.data(), header.size());
+    _pending.append(tag.data(), tag.size());
+    _pending.append(response);
+    if (_writing.empty()) {
+        flush();
+    }
+    if (_pending.size() >= kPendingHighWatermark) {
+        /* The client doesn't read responses as fast as it sends requests, reading resumes once
+           the write in flight completes */
+        _readPaused = true;
+        return;
+    }
+    /* The next request is read while the response is written */
+    read();
+}
+
+void
+TcpAsyncService::flush()
+{
+    std::swap(_pending, _writing);
+    net::async_write(_socket,
+                     net::buffer(_writing),
+                     net::bind_executor(_strand,
+                                        [self = shared_from_this()](sys::error_code ec,
+                                                                    std::size_t /*bytesWritten*/) {
+                                            self->onFlushDone(ec);
+                                        }));
+}
+
+void
+TcpAsyncService::onFlushDone(const sys::error_code& ec)
+{
+    if (ec) {
+        std::cerr << "onFlushDone: " << ec.what() << std::endl;
+        return;
+    }
+    _writing.clear();
+    if (!_pending.empty()) {
+        flush();
+    }
+    if (_readPaused && _pending.size() < kPendingHighWatermark) {
+        _readPaused = false;
+        read();
+    }
+}
+
+void
+TcpAsyncService::respond(std::string_view request)
+{
+    auto [ok, response] = getResponse(request);
+    if (!ok) {
+        std::cout << "Invalid request string" << std::endl;
+        _socket.close();
+        return;
+    }
+
+    /* The response is kept by the service until it's written */
+    _response = std::move(response);
+    if (_frames) {
+        _header = _frames->codec().encode(_response.size());
+        net::async_write(
+            _socket,
+            std::array<net::const_buffer, 2>{net::buffer(_header), net::buffer(_response)},
+            [self = shared_from_this()](sys::error_code ec, std::size_t bytesWritten) {
+                self->onWriteDone(ec, bytesWritten);
+            });
+    } else {
+        _response.push_back('\n');
+        net::async_write(
+            _socket,
+            net::buffer(_response),
+            [self = shared_from_this()](sys::error_code ec, std::size_t bytesWritten) {
+                self->onWriteDone(ec, bytesWritten);
+            });
     }
 }
 
@@ -92,5 +237,8 @@ TcpAsyncService::onWriteDone(const sys::error_code& ec, std::size_t /*bytesWritt
         } else {
             std::cerr << "onWriteDone: " << ec.what() << std::endl;
         }
+        return;
     }
+    /* The connection is kept for next requests until the client closes it */
+    read();
 }
@@ -19,13 +19,27 @@
 #include <boost/container/static_vector.hpp>
 
 #include <array>
-
-template<std::size_t Capacity>
+#include <span>
+
+/**
+ * Circular buffer over the fixed size storage
+ *
+ * The storage is either owned array (default) or the view of external memory
+ * (e.g. std::span<char, Capacity> over the slot of registered buffers).
+ */
+template<std::size_t Capacity, typename Storage = std::array<char, Capacity>>
 class CircularBuffer {
 public:
     using const_buffers_type = boost::container::static_vector<asio::const_buffer, 2>;
     using mutable_buffers_type = boost::container::static_vector<asio::mutable_buffer, 2>;
 
+    CircularBuffer() = default;
+
+    explicit CircularBuffer(Storage storage)
+        : _buffer{storage}
+    {
+    }
+
     auto
     prepare(std::size_t n)
     {
@@ -98,7 +112,7 @@ private:
     }
 
 private:
-    std::array<char, Capacity> _buffer;
+    Storage _buffer;
     std::size_t _h{0};
     std::size_t _t{0};
 };
\ No newline at end of file
@@ -16,10 +16,10 @@
 
 #include "CircularBuffer.hpp"
 
-template<std::size_t Capacity>
+template<std::size_t Capacity, typename Storage = std::array<char, Capacity>>
 class CircularBufferView {
 public:
-    using buffer_type = CircularBuffer<Capacity>;
+    using buffer_type = CircularBuffer<Capacity, Storage>;
     using const_buffers_type = typename buffer_type::const_buffers_type;
     using mutable_buffers_type = typename buffer_type::mutable_buffers_type;
 
@@ -74,9 +74,9 @@ private:
     buffer_type* _buffer;
 };
 
-template<std::size_t Capacity>
-CircularBufferView<Capacity>
-makeView(CircularBuffer<Capacity>& buffer)
+template<std::size_t Capacity, typename Storage>
+CircularBufferView<Capacity, Storage>
+makeView(CircularBuffer<Capacity, Storage>& buffer)
 {
-    return CircularBufferView<Capacity>{buffer};
+    return CircularBufferView<Capacity, Storage>{buffer};
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Non-blocking kernel pipe used as intermediate buffer of splice() data path
+ *
+ * Data moved through the pipe stays in kernel pages, the pipe only limits how much of it
+ * might be in flight between splicing in and splicing out.
+ */
+class Pipe {
+public:
+    /* Creates pipe and tries to resize it to requested capacity (keeps default on failure) */
+    explicit Pipe(std::size_t capacity);
+
+    ~Pipe();
+
+    Pipe(const Pipe&) = delete;
+    Pipe&
+    operator=(const Pipe&)
+        = delete;
+
+    [[nodiscard]] int
+    readEnd() const noexcept
+    {
+        return _fds[0];
+    }
+
+    [[nodiscard]] int
+    writeEnd() const noexcept
+    {
+        return _fds[1];
+    }
+
+    [[nodiscard]] std::size_t
+    capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+private:
+    int _fds[2]{-1, -1};
+    std::size_t _capacity{0};
+};
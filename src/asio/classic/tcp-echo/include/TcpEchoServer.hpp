@@ -15,19 +15,36 @@
 #pragma once
 
 #include "Common.hpp"
+#include "ReceiveRing.hpp"
 
+#include <memory>
 #include <optional>
 
 class TcpEchoServer {
 public:
-    TcpEchoServer(asio::io_context& context, std::uint16_t port);
+    enum class Mode {
+        /* Receive into user-space buffer and send from it */
+        Copy,
+        /* Move data through kernel pipe with splice() */
+        Splice
+    };
+
+    TcpEchoServer(asio::io_context& context, std::uint16_t port, Mode mode = Mode::Copy);
 
 private:
     void
     accept();
 
+    /* Starts session of the accepted socket, throws if its resources can't be created */
+    void
+    start(tcp::socket&& socket);
+
 private:
     asio::io_context& _context;
+    Mode _mode;
+    /* Registered receive buffers (io_uring backend only) */
+    std::shared_ptr<ReceiveRing> _ring;
     tcp::acceptor _acceptor;
     std::optional<tcp::socket> _socket;
+    asio::steady_timer _retry;
 };
\ No newline at end of file
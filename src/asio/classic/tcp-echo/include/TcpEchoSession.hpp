@@ -16,12 +16,15 @@
 
 #include "Common.hpp"
 #include "CircularBuffer.hpp"
+#include "ReceiveRing.hpp"
 
 #include <memory>
 
 class TcpEchoSession : public std::enable_shared_from_this<TcpEchoSession> {
 public:
-    explicit TcpEchoSession(tcp::socket&& socket);
+    static constexpr std::size_t kBufferSize{65536};
+
+    explicit TcpEchoSession(tcp::socket&& socket, ReceiveRing::Slot slot);
 
     void
     start();
@@ -44,6 +47,7 @@ private:
 
 private:
     bool _writing{false};
-    CircularBuffer<65536> _buffer;
+    ReceiveRing::Slot _slot;
+    CircularBuffer<kBufferSize, std::span<char, kBufferSize>> _buffer;
     tcp::socket _socket;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+#include "Pipe.hpp"
+
+#include <memory>
+
+/**
+ * Zero-copy echo session
+ *
+ * Incoming bytes are spliced from the socket into a pipe and from the pipe back into the
+ * socket, so data never reaches user-space buffers. Readiness of the socket is awaited
+ * through the io_context (async_wait), the transfers themselves are non-blocking splice()
+ * calls issued until they would block.
+ */
+class TcpSpliceSession : public std::enable_shared_from_this<TcpSpliceSession> {
+public:
+    static constexpr std::size_t kPipeSize{262144};
+
+    explicit TcpSpliceSession(tcp::socket&& socket);
+
+    void
+    start();
+
+private:
+    void
+    doClose();
+
+    void
+    doPump();
+
+    bool
+    spliceIn();
+
+    bool
+    spliceOut();
+
+    void
+    waitRead();
+
+    void
+    waitWrite();
+
+    void
+    onWait(bool& waiting, const sys::error_code& error);
+
+private:
+    bool _eof{false};
+    bool _closed{false};
+    bool _waitingRead{false};
+    bool _waitingWrite{false};
+    /* The number of bytes spliced into the pipe and not spliced out yet */
+    std::size_t _pending{0};
+    Pipe _pipe;
+    tcp::socket _socket;
+};
@@ -0,0 +1,273 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Common.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Request rate and syscalls per request of tcp-echo with epoll and io_uring backends
+ *
+ * Both server binaries (tcp-echo and tcp-echo-io-uring) run in turn as child processes. Every
+ * client connection sends a request of the given size and waits for its echo before sending
+ * the next one. Syscalls entered by the server are counted with the raw_syscalls:sys_enter
+ * tracepoint (requires tracefs and permission to trace the child, "-" is printed otherwise),
+ * CPU time of the server is reported by the kernel when it exits.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9092};
+    std::size_t connections{16};
+    std::size_t requestSize{128};
+    std::chrono::seconds duration{5};
+    std::string epollServer{TCP_ECHO_EPOLL_SERVER};
+    std::string ioUringServer{TCP_ECHO_IO_URING_SERVER};
+};
+
+/* Counts syscalls entered by the process, if the tracepoint is available */
+class SyscallCounter {
+public:
+    explicit SyscallCounter(pid_t pid)
+    {
+        const auto id = tracepointId();
+        if (!id) {
+            return;
+        }
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_TRACEPOINT;
+        attr.size = sizeof(attr);
+        attr.config = *id;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        _fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, pid, -1, -1, 0));
+    }
+
+    ~SyscallCounter()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+    void
+    start()
+    {
+        if (_fd >= 0) {
+            ::ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    [[nodiscard]] std::optional<std::uint64_t>
+    stop()
+    {
+        std::uint64_t count{0};
+        if (_fd < 0 || ::ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0) < 0
+            || ::read(_fd, &count, sizeof(count)) != sizeof(count)) {
+            return std::nullopt;
+        }
+        return count;
+    }
+
+private:
+    static std::optional<std::uint64_t>
+    tracepointId()
+    {
+        for (const auto* root : {"/sys/kernel/tracing", "/sys/kernel/debug/tracing"}) {
+            std::ifstream file{std::string{root} + "/events/raw_syscalls/sys_enter/id"};
+            std::uint64_t id{0};
+            if (file >> id) {
+                return id;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    int _fd{-1};
+};
+
+[[noreturn]] void
+runServer(const std::string& path, std::uint16_t port)
+{
+    std::freopen("/dev/null", "w", stdout);
+    std::freopen("/dev/null", "w", stderr);
+    const auto portArg = std::to_string(port);
+    ::execl(path.c_str(), path.c_str(), "--port", portArg.c_str(), nullptr);
+    std::_Exit(EXIT_FAILURE);
+}
+
+/* Sends requests and receives their echo until stopped, returns the number of requests */
+std::size_t
+runClient(const BenchOptions& options, std::latch& connected, const std::atomic<bool>& stop)
+{
+    asio::io_context context;
+    tcp::socket socket{context};
+    socket.connect(tcp::endpoint{asio::ip::address_v4::loopback(), options.port});
+    socket.set_option(tcp::no_delay{true});
+    connected.count_down();
+
+    std::string request(options.requestSize, 'x');
+    std::string response(options.requestSize, '\0');
+    std::size_t requests{0};
+    while (!stop) {
+        asio::write(socket, asio::buffer(request));
+        asio::read(socket, asio::buffer(response));
+        ++requests;
+    }
+    return requests;
+}
+
+bool
+runBenchmark(const BenchOptions& options, const char* backend, const std::string& path)
+{
+    if (::access(path.c_str(), X_OK) != 0) {
+        std::cerr << path << ": not executable" << std::endl;
+        return false;
+    }
+
+    /* Buffered output mustn't be inherited by the server */
+    std::fflush(stdout);
+    const pid_t server = ::fork();
+    if (server == 0) {
+        runServer(path, options.port);
+    }
+
+    const tcp::endpoint endpoint{asio::ip::address_v4::loopback(), options.port};
+    for (bool ready{false}; !ready;) {
+        asio::io_context context;
+        tcp::socket socket{context};
+        sys::error_code error;
+        socket.connect(endpoint, error);
+        ready = !error;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    SyscallCounter syscalls{server};
+    std::atomic<bool> stop{false};
+    std::latch connected{static_cast<std::ptrdiff_t>(options.connections)};
+    std::vector<std::size_t> requests(options.connections);
+    std::vector<std::jthread> clients;
+    for (std::size_t n{0}; n < options.connections; ++n) {
+        clients.emplace_back([&, n]() { requests[n] = runClient(options, connected, stop); });
+    }
+    connected.wait();
+
+    syscalls.start();
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(options.duration);
+    stop = true;
+    clients.clear();
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const auto syscallCount = syscalls.stop();
+
+    rusage usage{};
+    ::kill(server, SIGTERM);
+    ::wait4(server, nullptr, 0, &usage);
+    const auto cpu = std::chrono::seconds{usage.ru_utime.tv_sec + usage.ru_stime.tv_sec}
+                     + std::chrono::microseconds{usage.ru_utime.tv_usec + usage.ru_stime.tv_usec};
+
+    std::size_t total{0};
+    for (const auto count : requests) {
+        total += count;
+    }
+    total = std::max<std::size_t>(total, 1);
+    char perRequest[16]{"-"};
+    if (syscallCount) {
+        std::snprintf(perRequest, sizeof(perRequest), "%.2f", double(*syscallCount) / total);
+    }
+    const double perSecond = total / elapsed.count();
+    std::printf("%9s %12.0f %10.1f %14s %14.2f\n",
+                backend,
+                perSecond,
+                perSecond * options.requestSize / (1024 * 1024),
+                perRequest,
+                std::chrono::duration<double, std::micro>(cpu).count() / total);
+    return true;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t duration{5};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9092), "Set port")
+        ("connections,c", po::value<std::size_t>(&options.connections)->default_value(16), "Set number of connections")
+        ("size,s", po::value<std::size_t>(&options.requestSize)->default_value(128), "Set size of request")
+        ("duration,d", po::value<std::size_t>(&duration)->default_value(5), "Set duration of each run (seconds)")
+        ("epoll", po::value<std::string>(&options.epollServer)->default_value(TCP_ECHO_EPOLL_SERVER), "Set server with epoll backend")
+        ("io-uring", po::value<std::string>(&options.ioUringServer)->default_value(TCP_ECHO_IO_URING_SERVER), "Set server with io_uring backend")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.connections == 0 || options.requestSize == 0 || duration == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.duration = std::chrono::seconds{duration};
+
+    std::printf("%9s %12s %10s %14s %14s\n",
+                "backend",
+                "requests/s",
+                "MiB/s",
+                "syscalls/req",
+                "cpu us/req");
+    if (!runBenchmark(options, "epoll", options.epollServer)) {
+        return EXIT_FAILURE;
+    }
+    ++options.port;
+    if (!runBenchmark(options, "io_uring", options.ioUringServer)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
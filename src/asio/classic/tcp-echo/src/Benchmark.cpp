@@ -0,0 +1,143 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TcpEchoServer.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Loopback throughput benchmark of TCP echo server (copying vs splice() data path)
+ *
+ * Every client connection streams its share of data from one thread and receives the echo
+ * in another one. The server runs in a single thread, its CPU time divided by the amount
+ * of echoed data gives CPU cost per GB of each data path.
+ */
+
+namespace {
+
+struct BenchOptions {
+    std::uint16_t port{9091};
+    std::size_t connections{4};
+    std::size_t chunkSize{65536};
+    std::size_t megabytes{4096};
+};
+
+std::chrono::duration<double>
+threadCpuTime()
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+void
+runClient(const BenchOptions& options, std::size_t bytes)
+{
+    asio::io_context context;
+    tcp::socket socket{context};
+    socket.connect(tcp::endpoint{asio::ip::address_v4::loopback(), options.port});
+
+    std::jthread writer{[&] {
+        std::vector<char> chunk(options.chunkSize, 'x');
+        for (std::size_t sent{0}; sent < bytes;) {
+            sent += asio::write(
+                socket, asio::buffer(chunk, std::min(options.chunkSize, bytes - sent)));
+        }
+    }};
+
+    std::vector<char> chunk(options.chunkSize);
+    for (std::size_t received{0}; received < bytes;) {
+        received += socket.read_some(asio::buffer(chunk));
+    }
+}
+
+void
+runBenchmark(const BenchOptions& options, TcpEchoServer::Mode mode)
+{
+    asio::io_context context;
+    TcpEchoServer server{context, options.port, mode};
+
+    std::chrono::duration<double> cpuTime{};
+    std::jthread worker{[&] {
+        const auto start = threadCpuTime();
+        context.run();
+        cpuTime = threadCpuTime() - start;
+    }};
+
+    const std::size_t bytes = options.megabytes * 1024 * 1024 / options.connections;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (std::size_t n{0}; n < options.connections; ++n) {
+            clients.emplace_back(runClient, std::cref(options), bytes);
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    context.stop();
+    worker.join();
+
+    const double gigabytes = double(bytes * options.connections) / (1024 * 1024 * 1024);
+    std::printf("%7s %10.2f %12.3f %14.3f\n",
+                (mode == TcpEchoServer::Mode::Splice) ? "splice" : "copy",
+                gigabytes / elapsed.count(),
+                cpuTime.count() / gigabytes,
+                100.0 * cpuTime.count() / elapsed.count());
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9091), "Set port")
+        ("connections,c", po::value<std::size_t>(&options.connections)->default_value(4), "Set number of connections")
+        ("chunk,s", po::value<std::size_t>(&options.chunkSize)->default_value(65536), "Set size of client writes")
+        ("megabytes,m", po::value<std::size_t>(&options.megabytes)->default_value(4096), "Set amount of data per run")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.connections == 0 || options.chunkSize == 0 || options.megabytes == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%7s %10s %12s %14s\n", "mode", "GB/s", "cpu s/GB", "server cpu %");
+    runBenchmark(options, TcpEchoServer::Mode::Copy);
+    runBenchmark(options, TcpEchoServer::Mode::Splice);
+    return EXIT_SUCCESS;
+}
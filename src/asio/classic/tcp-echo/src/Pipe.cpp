@@ -0,0 +1,38 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pipe.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+Pipe::Pipe(std::size_t capacity)
+{
+    if (::pipe2(_fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+        throw boost::system::system_error{errno, boost::system::system_category(), "pipe2"};
+    }
+    /* The size is limited by /proc/sys/fs/pipe-max-size, so the default one is kept on error */
+    ::fcntl(_fds[1], F_SETPIPE_SZ, static_cast<int>(capacity));
+    if (const int size = ::fcntl(_fds[1], F_GETPIPE_SZ); size > 0) {
+        _capacity = static_cast<std::size_t>(size);
+    }
+}
+
+Pipe::~Pipe()
+{
+    ::close(_fds[0]);
+    ::close(_fds[1]);
+}
@@ -14,11 +14,46 @@
 
 #include "TcpEchoServer.hpp"
 
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+namespace po = boost::program_options;
+
+/**
+ * TCP echo server
+ *
+ * To run zero-copy mode (data is moved through kernel pipe with splice()):
+ *  $ tcp-echo --splice
+ */
+
 int
-main()
+main(int argc, char* argv[])
 {
+    std::uint16_t port{8080};
+    bool splice{false};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&port)->default_value(8080), "Set port")
+        ("splice", po::bool_switch(&splice), "Use zero-copy splice() data path")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
     asio::io_context context;
-    TcpEchoServer server{context, 8080};
+    TcpEchoServer server{
+        context, port, splice ? TcpEchoServer::Mode::Splice : TcpEchoServer::Mode::Copy};
     context.run();
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -15,11 +15,32 @@
 #include "TcpEchoServer.hpp"
 
 #include "TcpEchoSession.hpp"
+#include "TcpSpliceSession.hpp"
 
-TcpEchoServer::TcpEchoServer(asio::io_context& context, std::uint16_t port)
+#include <chrono>
+
+namespace {
+
+/* The number of sessions receiving into registered buffers */
+constexpr std::size_t kRingSlots{256};
+
+/* The delay of accepting after failure (e.g. out of descriptors, which fails again at once) */
+constexpr std::chrono::milliseconds kAcceptRetryDelay{100};
+
+} // namespace
+
+TcpEchoServer::TcpEchoServer(asio::io_context& context, std::uint16_t port, Mode mode)
     : _context{context}
+    , _mode{mode}
     , _acceptor{context, tcp::endpoint{tcp::v4(), port}}
+    , _retry{context}
 {
+#ifdef BOOST_ASIO_HAS_IO_URING
+    /* Only io_uring reads into registered buffers, splice() doesn't use user-space buffers */
+    if (_mode == Mode::Copy) {
+        _ring = std::make_shared<ReceiveRing>(context, kRingSlots, TcpEchoSession::kBufferSize);
+    }
+#endif
     accept();
 }
 
@@ -29,7 +50,38 @@ TcpEchoServer::accept()
     _socket.emplace(_context);
 
     _acceptor.async_accept(*_socket, [this](const sys::error_code& error) {
-        std::make_shared<TcpEchoSession>(std::move(*_socket))->start();
+        if (error == asio::error::operation_aborted) {
+            return;
+        }
+        if (error) {
+            // Failed accept doesn't stop the server, the next connections are accepted later
+            _retry.expires_after(kAcceptRetryDelay);
+            _retry.async_wait([this](const sys::error_code& error) {
+                if (!error) {
+                    accept();
+                }
+            });
+            return;
+        }
+
+        try {
+            start(std::move(*_socket));
+        } catch (const sys::system_error&) {
+            // Session resources are exhausted (e.g. pipe2() failed), drop the connection
+            sys::error_code ignored;
+            _socket->close(ignored);
+        }
         accept();
     });
 }
+
+void
+TcpEchoServer::start(tcp::socket&& socket)
+{
+    if (_mode == Mode::Splice) {
+        std::make_shared<TcpSpliceSession>(std::move(socket))->start();
+    } else {
+        auto slot = _ring ? _ring->acquire() : ReceiveRing::allocate(TcpEchoSession::kBufferSize);
+        std::make_shared<TcpEchoSession>(std::move(socket), std::move(slot))->start();
+    }
+}
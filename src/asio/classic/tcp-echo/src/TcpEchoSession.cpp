@@ -16,9 +16,12 @@
 
 #include "CircularBufferView.hpp"
 
-TcpEchoSession::TcpEchoSession(tcp::socket&& socket)
-    : _socket{std::move(socket)}
+TcpEchoSession::TcpEchoSession(tcp::socket&& socket, ReceiveRing::Slot slot)
+    : _slot{std::move(slot)}
+    , _buffer{std::span<char, kBufferSize>{_slot.data().data(), kBufferSize}}
+    , _socket{std::move(socket)}
 {
+    assert(_slot.data().size() >= kBufferSize);
 }
 
 void
@@ -38,11 +41,16 @@ TcpEchoSession::doClose()
 void
 TcpEchoSession::doRead()
 {
-    // Schedule asynchronous receiving of a data
-    asio::async_read(_socket,
-                     makeView(_buffer),
-                     asio::transfer_at_least(1),
-                     std::bind_front(&TcpEchoSession::onRead, shared_from_this()));
+    auto buffers = _buffer.prepare(_buffer.max_size() - _buffer.size());
+    if (buffers.size() == 1 && _slot.registered()) {
+        // Schedule asynchronous receiving of a data into registered (fixed) buffer
+        _socket.async_read_some(_slot.registered(buffers.front()),
+                                std::bind_front(&TcpEchoSession::onRead, shared_from_this()));
+    } else {
+        // Schedule asynchronous receiving of a data (free space might be looped)
+        _socket.async_read_some(buffers,
+                                std::bind_front(&TcpEchoSession::onRead, shared_from_this()));
+    }
 }
 
 void
@@ -52,6 +60,7 @@ TcpEchoSession::onRead(const sys::error_code& error, std::size_t bytesTransferre
         // Close if an error has occurred
         doClose();
     } else {
+        _buffer.commit(bytesTransferred);
         // Write data only if we aren't doing it already
         if (!_writing) {
             doWrite();
@@ -0,0 +1,158 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TcpSpliceSession.hpp"
+
+#include <fcntl.h>
+
+TcpSpliceSession::TcpSpliceSession(tcp::socket&& socket)
+    : _pipe{kPipeSize}
+    , _socket{std::move(socket)}
+{
+}
+
+void
+TcpSpliceSession::start()
+{
+    // splice() is issued directly, so the socket itself must not block
+    sys::error_code error;
+    _socket.non_blocking(true, error);
+    if (error) {
+        doClose();
+    } else {
+        doPump();
+    }
+}
+
+void
+TcpSpliceSession::doClose()
+{
+    _closed = true;
+    sys::error_code error;
+    _socket.close(error);
+}
+
+void
+TcpSpliceSession::doPump()
+{
+    // Move data in both directions until neither of them makes progress
+    bool progress{true};
+    while (progress && !_closed) {
+        progress = spliceIn();
+        progress = spliceOut() || progress;
+    }
+    if (_closed) {
+        return;
+    }
+
+    if (_eof && _pending == 0) {
+        // Everything received has been sent back
+        doClose();
+        return;
+    }
+    // Non-empty pipe is drained first: splicing in might block because the pipe is full,
+    // so waiting for readable socket would spin. Reading resumes once the pipe is empty.
+    if (_pending > 0) {
+        waitWrite();
+    } else if (!_eof) {
+        waitRead();
+    }
+}
+
+bool
+TcpSpliceSession::spliceIn()
+{
+    if (_eof || _pending >= _pipe.capacity()) {
+        return false;
+    }
+
+    const ssize_t n = ::splice(_socket.native_handle(),
+                               nullptr,
+                               _pipe.writeEnd(),
+                               nullptr,
+                               _pipe.capacity() - _pending,
+                               SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n > 0) {
+        _pending += n;
+        return true;
+    }
+    if (n == 0) {
+        // The peer has finished sending
+        _eof = true;
+        return true;
+    }
+    if (errno != EAGAIN && errno != EINTR) {
+        doClose();
+    }
+    return false;
+}
+
+bool
+TcpSpliceSession::spliceOut()
+{
+    if (_pending == 0) {
+        return false;
+    }
+
+    const ssize_t n = ::splice(_pipe.readEnd(),
+                               nullptr,
+                               _socket.native_handle(),
+                               nullptr,
+                               _pending,
+                               SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n > 0) {
+        _pending -= n;
+        return true;
+    }
+    if (n < 0 && errno != EAGAIN && errno != EINTR) {
+        doClose();
+    }
+    return false;
+}
+
+void
+TcpSpliceSession::waitRead()
+{
+    if (!_waitingRead) {
+        _waitingRead = true;
+        _socket.async_wait(tcp::socket::wait_read,
+                           [self = shared_from_this()](const sys::error_code& error) {
+                               self->onWait(self->_waitingRead, error);
+                           });
+    }
+}
+
+void
+TcpSpliceSession::waitWrite()
+{
+    if (!_waitingWrite) {
+        _waitingWrite = true;
+        _socket.async_wait(tcp::socket::wait_write,
+                           [self = shared_from_this()](const sys::error_code& error) {
+                               self->onWait(self->_waitingWrite, error);
+                           });
+    }
+}
+
+void
+TcpSpliceSession::onWait(bool& waiting, const sys::error_code& error)
+{
+    waiting = false;
+
+    if (error) {
+        doClose();
+    } else if (!_closed) {
+        doPump();
+    }
+}
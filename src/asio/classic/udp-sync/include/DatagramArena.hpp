@@ -0,0 +1,104 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Preallocated storage for a batch of datagrams used by recvmmsg/sendmmsg
+ *
+ * The payloads, I/O vectors, peer addresses, control messages and message headers are
+ * allocated once, so receiving and sending a batch never touches the heap.
+ *
+ * With UDP_GRO enabled on the socket one slot might hold several datagrams of the same size
+ * (the last one might be shorter). Such slot is sent back with UDP_SEGMENT of the same size,
+ * so the kernel splits it on the original datagram boundaries.
+ */
+class DatagramArena {
+public:
+    DatagramArena(std::size_t batchSize, std::size_t datagramSize);
+
+    DatagramArena(const DatagramArena&) = delete;
+
+    DatagramArena&
+    operator=(const DatagramArena&)
+        = delete;
+
+    /** Resets headers to receive up to batch size datagrams */
+    void
+    prepareReceive();
+
+    /** Turns the first count received slots into replies back to their senders */
+    void
+    prepareSend(std::size_t count);
+
+    /** Returns the number of datagrams in the received slot */
+    [[nodiscard]] std::size_t
+    datagrams(std::size_t index) const;
+
+    [[nodiscard]] mmsghdr*
+    headers();
+
+    [[nodiscard]] std::size_t
+    batchSize() const;
+
+    [[nodiscard]] std::size_t
+    datagramSize() const;
+
+private:
+    union Control {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        cmsghdr header;
+    };
+
+    [[nodiscard]] static std::uint16_t
+    segmentSize(const msghdr& header);
+
+private:
+    std::size_t _batchSize;
+    std::size_t _datagramSize;
+    std::vector<char> _payloads;
+    std::vector<iovec> _iovecs;
+    std::vector<sockaddr_storage> _addresses;
+    std::vector<Control> _controls;
+    std::vector<std::uint16_t> _segmentSizes;
+    std::vector<mmsghdr> _headers;
+};
+
+//
+// Inlines
+//
+
+inline mmsghdr*
+DatagramArena::headers()
+{
+    return _headers.data();
+}
+
+inline std::size_t
+DatagramArena::batchSize() const
+{
+    return _batchSize;
+}
+
+inline std::size_t
+DatagramArena::datagramSize() const
+{
+    return _datagramSize;
+}
@@ -0,0 +1,80 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class UdpEchoServer {
+public:
+    struct Options {
+        std::uint16_t port{8080};
+        /* The number of threads, each one owns a socket bound with SO_REUSEPORT */
+        std::size_t threads{1};
+        /* The number of datagrams per recvmmsg/sendmmsg call (1 - plain receive_from/send_to) */
+        std::size_t batchSize{1};
+        std::size_t datagramSize{65535};
+        /* Receive coalesced datagrams (UDP_GRO) and send them back segmented (UDP_SEGMENT) */
+        bool offload{false};
+    };
+
+    struct Stats {
+        std::uint64_t packets{0};
+        std::uint64_t bytes{0};
+        std::uint64_t recvCalls{0};
+        std::uint64_t sendCalls{0};
+        std::chrono::nanoseconds cpuTime{};
+    };
+
+    explicit UdpEchoServer(Options options);
+
+    ~UdpEchoServer();
+
+    void
+    start();
+
+    void
+    stop();
+
+    [[nodiscard]] Stats
+    stats() const;
+
+private:
+    struct alignas(64) Counters {
+        std::atomic<std::uint64_t> packets{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> recvCalls{0};
+        std::atomic<std::uint64_t> sendCalls{0};
+        std::atomic<std::int64_t> cpuTime{0};
+    };
+
+    void
+    runSimple(udp::socket& socket, Counters& counters);
+
+    void
+    runBatched(udp::socket& socket, Counters& counters);
+
+private:
+    Options _options;
+    asio::io_context _context;
+    std::atomic<bool> _stop{false};
+    std::vector<udp::socket> _sockets;
+    std::vector<Counters> _counters;
+    std::vector<std::jthread> _threads;
+};
@@ -0,0 +1,259 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "UdpEchoServer.hpp"
+#include "DatagramArena.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <netinet/udp.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <optional>
+
+namespace po = boost::program_options;
+
+/**
+ * Loopback packets-per-second benchmark of UDP echo server
+ *
+ * Every client thread sends a burst of datagrams and waits for their echoes (or timeout),
+ * so each client keeps at most one burst in flight and the server isn't flooded. In offload
+ * mode clients send bursts with UDP_SEGMENT and receive echoes with UDP_GRO as well.
+ */
+
+namespace {
+
+struct ClientStats {
+    std::uint64_t sent{0};
+    std::uint64_t received{0};
+};
+
+struct BenchOptions {
+    std::uint16_t port{9090};
+    std::size_t clients{4};
+    std::size_t batchSize{64};
+    std::size_t datagramSize{64};
+    std::chrono::seconds duration{5};
+};
+
+/* The maximum number of segments in one GSO send (UDP_MAX_SEGMENTS) */
+constexpr std::size_t kMaxSegments{64};
+constexpr std::size_t kMaxPayload{65507};
+
+using udp_gro = asio::detail::socket_option::boolean<SOL_UDP, UDP_GRO>;
+
+std::size_t
+burstSize(const BenchOptions& options, bool offload)
+{
+    if (not offload) {
+        return options.batchSize;
+    }
+    /* A GSO send is limited by the number of segments and by the size of IP packet */
+    return std::min({options.batchSize, kMaxSegments, kMaxPayload / options.datagramSize});
+}
+
+void
+runClient(const BenchOptions& options, bool offload, ClientStats& stats)
+{
+    asio::io_context context;
+    udp::socket socket{context, udp::endpoint{udp::v4(), 0}};
+    if (offload) {
+        socket.set_option(udp_gro{true});
+    }
+    socket.connect(udp::endpoint{asio::ip::address_v4::loopback(), options.port});
+
+    const int fd = socket.native_handle();
+    const timeval timeout{.tv_sec = 0, .tv_usec = 100'000};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const std::size_t burst = burstSize(options, offload);
+    std::vector<char> payload(burst * options.datagramSize, 'x');
+
+    /* The socket is connected, so outgoing datagrams don't need the peer address */
+    std::vector<iovec> iovecs(burst);
+    std::vector<mmsghdr> outgoing(burst);
+    for (std::size_t n{0}; n < burst; ++n) {
+        iovecs[n] = iovec{&payload[n * options.datagramSize], options.datagramSize};
+        outgoing[n].msg_hdr.msg_iov = &iovecs[n];
+        outgoing[n].msg_hdr.msg_iovlen = 1;
+    }
+
+    /* With offload the whole burst goes as one buffer which the kernel segments */
+    iovec gsoIovec{payload.data(), payload.size()};
+    union {
+        char buffer[CMSG_SPACE(sizeof(std::uint16_t))];
+        cmsghdr header;
+    } gsoControl{};
+    msghdr gsoHeader{};
+    gsoHeader.msg_iov = &gsoIovec;
+    gsoHeader.msg_iovlen = 1;
+    gsoHeader.msg_control = gsoControl.buffer;
+    gsoHeader.msg_controllen = sizeof(gsoControl.buffer);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&gsoHeader);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+    const auto segmentSize = static_cast<std::uint16_t>(options.datagramSize);
+    std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+
+    /* Coalesced datagrams take up to the maximum payload in one slot */
+    DatagramArena incoming{burst, offload ? kMaxPayload : options.datagramSize};
+
+    const auto deadline = std::chrono::steady_clock::now() + options.duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::size_t sent{0};
+        if (offload) {
+            if (::sendmsg(fd, &gsoHeader, 0) > 0) {
+                sent = burst;
+            }
+        } else if (const int rv = ::sendmmsg(fd, outgoing.data(), burst, 0); rv > 0) {
+            sent = rv;
+        }
+        if (sent == 0) {
+            continue;
+        }
+        stats.sent += sent;
+
+        std::size_t received{0};
+        while (received < sent) {
+            incoming.prepareReceive();
+            const int rv = ::recvmmsg(
+                fd, incoming.headers(), sent - received, MSG_WAITFORONE, nullptr);
+            if (rv <= 0) {
+                /* Timeout: the rest of the burst is considered lost */
+                break;
+            }
+            incoming.prepareSend(rv);
+            for (int n{0}; n < rv; ++n) {
+                received += incoming.datagrams(n);
+            }
+        }
+        stats.received += received;
+    }
+}
+
+void
+runBenchmark(const BenchOptions& options, const UdpEchoServer::Options& serverOptions)
+{
+    std::optional<UdpEchoServer> server;
+    try {
+        server.emplace(serverOptions);
+    } catch (const sys::system_error& e) {
+        std::printf("%7zu %7zu %7s  skipped: %s\n",
+                    serverOptions.threads,
+                    serverOptions.batchSize,
+                    serverOptions.offload ? "yes" : "no",
+                    e.what());
+        return;
+    }
+    server->start();
+
+    std::vector<ClientStats> stats(options.clients);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (auto& clientStats : stats) {
+            clients.emplace_back(
+                runClient, std::cref(options), serverOptions.offload, std::ref(clientStats));
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    server->stop();
+
+    ClientStats total;
+    for (const auto& clientStats : stats) {
+        total.sent += clientStats.sent;
+        total.received += clientStats.received;
+    }
+
+    const auto serverStats = server->stats();
+    const double packets = std::max<double>(serverStats.packets, 1);
+    std::printf("%7zu %7zu %7s %14.0f %10.3f %10.3f %12.1f %8.4f%%\n",
+                serverOptions.threads,
+                serverOptions.batchSize,
+                serverOptions.offload ? "yes" : "no",
+                total.received / elapsed.count(),
+                serverStats.recvCalls / packets,
+                serverStats.sendCalls / packets,
+                serverStats.cpuTime.count() / packets,
+                (total.sent == 0) ? 0.0 : 100.0 * (total.sent - total.received) / total.sent);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t threads{4};
+    std::size_t duration{5};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(9090), "Set port")
+        ("clients,c", po::value<std::size_t>(&options.clients)->default_value(4), "Set number of client threads")
+        ("threads,t", po::value<std::size_t>(&threads)->default_value(4), "Set number of server threads (batched mode)")
+        ("batch,b", po::value<std::size_t>(&options.batchSize)->default_value(64), "Set number of datagrams per syscall")
+        ("size,s", po::value<std::size_t>(&options.datagramSize)->default_value(64), "Set datagram size")
+        ("duration,d", po::value<std::size_t>(&duration)->default_value(5), "Set duration of each run in seconds")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.clients == 0 || threads == 0 || options.batchSize == 0
+        || options.datagramSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.duration = std::chrono::seconds{duration};
+
+    std::printf("%7s %7s %7s %14s %10s %10s %12s %9s\n",
+                "threads",
+                "batch",
+                "offload",
+                "pps",
+                "recv/pkt",
+                "send/pkt",
+                "cpu ns/pkt",
+                "loss");
+
+    /* Baseline: one blocking socket, one syscall per datagram in each direction */
+    runBenchmark(options, {.port = options.port, .threads = 1, .batchSize = 1});
+    /* Batched: one syscall per batch, one SO_REUSEPORT socket per thread */
+    runBenchmark(options, {.port = options.port, .threads = 1, .batchSize = options.batchSize});
+    runBenchmark(options,
+                 {.port = options.port, .threads = threads, .batchSize = options.batchSize});
+    /* Offload: one syscall and one trip through the stack per burst of equal datagrams */
+    runBenchmark(
+        options,
+        {.port = options.port, .threads = 1, .batchSize = options.batchSize, .offload = true});
+    runBenchmark(options,
+                 {.port = options.port,
+                  .threads = threads,
+                  .batchSize = options.batchSize,
+                  .offload = true});
+    return EXIT_SUCCESS;
+}
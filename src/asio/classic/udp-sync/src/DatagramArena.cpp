@@ -0,0 +1,110 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DatagramArena.hpp"
+
+#include <netinet/udp.h>
+
+#include <cassert>
+#include <cstring>
+
+DatagramArena::DatagramArena(std::size_t batchSize, std::size_t datagramSize)
+    : _batchSize{batchSize}
+    , _datagramSize{datagramSize}
+    , _payloads(batchSize * datagramSize)
+    , _iovecs(batchSize)
+    , _addresses(batchSize)
+    , _controls(batchSize)
+    , _segmentSizes(batchSize)
+    , _headers(batchSize)
+{
+    assert(batchSize > 0);
+    assert(datagramSize > 0);
+
+    for (std::size_t n{0}; n < _batchSize; ++n) {
+        _iovecs[n].iov_base = &_payloads[n * _datagramSize];
+        _headers[n].msg_hdr.msg_iov = &_iovecs[n];
+        _headers[n].msg_hdr.msg_iovlen = 1;
+        _headers[n].msg_hdr.msg_name = &_addresses[n];
+    }
+    prepareReceive();
+}
+
+void
+DatagramArena::prepareReceive()
+{
+    for (std::size_t n{0}; n < _batchSize; ++n) {
+        _iovecs[n].iov_len = _datagramSize;
+        _headers[n].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        _headers[n].msg_hdr.msg_control = _controls[n].buffer;
+        _headers[n].msg_hdr.msg_controllen = sizeof(Control::buffer);
+        _headers[n].msg_hdr.msg_flags = 0;
+        _headers[n].msg_len = 0;
+        _segmentSizes[n] = 0;
+    }
+}
+
+void
+DatagramArena::prepareSend(std::size_t count)
+{
+    assert(count <= _batchSize);
+    for (std::size_t n{0}; n < count; ++n) {
+        /* The peer address filled by recvmmsg becomes the destination */
+        auto& header = _headers[n].msg_hdr;
+        _iovecs[n].iov_len = _headers[n].msg_len;
+        _segmentSizes[n] = segmentSize(header);
+        header.msg_flags = 0;
+
+        if (_segmentSizes[n] == 0 || _segmentSizes[n] >= _headers[n].msg_len) {
+            /* Single datagram */
+            header.msg_controllen = 0;
+            continue;
+        }
+
+        /* Ask the kernel to split the reply on the same boundaries as it was received */
+        header.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+        std::memcpy(CMSG_DATA(cmsg), &_segmentSizes[n], sizeof(std::uint16_t));
+    }
+}
+
+std::size_t
+DatagramArena::datagrams(std::size_t index) const
+{
+    assert(index < _batchSize);
+    const std::size_t size = _headers[index].msg_len;
+    const std::size_t segment = _segmentSizes[index];
+    if (segment == 0 || segment >= size) {
+        return 1;
+    }
+    return (size + segment - 1) / segment;
+}
+
+std::uint16_t
+DatagramArena::segmentSize(const msghdr& header)
+{
+    /* The control message is available only if UDP_GRO is enabled on the socket */
+    for (auto* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&header), cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size;
+            std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+            return static_cast<std::uint16_t>(size);
+        }
+    }
+    return 0;
+}
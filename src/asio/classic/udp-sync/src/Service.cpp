@@ -12,9 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <boost/asio.hpp>
+#include "UdpEchoServer.hpp"
 
-namespace asio = boost::asio;
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+namespace po = boost::program_options;
 
 /**
  * Simple UDP echo server
@@ -23,23 +27,54 @@ namespace asio = boost::asio;
  *  $ nc -u localhost 8080 <Enter>
  *  Hi
  *  Hi
+ *
+ * To run high-rate mode (4 threads with own sockets, 64 datagrams per syscall):
+ *  $ asio-udp-sync --threads 4 --batch 64
+ *
+ * To let the kernel coalesce and segment datagrams (UDP_GRO/UDP_SEGMENT):
+ *  $ asio-udp-sync --threads 4 --batch 8 --offload
  */
 
 int
-main()
+main(int argc, char* argv[])
 {
-    std::uint16_t port{8080};
+    UdpEchoServer::Options options;
 
-    asio::io_context context;
-    asio::ip::udp::endpoint receiver{asio::ip::udp::v4(), port};
-    asio::ip::udp::socket socket{context, receiver};
-
-    char buffer[65535];
-    while (true) {
-        asio::ip::udp::endpoint sender;
-        const auto transferred = socket.receive_from(asio::buffer(buffer), sender);
-        socket.send_to(asio::buffer(buffer, transferred), sender);
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(8080), "Set port")
+        ("threads,t", po::value<std::size_t>(&options.threads)->default_value(1), "Set number of threads")
+        ("batch,b", po::value<std::size_t>(&options.batchSize)->default_value(1), "Set number of datagrams per syscall")
+        ("offload,o", po::bool_switch(&options.offload), "Use UDP_GRO/UDP_SEGMENT offload")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.threads == 0 || options.batchSize == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
     }
 
+    UdpEchoServer server{options};
+    server.start();
+
+    asio::io_context context;
+    asio::signal_set signals{context, SIGINT, SIGTERM};
+    signals.async_wait([&](const sys::error_code&, int) { server.stop(); });
+    context.run();
+
+    const auto stats = server.stats();
+    std::cout << "Echoed " << stats.packets << " datagrams (" << stats.bytes << " bytes) using "
+              << stats.recvCalls << " receive and " << stats.sendCalls << " send calls"
+              << std::endl;
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,177 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "UdpEchoServer.hpp"
+
+#include "DatagramArena.hpp"
+
+#include <netinet/udp.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace {
+
+using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+using udp_gro = asio::detail::socket_option::boolean<SOL_UDP, UDP_GRO>;
+
+std::chrono::nanoseconds
+threadCpuTime()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+} // namespace
+
+UdpEchoServer::UdpEchoServer(Options options)
+    : _options{options}
+    , _counters(options.threads)
+{
+    assert(_options.threads > 0);
+    assert(_options.batchSize > 0);
+    assert(_options.datagramSize > 0);
+
+    const udp::endpoint endpoint{udp::v4(), _options.port};
+    for (std::size_t n{0}; n < _options.threads; ++n) {
+        /* Kernel spreads incoming flows between the sockets bound to the same port */
+        auto& socket = _sockets.emplace_back(_context);
+        socket.open(endpoint.protocol());
+        socket.set_option(reuse_port{_options.threads > 1});
+        if (_options.offload) {
+            socket.set_option(udp_gro{true});
+        }
+        socket.bind(endpoint);
+    }
+}
+
+UdpEchoServer::~UdpEchoServer()
+{
+    stop();
+}
+
+void
+UdpEchoServer::start()
+{
+    assert(_threads.empty());
+    for (std::size_t n{0}; n < _options.threads; ++n) {
+        _threads.emplace_back([this, n]() {
+            if (_options.batchSize > 1 || _options.offload) {
+                runBatched(_sockets[n], _counters[n]);
+            } else {
+                runSimple(_sockets[n], _counters[n]);
+            }
+            _counters[n].cpuTime = threadCpuTime().count();
+        });
+    }
+}
+
+void
+UdpEchoServer::stop()
+{
+    _stop = true;
+    for (auto& socket : _sockets) {
+        /* Wake up the thread blocked on receiving (fails with ENOTCONN but still wakes) */
+        sys::error_code ec;
+        socket.shutdown(udp::socket::shutdown_receive, ec);
+    }
+    _threads.clear();
+}
+
+UdpEchoServer::Stats
+UdpEchoServer::stats() const
+{
+    Stats stats;
+    for (const auto& counters : _counters) {
+        stats.packets += counters.packets;
+        stats.bytes += counters.bytes;
+        stats.recvCalls += counters.recvCalls;
+        stats.sendCalls += counters.sendCalls;
+        stats.cpuTime += std::chrono::nanoseconds{counters.cpuTime};
+    }
+    return stats;
+}
+
+void
+UdpEchoServer::runSimple(udp::socket& socket, Counters& counters)
+{
+    std::vector<char> buffer(_options.datagramSize);
+    sys::error_code ec;
+    while (not _stop) {
+        udp::endpoint sender;
+        const auto transferred = socket.receive_from(asio::buffer(buffer), sender, 0, ec);
+        counters.recvCalls.fetch_add(1, std::memory_order_relaxed);
+        if (ec || _stop) {
+            continue;
+        }
+        socket.send_to(asio::buffer(buffer.data(), transferred), sender, 0, ec);
+        counters.sendCalls.fetch_add(1, std::memory_order_relaxed);
+        counters.packets.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(transferred, std::memory_order_relaxed);
+    }
+}
+
+void
+UdpEchoServer::runBatched(udp::socket& socket, Counters& counters)
+{
+    DatagramArena arena{_options.batchSize, _options.datagramSize};
+    const int fd = socket.native_handle();
+
+    while (not _stop) {
+        arena.prepareReceive();
+        /* Block until at least one datagram arrives, then take whatever is already queued */
+        const int received = ::recvmmsg(
+            fd, arena.headers(), static_cast<unsigned>(arena.batchSize()), MSG_WAITFORONE, nullptr);
+        counters.recvCalls.fetch_add(1, std::memory_order_relaxed);
+        if (_stop) {
+            break;
+        }
+        if (received <= 0) {
+            if (received < 0 && errno != EINTR && errno != EAGAIN) {
+                std::cerr << "recvmmsg: " << std::strerror(errno) << std::endl;
+                break;
+            }
+            continue;
+        }
+
+        arena.prepareSend(received);
+        std::uint64_t bytes{0};
+        std::uint64_t datagrams{0};
+        for (int n{0}; n < received; ++n) {
+            bytes += arena.headers()[n].msg_len;
+            datagrams += arena.datagrams(n);
+        }
+
+        /* The kernel might accept only a part of the batch */
+        int sent{0};
+        while (sent < received) {
+            const int rv = ::sendmmsg(fd, arena.headers() + sent, received - sent, 0);
+            counters.sendCalls.fetch_add(1, std::memory_order_relaxed);
+            if (rv < 0) {
+                if (errno != EINTR && errno != EAGAIN) {
+                    /* Skip the datagram which can't be sent (e.g. unreachable peer) */
+                    ++sent;
+                }
+                continue;
+            }
+            sent += rv;
+        }
+
+        counters.packets.fetch_add(datagrams, std::memory_order_relaxed);
+        counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
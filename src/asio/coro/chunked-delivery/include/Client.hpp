@@ -16,28 +16,82 @@
 
 #include "Http.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <optional>
 #include <string>
 #include <memory>
 
+/**
+ * Client of chunked uploads
+ *
+ * With zero step chunks grow from kInitialChunkSize (doubling) up to the current size of the
+ * socket send buffer, so large payloads take a few chunk framings and writes per buffer
+ * filled. CRC32C of uploaded data is sent in the trailer (not for files sent by sendfile, their
+ * content isn't read by the client).
+ */
 class Client : public std::enable_shared_from_this<Client> {
 public:
+    /* The size of the first chunk of adaptive sizing */
+    static constexpr std::size_t kInitialChunkSize{4 * 1024};
+
+    /* Called with the size of every chunk written and the time its write took */
+    using ChunkHandler = std::function<void(std::size_t size, std::chrono::nanoseconds elapsed)>;
+
     explicit Client(io::any_io_executor executor,
                     std::string host,
                     std::string port,
                     std::string data,
-                    std::size_t step = 5);
+                    std::size_t step = 0);
+
+    /* Logs every chunk written (on by default) */
+    void
+    verbose(bool enabled);
+
+    void
+    onChunk(ChunkHandler handler);
 
     void
     send();
 
+    /* Uploads file content instead of data, bodies of chunks are sent by sendfile (without
+       copying to user space) */
+    void
+    sendFile(std::filesystem::path path);
+
+    /* Returns the size of the chunk following the one of the previous size (zero if none) */
+    [[nodiscard]] static std::size_t
+    nextChunkSize(const tcp::socket& socket, std::size_t previous, std::size_t step);
+
 private:
     io::awaitable<void>
     doSend();
 
+    io::awaitable<void>
+    doSendFile(std::filesystem::path path);
+
+    /* Connects and sends request header (announcing checksum trailer if requested), returns
+       false unless the server accepts the body */
+    io::awaitable<bool>
+    begin(beast::tcp_stream& stream, beast::flat_buffer& buffer, bool checksum);
+
+    /* Sends the last chunk (with checksum trailer if given) and reads the response */
+    io::awaitable<void>
+    end(beast::tcp_stream& stream,
+        beast::flat_buffer& buffer,
+        std::optional<std::uint32_t> checksum);
+
+    /* Logs and reports chunk of the size written since the given time point */
+    void
+    written(std::size_t size, std::chrono::steady_clock::time_point start);
+
 private:
     std::string _host;
     std::string _port;
     std::string _data;
     std::size_t _step;
     io::any_io_executor _executor;
-};
+    bool _verbose{true};
+    ChunkHandler _chunkHandler;
+};
\ No newline at end of file
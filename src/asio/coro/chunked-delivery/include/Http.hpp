@@ -28,4 +28,7 @@ namespace http = beast::http;
 
 using tcp = boost::asio::ip::tcp;
 
-const int kHttpVersion11 = 11;
\ No newline at end of file
+const int kHttpVersion11 = 11;
+
+/* Trailer field with CRC32C of the body (8 hex digits) */
+const std::string_view kChecksumField{"X-Checksum-Crc32c"};
\ No newline at end of file
@@ -15,13 +15,71 @@
 #pragma once
 
 #include "Http.hpp"
+#include "BufferPool.hpp"
+#include "FileSink.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 
+/**
+ * Server of chunked uploads
+ *
+ * Connections persist (HTTP/1.1 keep-alive) unless the client asks to close them, requests
+ * pipelined by the client are handled and answered in order.
+ *
+ * Chunks read from a connection are queued to its consumer. Once the high watermark of them
+ * is queued, reading from the socket pauses until the consumer drains the queue down to the
+ * low watermark, so a slow consumer is absorbed in bursts instead of stalling every read.
+ * A request is answered once the consumer handled its body, with 500 if storing it failed.
+ */
 class Server : public std::enable_shared_from_this<Server> {
 public:
+    struct QueueOptions {
+        /* The number of chunks the channel holds (zero hands them over in lock-step) */
+        std::size_t capacity{8};
+        /* The number of queued chunks pausing reads (never if zero) */
+        std::size_t highWatermark{8};
+        /* The number of queued chunks resuming reads */
+        std::size_t lowWatermark{2};
+    };
+
+    struct Counters {
+        /* The number of chunks (and ends of bodies) queued to consumers now */
+        std::size_t queued{0};
+        /* The maximum number of them queued to a consumer */
+        std::size_t maxQueued{0};
+        /* The number of them handed over */
+        std::size_t handedOver{0};
+        /* The number of times reading from a socket paused at the high watermark */
+        std::size_t pauses{0};
+        /* The total time of these pauses */
+        std::chrono::nanoseconds paused{0};
+    };
+
     explicit Server(io::any_io_executor executor);
 
+    Server(io::any_io_executor executor, QueueOptions queue);
+
+    /* Writes uploads to files in the directory as they arrive instead of printing them (must
+       be called before listening), on a pool of blocking threads unless asio has file support */
+    void
+    storeUploads(std::filesystem::path directory, FileSink::Options options);
+
+    /* Logs every chunk read and handed over (on by default, must be called before listening) */
+    void
+    verbose(bool enabled);
+
+    /* Delays handling of every n-th chunk by consumers (simulates slow or stalling storage) */
+    void
+    delayConsumers(std::chrono::microseconds delay, std::size_t every = 1);
+
+    [[nodiscard]] Counters
+    counters() const;
+
     void
     listen(io::ip::port_type port);
 
@@ -29,9 +87,37 @@ public:
     listen(tcp::endpoint endpoint);
 
 private:
+    friend class Session;
+
     io::awaitable<void>
     listener(tcp::endpoint endpoint);
 
+    [[nodiscard]] std::filesystem::path
+    nextUploadPath();
+
+    /* Accounts chunk queued to consumer having the given number of them queued */
+    void
+    onQueued(std::size_t depth);
+
+    void
+    onDequeued();
+
+    void
+    onResumed(std::chrono::nanoseconds paused);
+
 private:
     io::any_io_executor _executor;
+    /* Chunk buffers shared by sessions */
+    std::shared_ptr<BufferPool> _pool;
+    std::filesystem::path _uploads;
+    FileSink::Options _sinkOptions;
+    /* Runs writes of uploads without asio file support, so they don't block sessions */
+    std::optional<io::thread_pool> _blocking;
+    std::atomic<std::size_t> _uploadsCount{0};
+    QueueOptions _queue;
+    std::chrono::microseconds _consumerDelay{0};
+    std::size_t _consumerDelayEvery{1};
+    bool _verbose{true};
+    mutable std::mutex _guard;
+    Counters _counters;
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * Drivers of the classic and the coroutine chunked-delivery implementations
+ *
+ * Every implementation is driven from a translation unit of its own, as their headers share
+ * names (and aliases), so the benchmark sees plain functions only.
+ */
+
+/* Called with the size of every chunk written and the time its write took */
+using ChunkHandler = std::function<void(std::size_t size, std::chrono::nanoseconds elapsed)>;
+
+/* Serves uploads by TcpServer (a thread per connection) without logging every chunk */
+[[noreturn]] void
+serveClassic(std::uint16_t port);
+
+/* Uploads payload by TcpClient in chunks of the given size (reported to the handler) */
+void
+uploadClassic(std::uint16_t port,
+              std::string_view payload,
+              std::size_t chunkSize,
+              const ChunkHandler& handler);
+
+/* Serves uploads by Server (on the given number of threads) without logging every chunk */
+[[noreturn]] void
+serveCoro(std::uint16_t port, std::size_t threads);
+
+/* Uploads payload by Client in chunks of the given size (reported to the handler) */
+void
+uploadCoro(std::uint16_t port,
+           std::string_view payload,
+           std::size_t chunkSize,
+           const ChunkHandler& handler);
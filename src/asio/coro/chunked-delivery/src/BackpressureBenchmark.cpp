@@ -0,0 +1,178 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Server.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace po = boost::program_options;
+
+/**
+ * Upload throughput against slow consumer by queue capacity and watermarks
+ *
+ * The server runs in this process (its log goes to /dev/null) and its consumers stall for the
+ * given delay on every n-th chunk, as storage flushing its cache would do. One client uploads
+ * the payload in chunks of the given size, the upload is stored to a temporary directory and
+ * is done once the consumer drained the queue.
+ */
+
+namespace {
+
+struct BenchOptions {
+    io::ip::port_type port{8091};
+    std::size_t payloadSize{256 * 1024 * 1024};
+    std::size_t chunkSize{64 * 1024};
+    std::chrono::microseconds delay{20000};
+    std::size_t every{64};
+};
+
+void
+upload(const BenchOptions& options)
+{
+    io::io_context context;
+    beast::tcp_stream stream{context};
+    /* The server starts listening asynchronously */
+    for (sys::error_code error{io::error::connection_refused}; error;) {
+        stream.socket().close();
+        stream.socket().connect(tcp::endpoint{io::ip::address_v4::loopback(), options.port},
+                                error);
+        if (error) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+
+    http::request<http::empty_body> req{http::verb::post, "/upload", kHttpVersion11};
+    req.set(http::field::host, "127.0.0.1");
+    req.set(http::field::transfer_encoding, "chunked");
+    req.keep_alive(false);
+    http::request_serializer<http::empty_body> serializer{req};
+    http::write_header(stream, serializer);
+
+    const std::string chunk(options.chunkSize, 'x');
+    for (std::size_t sent{0}; sent < options.payloadSize; sent += chunk.size()) {
+        io::write(stream, http::make_chunk(io::buffer(chunk)));
+    }
+    io::write(stream, http::make_chunk_last());
+
+    beast::flat_buffer buffer;
+    http::response<http::empty_body> res;
+    http::read(stream, buffer, res);
+}
+
+void
+runBenchmark(const BenchOptions& options, int output, Server::QueueOptions queue)
+{
+    io::thread_pool context{1};
+    auto server = std::make_shared<Server>(context.get_executor(), queue);
+    server->delayConsumers(options.delay, options.every);
+    const auto uploads = std::filesystem::temp_directory_path()
+                         / ("backpressure-bench-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(uploads);
+    server->storeUploads(uploads, FileSink::Options{});
+    server->listen(options.port);
+
+    const auto start = std::chrono::steady_clock::now();
+    upload(options);
+    while (server->counters().queued > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    const auto counters = server->counters();
+
+    context.stop();
+    context.join();
+    std::filesystem::remove_all(uploads);
+
+    const double paused = std::chrono::duration<double, std::milli>(counters.paused).count();
+    ::dprintf(output,
+              "%8zu %5zu %5zu %10.1f %10zu %8zu %10.1f\n",
+              queue.capacity,
+              queue.highWatermark,
+              queue.lowWatermark,
+              options.payloadSize / elapsed.count() / (1024 * 1024),
+              counters.maxQueued,
+              counters.pauses,
+              paused);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t delay{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<io::ip::port_type>(&options.port)->default_value(8091), "Set port")
+        ("size,s", po::value<std::size_t>(&options.payloadSize)->default_value(256 * 1024 * 1024), "Set payload size")
+        ("chunk,k", po::value<std::size_t>(&options.chunkSize)->default_value(64 * 1024), "Set chunk size")
+        ("delay,d", po::value<std::size_t>(&delay)->default_value(20000), "Set consumer stall (us)")
+        ("every,e", po::value<std::size_t>(&options.every)->default_value(64), "Set number of chunks per consumer stall")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.payloadSize == 0 || options.chunkSize == 0 || options.every == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.delay = std::chrono::microseconds{delay};
+
+    /* The server logs every chunk, keep the results only */
+    std::fflush(stdout);
+    const int output = ::dup(STDOUT_FILENO);
+    std::freopen("/dev/null", "w", stdout);
+    std::freopen("/dev/null", "w", stderr);
+
+    ::dprintf(output,
+              "%8s %5s %5s %10s %10s %8s %10s\n",
+              "capacity",
+              "high",
+              "low",
+              "MiB/s",
+              "max queued",
+              "pauses",
+              "paused ms");
+    for (const Server::QueueOptions queue : {Server::QueueOptions{0, 0, 0},
+                                             Server::QueueOptions{4, 0, 0},
+                                             Server::QueueOptions{4, 4, 1},
+                                             Server::QueueOptions{16, 16, 4},
+                                             Server::QueueOptions{64, 0, 0},
+                                             Server::QueueOptions{64, 64, 16}}) {
+        runBenchmark(options, output, queue);
+        ++options.port;
+    }
+    ::close(output);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Server.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Request rate of small uploads with and without persistent connections
+ *
+ * The server runs in a child process (its log goes to /dev/null). Every client thread uploads
+ * in one of the modes: a connection per upload ("close"), uploads one after another on one
+ * connection ("keep-alive"), or batches of uploads written at once before their responses are
+ * read ("pipeline").
+ */
+
+namespace {
+
+enum class Mode { Close, KeepAlive, Pipeline };
+
+struct BenchOptions {
+    io::ip::port_type port{8090};
+    std::size_t requests{20000};
+    std::size_t connections{8};
+    std::size_t payloadSize{1024};
+    std::size_t depth{16};
+};
+
+[[noreturn]] void
+runServer(const BenchOptions& options)
+{
+    std::freopen("/dev/null", "w", stdout);
+    std::freopen("/dev/null", "w", stderr);
+    io::thread_pool context{1};
+    auto server = std::make_shared<Server>(context.get_executor());
+    server->listen(options.port);
+    context.join();
+    std::_Exit(EXIT_SUCCESS);
+}
+
+/* Returns serialized upload of the payload as one chunk */
+std::string
+makeRequest(std::string_view payload, bool keepAlive)
+{
+    http::request<http::empty_body> req{http::verb::post, "/upload", kHttpVersion11};
+    req.set(http::field::host, "127.0.0.1");
+    req.set(http::field::transfer_encoding, "chunked");
+    req.keep_alive(keepAlive);
+
+    std::ostringstream os;
+    os << req.base();
+    os << std::hex << payload.size() << "\r\n" << payload << "\r\n0\r\n\r\n";
+    return os.str();
+}
+
+/* Writes the number of requests at once and reads their responses, returns the number of
+   successful ones */
+std::size_t
+exchange(beast::tcp_stream& stream,
+         beast::flat_buffer& buffer,
+         const std::string& request,
+         std::size_t count)
+{
+    std::string batch;
+    batch.reserve(request.size() * count);
+    for (std::size_t n{0}; n < count; ++n) {
+        batch += request;
+    }
+    io::write(stream.socket(), io::buffer(batch));
+
+    std::size_t succeeded{0};
+    for (std::size_t n{0}; n < count; ++n) {
+        http::response<http::empty_body> res;
+        http::read(stream, buffer, res);
+        if (res.result() == http::status::ok) {
+            ++succeeded;
+        }
+    }
+    return succeeded;
+}
+
+/* Uploads until the shared number of requests is taken, returns the number of failed ones */
+std::size_t
+runClient(const BenchOptions& options,
+          Mode mode,
+          const tcp::endpoint& endpoint,
+          std::atomic<std::size_t>& taken)
+{
+    const std::string payload(options.payloadSize, 'x');
+    const std::string request = makeRequest(payload, mode != Mode::Close);
+    const std::size_t batch = (mode == Mode::Pipeline) ? options.depth : 1;
+
+    io::io_context context;
+    std::optional<beast::tcp_stream> stream;
+    beast::flat_buffer buffer;
+    std::size_t failed{0};
+    for (;;) {
+        const std::size_t first = taken.fetch_add(batch);
+        if (first >= options.requests) {
+            break;
+        }
+        const std::size_t count = std::min(batch, options.requests - first);
+        try {
+            if (!stream) {
+                stream.emplace(context);
+                stream->connect(endpoint);
+                stream->socket().set_option(tcp::no_delay{true});
+                buffer.clear();
+            }
+            failed += count - exchange(*stream, buffer, request, count);
+        } catch (const sys::system_error&) {
+            failed += count;
+            stream.reset();
+        }
+        if (mode == Mode::Close) {
+            stream.reset();
+        }
+    }
+    return failed;
+}
+
+void
+runBenchmark(const BenchOptions& options, Mode mode)
+{
+    /* Buffered output mustn't be inherited by the server */
+    std::fflush(stdout);
+    const pid_t server = ::fork();
+    if (server == 0) {
+        runServer(options);
+    }
+
+    const tcp::endpoint endpoint{io::ip::address_v4::loopback(), options.port};
+    for (bool ready{false}; !ready;) {
+        io::io_context context;
+        tcp::socket socket{context};
+        sys::error_code error;
+        socket.connect(endpoint, error);
+        ready = !error;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    std::atomic<std::size_t> taken{0};
+    std::atomic<std::size_t> failed{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (std::size_t n{0}; n < options.connections; ++n) {
+            clients.emplace_back(
+                [&]() { failed += runClient(options, mode, endpoint, taken); });
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    ::kill(server, SIGKILL);
+    ::waitpid(server, nullptr, 0);
+
+    static const char* kModes[] = {"close", "keep-alive", "pipeline"};
+    std::printf("%10s %14.0f %8zu\n",
+                kModes[static_cast<int>(mode)],
+                options.requests / elapsed.count(),
+                failed.load());
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<io::ip::port_type>(&options.port)->default_value(8090), "Set port")
+        ("requests,n", po::value<std::size_t>(&options.requests)->default_value(20000), "Set number of uploads")
+        ("connections,c", po::value<std::size_t>(&options.connections)->default_value(8), "Set number of clients uploading at once")
+        ("size,s", po::value<std::size_t>(&options.payloadSize)->default_value(1024), "Set payload size")
+        ("depth,d", po::value<std::size_t>(&options.depth)->default_value(16), "Set number of pipelined uploads")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.requests == 0 || options.connections == 0 || options.payloadSize == 0
+        || options.depth == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%10s %14s %8s\n", "mode", "requests/s", "failed");
+    for (const Mode mode : {Mode::Close, Mode::KeepAlive, Mode::Pipeline}) {
+        runBenchmark(options, mode);
+        ++options.port;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "UploadDrivers.hpp"
+#include "TcpClient.hpp"
+#include "TcpServer.hpp"
+
+#include <string>
+
+void
+serveClassic(std::uint16_t port)
+{
+    net::io_context context;
+    TcpServer server{context};
+    server.verbose(false);
+    server.listen(port);
+}
+
+void
+uploadClassic(std::uint16_t port,
+              std::string_view payload,
+              std::size_t chunkSize,
+              const ChunkHandler& handler)
+{
+    net::io_context context;
+    TcpClient client{context};
+    client.verbose(false);
+    client.onChunk(handler);
+    client.send("127.0.0.1", std::to_string(port), payload, chunkSize);
+}
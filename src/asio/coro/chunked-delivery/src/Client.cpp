@@ -13,9 +13,32 @@
 // limitations under the License.
 
 #include "Client.hpp"
+#include "Crc32c.hpp"
 
 #include <fmt/format.h>
 
+#include <sys/sendfile.h>
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+
+/* Reports upload failed by an error thrown (e.g. by a write) */
+void
+onUploadDone(std::exception_ptr e)
+{
+    if (e) {
+        try {
+            std::rethrow_exception(e);
+        } catch (const std::exception& ex) {
+            fmt::print("Client: Upload error ({})\n", ex.what());
+        }
+    }
+}
+
+} // namespace
+
 Client::Client(io::any_io_executor executor,
                std::string host,
                std::string port,
@@ -29,35 +52,154 @@ Client::Client(io::any_io_executor executor,
 {
     assert(!_host.empty());
     assert(!_port.empty());
-    assert(!_data.empty());
-    assert(_step > 0);
-    assert(_data.size() > step);
+}
+
+void
+Client::verbose(bool enabled)
+{
+    _verbose = enabled;
+}
+
+void
+Client::onChunk(ChunkHandler handler)
+{
+    _chunkHandler = std::move(handler);
 }
 
 void
 Client::send()
 {
+    assert(!_data.empty());
     io::co_spawn(
-        _executor, [self = shared_from_this()]() { return self->doSend(); }, io::detached);
+        _executor, [self = shared_from_this()]() { return self->doSend(); }, onUploadDone);
+}
+
+void
+Client::sendFile(std::filesystem::path path)
+{
+    io::co_spawn(
+        _executor,
+        [self = shared_from_this(), path = std::move(path)]() {
+            return self->doSendFile(path);
+        },
+        onUploadDone);
+}
+
+std::size_t
+Client::nextChunkSize(const tcp::socket& socket, std::size_t previous, std::size_t step)
+{
+    if (step > 0) {
+        return step;
+    }
+    /* The kernel grows the send buffer while the connection is busy, so it's read every time */
+    io::socket_base::send_buffer_size sendBufferSize;
+    socket.get_option(sendBufferSize);
+    const auto limit
+        = std::max(static_cast<std::size_t>(sendBufferSize.value()), kInitialChunkSize);
+    return (previous == 0) ? kInitialChunkSize : std::min(previous * 2, limit);
 }
 
 io::awaitable<void>
 Client::doSend()
 {
-    auto executor = co_await io::this_coro::executor;
+    beast::tcp_stream stream(co_await io::this_coro::executor);
+    beast::flat_buffer buffer;
+    if (!co_await begin(stream, buffer, true)) {
+        co_return;
+    }
+
+    Crc32c checksum;
+    std::size_t pos = 0;
+    std::size_t size = 0;
+    while (pos < _data.size()) {
+        size = nextChunkSize(stream.socket(), size, _step);
+        const auto message = std::string_view{_data}.substr(pos, size);
+        checksum.update(message);
+        const auto start = std::chrono::steady_clock::now();
+        const auto chunk = http::make_chunk(io::buffer(message));
+        co_await io::async_write(stream.socket(), chunk, io::use_awaitable);
+        written(message.size(), start);
+        pos += size;
+    }
+
+    co_await end(stream, buffer, checksum.value());
+}
+
+io::awaitable<void>
+Client::doSendFile(std::filesystem::path path)
+{
+    sys::error_code ec;
+    beast::file file;
+    file.open(path.c_str(), beast::file_mode::scan, ec);
+    if (ec) {
+        fmt::print("Client: Open file error ({})\n", ec.message());
+        co_return;
+    }
+    const auto fileSize = static_cast<std::size_t>(file.size(ec));
+    if (ec) {
+        fmt::print("Client: File size error ({})\n", ec.message());
+        co_return;
+    }
 
-    tcp::resolver resolver(executor);
+    beast::tcp_stream stream(co_await io::this_coro::executor);
+    beast::flat_buffer buffer;
+    if (!co_await begin(stream, buffer, false)) {
+        co_return;
+    }
+
+    auto& socket = stream.socket();
+    /* sendfile fails with EAGAIN instead of blocking, then the socket is waited to be writable */
+    socket.native_non_blocking(true);
+    off_t offset = 0;
+    std::size_t size = 0;
+    while (static_cast<std::size_t>(offset) < fileSize) {
+        size = std::min(nextChunkSize(socket, size, _step), fileSize - offset);
+        const auto start = std::chrono::steady_clock::now();
+        co_await io::async_write(socket, http::chunk_header{size}, io::use_awaitable);
+        for (std::size_t remain = size; remain > 0;) {
+            const ssize_t sent
+                = ::sendfile(socket.native_handle(), file.native_handle(), &offset, remain);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    co_await socket.async_wait(tcp::socket::wait_write, io::use_awaitable);
+                } else if (errno != EINTR) {
+                    throw sys::system_error{errno, sys::system_category(), "sendfile"};
+                }
+                continue;
+            }
+            if (sent == 0) {
+                throw sys::system_error{io::error::eof, "sendfile"};
+            }
+            remain -= static_cast<std::size_t>(sent);
+        }
+        co_await io::async_write(socket, http::chunk_crlf{}, io::use_awaitable);
+        written(size, start);
+    }
+
+    co_await end(stream, buffer, std::nullopt);
+}
+
+io::awaitable<bool>
+Client::begin(beast::tcp_stream& stream, beast::flat_buffer& buffer, bool checksum)
+{
+    tcp::resolver resolver(co_await io::this_coro::executor);
     auto const results = co_await resolver.async_resolve(_host, _port, io::use_awaitable);
 
     fmt::print("Client: Connect to server\n");
-    beast::tcp_stream stream(executor);
     co_await stream.async_connect(results, io::use_awaitable);
+    /* The last chunk mustn't wait for the acknowledgement of the previous one (Nagle) */
+    stream.socket().set_option(tcp::no_delay{true});
 
     http::request<http::empty_body> req{http::verb::post, "/message", kHttpVersion11};
     req.set(http::field::host, _host);
     req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
     req.set(http::field::transfer_encoding, "chunked");
     req.set(http::field::expect, "100-continue");
+    if (checksum) {
+        req.set(http::field::trailer, kChecksumField);
+    }
+    /* One upload per connection */
+    req.keep_alive(false);
     {
         fmt::print("Client: Write initial request\n");
         http::request_serializer<http::empty_body, http::fields> reqSer{req};
@@ -65,26 +207,45 @@ Client::doSend()
     }
 
     fmt::print("Client: Read response to initial request\n");
-    beast::flat_buffer buffer;
     http::response<http::empty_body> res;
     co_await http::async_read(stream, buffer, res, io::use_awaitable);
     if (res.result() != http::status::continue_) {
         fmt::print("Client: 100 continue expected\n");
         stream.close();
-        co_return;
+        co_return false;
     }
+    co_return true;
+}
 
-    std::size_t pos = 0;
-    while (pos < _data.size()) {
-        const std::string message = _data.substr(pos, _step);
-        fmt::print("Client: Write chunk\n");
-        const auto chunk = http::make_chunk(io::buffer(message));
-        co_await io::async_write(stream.socket(), chunk, io::use_awaitable);
-        pos += _step;
-    }
+io::awaitable<void>
+Client::end(beast::tcp_stream& stream,
+            beast::flat_buffer& buffer,
+            std::optional<std::uint32_t> checksum)
+{
     fmt::print("Client: Write last chunk\n");
-    co_await io::async_write(stream.socket(), http::make_chunk_last(), io::use_awaitable);
+    http::fields trailer;
+    if (checksum) {
+        trailer.set(kChecksumField, Crc32c::toString(*checksum));
+    }
+    co_await io::async_write(
+        stream.socket(), http::make_chunk_last(trailer), io::use_awaitable);
+
+    fmt::print("Client: Read response\n");
+    http::response<http::empty_body> finalRes;
+    co_await http::async_read(stream, buffer, finalRes, io::use_awaitable);
+    fmt::print("Client: Upload {}\n", finalRes.result_int());
 
     fmt::print("Client: Close\n");
     stream.close();
+}
+
+void
+Client::written(std::size_t size, std::chrono::steady_clock::time_point start)
+{
+    if (_verbose) {
+        fmt::print("Client: Write chunk ({})\n", size);
+    }
+    if (_chunkHandler) {
+        _chunkHandler(size, std::chrono::steady_clock::now() - start);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "UploadDrivers.hpp"
+#include "Client.hpp"
+#include "Server.hpp"
+
+#include <string>
+
+void
+serveCoro(std::uint16_t port, std::size_t threads)
+{
+    io::thread_pool context{threads};
+    auto server = std::make_shared<Server>(context.get_executor());
+    server->verbose(false);
+    server->listen(port);
+    context.join();
+    std::_Exit(EXIT_SUCCESS);
+}
+
+void
+uploadCoro(std::uint16_t port,
+           std::string_view payload,
+           std::size_t chunkSize,
+           const ChunkHandler& handler)
+{
+    io::io_context context;
+    auto client = std::make_shared<Client>(
+        context.get_executor(), "127.0.0.1", std::to_string(port), std::string{payload}, chunkSize);
+    client->verbose(false);
+    client->onChunk(handler);
+    client->send();
+    context.run();
+}
@@ -13,28 +13,53 @@
 // limitations under the License.
 
 #include "Server.hpp"
+#include "AsyncFileSink.hpp"
+#include "Crc32c.hpp"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+namespace {
+
+/* The maximum size of chunk buffer (larger chunks are handed over in parts) */
+constexpr std::size_t kChunkBufferSize{64 * 1024};
+
+/* The number of threads writing uploads without asio file support */
+[[maybe_unused]] constexpr std::size_t kBlockingThreads{4};
+
+} // namespace
+
 class Session : public std::enable_shared_from_this<Session> {
 public:
-    using Channel = ioe::channel<void(sys::error_code, io::const_buffer)>;
+    /* Chunk buffers are moved through the channel, the consumer returns them to the pool */
+    using Channel = ioe::channel<void(sys::error_code, BufferPool::Buffer)>;
 
-    explicit Session(tcp::socket&& socket)
+    Session(tcp::socket&& socket, std::shared_ptr<Server> server)
         : _stream{std::move(socket)}
+        , _server{std::move(server)}
     {
     }
 
     void
     run()
     {
-        auto channel = std::make_shared<Channel>(io::make_strand(_stream.get_executor()));
+        auto channel = std::make_shared<Channel>(io::make_strand(_stream.get_executor()),
+                                                 _server->_queue.capacity);
+        _drained.emplace(channel->get_executor());
+        _consumed.emplace(channel->get_executor());
 
         io::co_spawn(
             channel->get_executor(),
             [self = shared_from_this(), channel]() {
-                fmt::print("Session: Spawn producer\n");
+                if (self->_server->_verbose) {
+                    fmt::print("Session: Spawn producer\n");
+                }
                 return self->producer(*channel);
             },
             io::detached);
@@ -42,101 +67,386 @@ public:
         io::co_spawn(
             channel->get_executor(),
             [self = shared_from_this(), channel]() {
-                fmt::print("Session: Spawn consumer\n");
+                if (self->_server->_verbose) {
+                    fmt::print("Session: Spawn consumer\n");
+                }
                 return self->consumer(*channel);
             },
             io::detached);
     }
 
 private:
+    /* Reads requests of the connection one by one (pipelined ones too, so they're handled and
+       answered in order) until the client or a failure closes it */
     io::awaitable<void>
     producer(Channel& channel)
     {
-        fmt::print(stderr, "Thread: {}\n", std::this_thread::get_id());
+        if (_server->_verbose) {
+            fmt::print(stderr, "Thread: {}\n", std::this_thread::get_id());
+        }
 
-        beast::flat_buffer buffer;
-        http::request_parser<http::empty_body> reqPar;
-        co_await http::async_read_header(_stream, buffer, reqPar, io::use_awaitable);
+        /* Responses to pipelined requests are small writes in a row, delaying them (Nagle) until
+           the client acknowledges would stall the pipeline */
+        _stream.socket().set_option(tcp::no_delay{true});
 
-        if (reqPar.get()[http::field::expect] == "100-continue") {
-            http::response<http::empty_body> res{http::status::continue_, kHttpVersion11};
-            res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
-            co_await http::async_write(_stream, res, io::use_awaitable);
-        } else {
-            fmt::print(stderr, "Server: 100 continue expected\n");
-            _stream.close();
-            co_return;
-        }
+        /* Both serve every request of the connection: bytes of pipelined requests read ahead
+           stay in the buffer, the parser is re-created in place */
+        beast::flat_buffer buffer;
+        /* Otherwise the buffer stays at the initial read size and the body is read in pieces of
+           512 bytes */
+        buffer.reserve(kChunkBufferSize);
+        std::optional<http::request_parser<http::empty_body>> reqPar;
 
-        std::string chunk;
+        /* The body is copied once, from the parser into a pooled buffer of the chunk size (up to
+           the limit), which is handed over as soon as it's full */
+        BufferPool::Buffer chunk;
+        std::size_t filled{0};
+        std::size_t copied{0};
+        /* The upload is verified as it arrives, so it's never read back */
+        Crc32c checksum;
         auto onHeader = [&](std::uint64_t size, std::string_view extensions, sys::error_code& ec) {
-            fmt::print(stderr, "Server: Header chunk ({})\n", size);
-            chunk.reserve(size);
-            chunk.clear();
+            if (_server->_verbose) {
+                fmt::print(stderr, "Server: Header chunk ({})\n", size);
+            }
         };
         auto onBody = [&](std::uint64_t remain, std::string_view body, sys::error_code& ec) {
-            fmt::print(stderr, "Server: Body chunk ({})\n", body.size());
-            if (remain == body.size()) {
+            if (_server->_verbose) {
+                fmt::print(stderr, "Server: Body chunk ({})\n", body.size());
+            }
+            if (chunk.size() == 0) {
+                chunk = _server->_pool->acquire(
+                    std::min<std::uint64_t>(remain, _server->_pool->maxSize()));
+                filled = 0;
+            }
+            const std::size_t size = std::min(body.size(), chunk.size() - filled);
+            std::memcpy(chunk.data() + filled, body.data(), size);
+            checksum.update(body.data(), size);
+            filled += size;
+            copied += size;
+            if (filled == chunk.size()) {
                 ec = http::error::end_of_chunk;
             }
-            chunk.append(body.data(), body.size());
-            return body.size();
+            return size;
         };
-        reqPar.on_chunk_header(onHeader);
-        reqPar.on_chunk_body(onBody);
 
-        sys::error_code ec;
-        while (!reqPar.is_done()) {
-            fmt::print(stderr, "Server: Read chunk\n");
-            co_await http::async_read(
-                _stream, buffer, reqPar, io::redirect_error(io::use_awaitable, ec));
-            if (not ec) {
-                continue;
-            } else {
-                if (ec != http::error::end_of_chunk) {
+        bool keepAlive{true};
+        while (keepAlive) {
+            reqPar.emplace();
+            if (!_server->_uploads.empty()) {
+                /* Stored upload doesn't occupy memory, so its size isn't limited */
+                reqPar->body_limit(boost::none);
+            }
+            reqPar->on_chunk_header(onHeader);
+            reqPar->on_chunk_body(onBody);
+
+            sys::error_code ec;
+            co_await http::async_read_header(
+                _stream, buffer, *reqPar, io::redirect_error(io::use_awaitable, ec));
+            if (ec) {
+                if (ec != http::error::end_of_stream) {
+                    fmt::print(stderr, "Error: {}\n", ec.message());
+                }
+                break;
+            }
+            keepAlive = reqPar->keep_alive();
+
+            if (reqPar->get()[http::field::expect] == "100-continue") {
+                http::response<http::empty_body> res{http::status::continue_, kHttpVersion11};
+                res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+                co_await http::async_write(
+                    _stream, res, io::redirect_error(io::use_awaitable, ec));
+                if (ec) {
                     fmt::print(stderr, "Error: {}\n", ec.message());
                     break;
+                }
+            }
+
+            copied = 0;
+            checksum = Crc32c{};
+            while (!reqPar->is_done()) {
+                if (_server->_verbose) {
+                    fmt::print(stderr, "Server: Read chunk\n");
+                }
+                co_await http::async_read(
+                    _stream, buffer, *reqPar, io::redirect_error(io::use_awaitable, ec));
+                if (not ec) {
+                    continue;
                 } else {
+                    if (ec != http::error::end_of_chunk) {
+                        fmt::print(stderr, "Error: {}\n", ec.message());
+                        break;
+                    } else {
+                        ec = {};
+                    }
+                }
+                if (_server->_verbose) {
                     fmt::print(stderr, "End of chunk\n");
-                    ec = {};
+                    fmt::print(stderr, "Received chunk ({})\n", chunk.size());
                 }
+                co_await handOver(channel, sys::error_code{}, std::move(chunk));
+            }
+            if (ec) {
+                /* The stream position is unknown, so the connection can't be used further */
+                break;
+            }
+            if (_server->_verbose) {
+                fmt::print(stderr, "Copied {} bytes\n", copied);
             }
-            fmt::print(stderr, "Received chunk: {}\n", chunk);
-            co_await channel.async_send(sys::error_code{}, io::buffer(chunk), io::use_awaitable);
-        }
 
-        co_await channel.async_send(http::error::end_of_stream, {}, io::use_awaitable);
+            /* Marks the end of the request body, which is answered once the consumer handled
+               (stored) it */
+            co_await handOver(channel, http::error::end_of_stream, BufferPool::Buffer{});
+            const bool stored = co_await consumed();
+
+            auto status = http::status::ok;
+            if (!verify(reqPar->get(), checksum)) {
+                status = http::status::bad_request;
+            } else if (!stored) {
+                status = http::status::internal_server_error;
+            }
+            http::response<http::empty_body> res{status, kHttpVersion11};
+            res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+            res.keep_alive(keepAlive);
+            res.prepare_payload();
+            co_await http::async_write(
+                _stream, res, io::redirect_error(io::use_awaitable, ec));
+            if (ec) {
+                fmt::print(stderr, "Error: {}\n", ec.message());
+                break;
+            }
+        }
         channel.close();
 
         _stream.close();
         co_return;
     }
 
+    /* Hands chunk (or the end of body) over to the consumer, then pauses (reading from the
+       socket) if the high watermark of them is queued until the low one is reached */
+    io::awaitable<void>
+    handOver(Channel& channel, sys::error_code ec, BufferPool::Buffer chunk)
+    {
+        _server->onQueued(++_queued);
+        co_await channel.async_send(ec, std::move(chunk), io::use_awaitable);
+
+        const auto highWatermark = _server->_queue.highWatermark;
+        if (highWatermark == 0 || _queued < highWatermark) {
+            co_return;
+        }
+        if (_server->_verbose) {
+            fmt::print(stderr, "Server: Pause reading ({} queued)\n", _queued);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        _paused = true;
+        _drained->expires_at(io::steady_timer::time_point::max());
+        sys::error_code ignored;
+        co_await _drained->async_wait(io::redirect_error(io::use_awaitable, ignored));
+        _paused = false;
+        _server->onResumed(std::chrono::steady_clock::now() - start);
+    }
+
+    /* Accounts chunk (or the end of body) received by the consumer */
+    void
+    onReceived()
+    {
+        --_queued;
+        _server->onDequeued();
+        if (_paused && _queued <= _server->_queue.lowWatermark) {
+            _drained->cancel();
+        }
+    }
+
+    /* Waits until the consumer handled the body handed over, returns false if it failed to
+       store it */
+    io::awaitable<bool>
+    consumed()
+    {
+        while (!_stored) {
+            _consumed->expires_at(io::steady_timer::time_point::max());
+            sys::error_code ignored;
+            co_await _consumed->async_wait(io::redirect_error(io::use_awaitable, ignored));
+        }
+        co_return *std::exchange(_stored, std::nullopt);
+    }
+
+    /* Accounts the body handled by the consumer, wakes the producer waiting to answer it */
+    void
+    onConsumed(bool stored)
+    {
+        _stored = stored;
+        _consumed->cancel();
+    }
+
+    /* Returns false if the checksum sent in the trailer doesn't match the body */
+    bool
+    verify(const http::request<http::empty_body>& request, const Crc32c& checksum)
+    {
+        const std::string_view expected = request[kChecksumField];
+        if (expected.empty()) {
+            return true;
+        }
+        if (Crc32c::fromString(expected) != checksum.value()) {
+            fmt::print(stderr,
+                       "Error: Checksum mismatch ({} expected, {} computed)\n",
+                       expected,
+                       Crc32c::toString(checksum.value()));
+            return false;
+        }
+        if (_server->_verbose) {
+            fmt::print(stderr, "Checksum verified ({})\n", expected);
+        }
+        return true;
+    }
+
     io::awaitable<void>
     consumer(Channel& channel)
     {
-        std::string chunks;
+        bool more{true};
+        while (more) {
+            more = co_await consume(channel);
+        }
+    }
+
+    /* Handles the body of one request, returns false once the producer closed the channel */
+    io::awaitable<bool>
+    consume(Channel& channel)
+    {
         sys::error_code ec;
-        while (channel.is_open()) {
-            auto buffer = co_await channel.async_receive(io::redirect_error(io::use_awaitable, ec));
-            if (ec) {
-                if (ec != http::error::end_of_stream) {
-                    fmt::print(stderr, "Error: {}\n", ec.message());
+        /* The chunk returns to the pool once handled (written if stored) */
+        auto chunk = co_await channel.async_receive(io::redirect_error(io::use_awaitable, ec));
+        if (ec == ioe::error::channel_closed) {
+            co_return false;
+        }
+        onReceived();
+
+        std::optional<AsyncFileSink> sink;
+        std::filesystem::path upload;
+        bool stored{true};
+        if (!_server->_uploads.empty()) {
+            upload = _server->nextUploadPath();
+            try {
+                auto executor = co_await io::this_coro::executor;
+                if (_server->_blocking) {
+                    sink.emplace(executor,
+                                 _server->_blocking->get_executor(),
+                                 upload,
+                                 _server->_sinkOptions);
+                } else {
+                    sink.emplace(executor, upload, _server->_sinkOptions);
                 }
-                break;
+            } catch (const sys::system_error& e) {
+                /* Chunks are still received (and dropped), so the producer isn't blocked */
+                fmt::print(stderr, "Error: {}\n", e.what());
+                stored = false;
+            }
+        }
+
+        io::steady_timer delay{co_await io::this_coro::executor};
+        std::size_t total{0};
+        while (!ec) {
+            total += chunk.size();
+            if (_server->_consumerDelay.count() > 0
+                && ++_handled % _server->_consumerDelayEvery == 0) {
+                delay.expires_after(_server->_consumerDelay);
+                co_await delay.async_wait(io::use_awaitable);
+            }
+            if (sink) {
+                co_await sink->write(std::move(chunk));
+            } else if (upload.empty() && _server->_verbose) {
+                fmt::print(stderr, "Chunk: {}\n", chunk.view());
+            }
+            chunk = co_await channel.async_receive(io::redirect_error(io::use_awaitable, ec));
+            if (ec != ioe::error::channel_closed) {
+                onReceived();
+            }
+        }
+        /* Otherwise the producer failed in the middle of the body */
+        const bool complete = (ec == http::error::end_of_stream);
+        if (!complete) {
+            fmt::print(stderr, "Error: Incomplete upload ({})\n", ec.message());
+        }
+        if (_server->_verbose) {
+            fmt::print(stderr, "Chunks: {} bytes\n", total);
+        }
+
+        if (sink) {
+            try {
+                co_await sink->close();
+                if (_server->_verbose) {
+                    fmt::print(
+                        stderr, "Stored {} bytes to {}\n", sink->size(), upload.string());
+                }
+            } catch (const sys::system_error& e) {
+                fmt::print(stderr, "Error: {}\n", e.what());
+                stored = false;
             }
-            chunks.append(static_cast<const char*>(buffer.data()), buffer.size());
         }
-        fmt::print(stderr, "Chunks: {}\n", chunks);
+        if (complete) {
+            /* Otherwise the producer doesn't wait for it */
+            onConsumed(stored);
+        }
+        co_return complete;
     }
 
 private:
     beast::tcp_stream _stream;
+    std::shared_ptr<Server> _server;
+    /* Wakes the producer paused at the high watermark */
+    std::optional<io::steady_timer> _drained;
+    /* The number of chunks (and ends of bodies) sent but not received yet */
+    std::size_t _queued{0};
+    bool _paused{false};
+    /* Wakes the producer waiting for the consumer to handle the body */
+    std::optional<io::steady_timer> _consumed;
+    /* Whether the body handled by the consumer was stored (until the producer answers it) */
+    std::optional<bool> _stored;
+    /* The number of chunks handled by the consumer */
+    std::size_t _handled{0};
 };
 
 Server::Server(io::any_io_executor executor)
+    : Server{std::move(executor), QueueOptions{}}
+{
+}
+
+Server::Server(io::any_io_executor executor, QueueOptions queue)
     : _executor{std::move(executor)}
+    , _pool{BufferPool::create(kChunkBufferSize)}
+    , _queue{queue}
+{
+    assert(_queue.highWatermark == 0 || _queue.lowWatermark < _queue.highWatermark);
+}
+
+void
+Server::verbose(bool enabled)
+{
+    _verbose = enabled;
+}
+
+void
+Server::delayConsumers(std::chrono::microseconds delay, std::size_t every)
+{
+    assert(every > 0);
+    _consumerDelay = delay;
+    _consumerDelayEvery = every;
+}
+
+Server::Counters
+Server::counters() const
+{
+    std::lock_guard lock{_guard};
+    return _counters;
+}
+
+void
+Server::storeUploads(std::filesystem::path directory, FileSink::Options options)
 {
+    std::filesystem::create_directories(directory);
+    _uploads = std::move(directory);
+    _sinkOptions = options;
+#if !defined(BOOST_ASIO_HAS_FILE)
+    _blocking.emplace(kBlockingThreads);
+#endif
 }
 
 void
@@ -158,6 +468,36 @@ Server::listener(tcp::endpoint endpoint)
     tcp::acceptor acceptor{co_await io::this_coro::executor, endpoint};
     for (;;) {
         tcp::socket socket = co_await acceptor.async_accept(io::use_awaitable);
-        std::make_shared<Session>(std::move(socket))->run();
+        std::make_shared<Session>(std::move(socket), shared_from_this())->run();
     }
 }
+
+std::filesystem::path
+Server::nextUploadPath()
+{
+    return _uploads / ("upload-" + std::to_string(++_uploadsCount) + ".bin");
+}
+
+void
+Server::onQueued(std::size_t depth)
+{
+    std::lock_guard lock{_guard};
+    ++_counters.queued;
+    ++_counters.handedOver;
+    _counters.maxQueued = std::max(_counters.maxQueued, depth);
+}
+
+void
+Server::onDequeued()
+{
+    std::lock_guard lock{_guard};
+    --_counters.queued;
+}
+
+void
+Server::onResumed(std::chrono::nanoseconds paused)
+{
+    std::lock_guard lock{_guard};
+    ++_counters.pauses;
+    _counters.paused += paused;
+}
@@ -0,0 +1,223 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Server.hpp"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+std::string
+pattern(std::size_t size)
+{
+    std::string data(size, '\0');
+    for (std::size_t n{0}; n < size; ++n) {
+        data[n] = static_cast<char>('a' + n % 26);
+    }
+    return data;
+}
+
+/* Encodes body as chunks of the given size */
+std::string
+chunked(std::string_view body, std::size_t size)
+{
+    std::string encoded;
+    while (!body.empty()) {
+        const auto part = body.substr(0, size);
+        encoded += fmt::format("{:x}\r\n{}\r\n", part.size(), part);
+        body.remove_prefix(part.size());
+    }
+    return encoded + "0\r\n\r\n";
+}
+
+std::string
+request(std::string_view body, std::size_t chunkSize = 1000)
+{
+    return "POST /message HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n"
+           + chunked(body, chunkSize);
+}
+
+std::string
+readFile(const std::filesystem::path& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+} // namespace
+
+/**
+ * Harness of a server running on its own thread and a blocking loopback client
+ */
+class ServerTest : public Test {
+public:
+    ServerTest()
+        : uploads{std::filesystem::temp_directory_path()
+                  / ("coro-chunked-test-" + std::to_string(::getpid()))}
+    {
+    }
+
+    ~ServerTest() override
+    {
+        _context.stop();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+        std::filesystem::remove_all(uploads);
+    }
+
+    /* Starts server set up by the given function */
+    void
+    start(Server::QueueOptions queue = {}, std::function<void(Server&)> setup = {})
+    {
+        _server = std::make_shared<Server>(_context.get_executor(), queue);
+        _server->verbose(false);
+        if (setup) {
+            setup(*_server);
+        }
+        /* The port of the endpoint bound here is free once it's closed */
+        tcp::endpoint endpoint;
+        {
+            tcp::acceptor acceptor{_context, tcp::endpoint{io::ip::address_v4::loopback(), 0}};
+            endpoint = acceptor.local_endpoint();
+        }
+        _server->listen(endpoint);
+        _thread = std::thread{[this]() { _context.run(); }};
+
+        for (int attempt{0}; attempt < 100; ++attempt) {
+            sys::error_code error;
+            _client.close();
+            _client.connect(endpoint, error);
+            if (!error) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        FAIL() << "Server isn't listening";
+    }
+
+    void
+    send(std::string_view data)
+    {
+        io::write(_client, io::buffer(data));
+    }
+
+    http::response<http::empty_body>
+    receive()
+    {
+        http::response<http::empty_body> response;
+        http::read(_client, _buffer, response);
+        return response;
+    }
+
+    Server&
+    server()
+    {
+        return *_server;
+    }
+
+protected:
+    std::filesystem::path uploads;
+
+private:
+    io::io_context _context;
+    std::shared_ptr<Server> _server;
+    std::thread _thread;
+    io::io_context _clientContext;
+    tcp::socket _client{_clientContext};
+    beast::flat_buffer _buffer;
+};
+
+TEST_F(ServerTest, AnswersPipelinedRequestsInOrder)
+{
+    start();
+    send(request("first") + request(pattern(100000)) + request("third"));
+
+    for (int n{0}; n < 3; ++n) {
+        const auto response = receive();
+        EXPECT_EQ(response.result(), http::status::ok);
+        EXPECT_TRUE(response.keep_alive());
+    }
+    EXPECT_EQ(server().counters().queued, 0);
+}
+
+TEST_F(ServerTest, AnswersContinueBeforeBody)
+{
+    start();
+    send("POST /message HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n"
+         "Expect: 100-continue\r\n\r\n");
+    EXPECT_EQ(receive().result(), http::status::continue_);
+
+    send(chunked("body", 2));
+    EXPECT_EQ(receive().result(), http::status::ok);
+}
+
+TEST_F(ServerTest, RejectsChecksumMismatch)
+{
+    start();
+    send("POST /message HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n"
+         "Trailer: X-Checksum-Crc32c\r\n\r\n4\r\nbody\r\n0\r\nX-Checksum-Crc32c: 00000000\r\n\r\n");
+    EXPECT_EQ(receive().result(), http::status::bad_request);
+}
+
+TEST_F(ServerTest, StoresUploads)
+{
+    start({}, [this](Server& server) { server.storeUploads(uploads, FileSink::Options{}); });
+    const auto first = pattern(300000);
+    const auto second = pattern(1000);
+    send(request(first, 70000) + request(second));
+
+    EXPECT_EQ(receive().result(), http::status::ok);
+    EXPECT_EQ(receive().result(), http::status::ok);
+    /* Answered once stored */
+    EXPECT_EQ(readFile(uploads / "upload-1.bin"), first);
+    EXPECT_EQ(readFile(uploads / "upload-2.bin"), second);
+}
+
+TEST_F(ServerTest, AnswersServerErrorIfUploadIsntStored)
+{
+    start({}, [this](Server& server) { server.storeUploads(uploads, FileSink::Options{}); });
+    std::filesystem::create_directories(uploads / "upload-1.bin");
+    send(request("lost") + request("stored"));
+
+    EXPECT_EQ(receive().result(), http::status::internal_server_error);
+    EXPECT_EQ(receive().result(), http::status::ok);
+    EXPECT_EQ(readFile(uploads / "upload-2.bin"), "stored");
+}
+
+TEST_F(ServerTest, PausesReadingAtHighWatermark)
+{
+    start(Server::QueueOptions{.capacity = 4, .highWatermark = 4, .lowWatermark = 1},
+          [](Server& server) { server.delayConsumers(std::chrono::microseconds{1000}); });
+    send(request(pattern(64 * 1024), 1024));
+
+    EXPECT_EQ(receive().result(), http::status::ok);
+    const auto counters = server().counters();
+    EXPECT_GT(counters.pauses, 0);
+    EXPECT_LE(counters.maxQueued, 4);
+    EXPECT_EQ(counters.queued, 0);
+}
@@ -32,6 +32,12 @@ main(int argc, char* argv[])
     std::string host;
     std::string port;
     std::string data;
+    std::string file;
+    std::size_t step{0};
+    std::string uploads;
+    FileSink::Options options;
+    Server::QueueOptions queue;
+    bool quiet{false};
 
     po::options_description desc("Allowed options");
     // clang-format off
@@ -41,6 +47,14 @@ main(int argc, char* argv[])
         ("host,h", po::value<std::string>(&host)->default_value(DefaultHost), "Set host")
         ("port,p", po::value<std::string>(&port)->default_value(DefaultPort), "Set port")
         ("data,d", po::value<std::string>(&data), "Set data")
+        ("file,f", po::value<std::string>(&file), "Set file to upload (instead of data)")
+        ("step", po::value<std::size_t>(&step)->default_value(0), "Set chunk size (adaptive if zero)")
+        ("uploads,u", po::value<std::string>(&uploads), "Set directory to store uploads to (printed if empty)")
+        ("direct", po::bool_switch(&options.direct), "Store uploads bypassing page cache (O_DIRECT)")
+        ("queue", po::value<std::size_t>(&queue.capacity)->default_value(queue.capacity), "Set number of chunks queued per connection")
+        ("high-watermark", po::value<std::size_t>(&queue.highWatermark)->default_value(queue.highWatermark), "Set number of queued chunks pausing reads (never if zero)")
+        ("low-watermark", po::value<std::size_t>(&queue.lowWatermark)->default_value(queue.lowWatermark), "Set number of queued chunks resuming reads")
+        ("quiet,q", po::bool_switch(&quiet), "Don't log every chunk")
         ;
     // clang-format on
 
@@ -48,17 +62,29 @@ main(int argc, char* argv[])
     po::store(po::parse_command_line(argc, argv, desc), vm);
     po::notify(vm);
 
-    if (!runClient && !runServer) {
+    if ((!runClient && !runServer) || (runClient && data.empty() && file.empty())) {
+        return EXIT_FAILURE;
+    }
+    if (queue.highWatermark > 0 && queue.lowWatermark >= queue.highWatermark) {
         return EXIT_FAILURE;
     }
 
     io::thread_pool context{2};
     if (runClient) {
-        auto client = std::make_shared<Client>(context.get_executor(), host, port, data);
-        client->send();
+        auto client = std::make_shared<Client>(context.get_executor(), host, port, data, step);
+        client->verbose(!quiet);
+        if (file.empty()) {
+            client->send();
+        } else {
+            client->sendFile(file);
+        }
     }
     if (runServer) {
-        auto server = std::make_shared<Server>(context.get_executor());
+        auto server = std::make_shared<Server>(context.get_executor(), queue);
+        server->verbose(!quiet);
+        if (!uploads.empty()) {
+            server->storeUploads(uploads, options);
+        }
         server->listen(8080);
     }
     context.join();
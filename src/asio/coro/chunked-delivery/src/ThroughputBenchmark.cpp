@@ -0,0 +1,258 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "UploadDrivers.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Upload throughput and per-chunk latency of the classic and the coroutine implementations
+ *
+ * For every implementation, chunk size and payload size the server runs in a child process
+ * (its CPU time and peak memory are taken once it's killed) and the clients upload the payload
+ * concurrently until the total size is uploaded. Latency of a chunk is the time its write by
+ * the client took, so it grows once the server doesn't keep up. Logging of every chunk is off
+ * on both sides.
+ */
+
+namespace {
+
+enum class Implementation { Classic, Coro };
+
+struct BenchOptions {
+    std::uint16_t port{8092};
+    std::size_t connections{8};
+    std::size_t totalSize{256 * 1024 * 1024};
+    std::size_t threads{2};
+};
+
+struct Result {
+    double mibPerSecond;
+    std::chrono::nanoseconds p50;
+    std::chrono::nanoseconds p99;
+    double cpuMicrosPerMiB;
+    double peakMiB;
+    std::size_t failed;
+};
+
+std::string
+sizeName(std::size_t size)
+{
+    if (size >= 1024 * 1024) {
+        return std::to_string(size / (1024 * 1024)) + " MiB";
+    }
+    return std::to_string(size / 1024) + " KiB";
+}
+
+/* Returns the value the given share of values doesn't exceed (reorders values) */
+std::chrono::nanoseconds
+percentile(std::vector<std::chrono::nanoseconds>& values, double share)
+{
+    if (values.empty()) {
+        return {};
+    }
+    const auto nth = values.begin() + static_cast<std::ptrdiff_t>((values.size() - 1) * share);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+void
+waitListening(std::uint16_t port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for (bool ready{false}; !ready;) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ready = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        ::close(fd);
+        if (!ready) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+}
+
+Result
+runBenchmark(const BenchOptions& options,
+             Implementation implementation,
+             std::size_t payloadSize,
+             std::size_t chunkSize)
+{
+    const pid_t server = ::fork();
+    if (server == 0) {
+        if (implementation == Implementation::Classic) {
+            serveClassic(options.port);
+        } else {
+            serveCoro(options.port, options.threads);
+        }
+    }
+    waitListening(options.port);
+
+    const auto upload
+        = (implementation == Implementation::Classic) ? &uploadClassic : &uploadCoro;
+    const std::string payload(payloadSize, 'x');
+    const std::size_t uploads = std::max(options.connections, options.totalSize / payloadSize);
+
+    std::atomic<std::size_t> taken{0};
+    std::atomic<std::size_t> failed{0};
+    std::vector<std::vector<std::chrono::nanoseconds>> latencies(options.connections);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (auto& clientLatencies : latencies) {
+            clients.emplace_back([&]() {
+                clientLatencies.reserve(uploads / options.connections * (payloadSize / chunkSize));
+                while (taken++ < uploads) {
+                    /* An upload failed in the middle reports less chunks than the payload */
+                    std::size_t written{0};
+                    try {
+                        upload(options.port,
+                               payload,
+                               chunkSize,
+                               [&](std::size_t size, std::chrono::nanoseconds elapsed) {
+                                   written += size;
+                                   clientLatencies.push_back(elapsed);
+                               });
+                    } catch (const std::exception&) {
+                    }
+                    if (written != payloadSize) {
+                        ++failed;
+                    }
+                }
+            });
+        }
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    ::kill(server, SIGKILL);
+    rusage usage{};
+    ::wait4(server, nullptr, 0, &usage);
+
+    std::vector<std::chrono::nanoseconds> all;
+    for (const auto& clientLatencies : latencies) {
+        all.insert(all.end(), clientLatencies.begin(), clientLatencies.end());
+    }
+    const double uploadedMiB
+        = static_cast<double>((uploads - failed) * payloadSize) / (1024 * 1024);
+    const double cpuMicros = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6
+                             + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+
+    Result result{};
+    result.mibPerSecond = uploadedMiB / elapsed.count();
+    result.p50 = percentile(all, 0.5);
+    result.p99 = percentile(all, 0.99);
+    result.cpuMicrosPerMiB = (uploadedMiB > 0) ? cpuMicros / uploadedMiB : 0;
+    /* Linux reports the maximum resident set size in kilobytes */
+    result.peakMiB = static_cast<double>(usage.ru_maxrss) / 1024;
+    result.failed = failed;
+    return result;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::size_t totalMiB{256};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("port,p", po::value<std::uint16_t>(&options.port)->default_value(8092), "Set first port")
+        ("connections,c", po::value<std::size_t>(&options.connections)->default_value(8), "Set number of clients uploading at once")
+        ("total,t", po::value<std::size_t>(&totalMiB)->default_value(256), "Set size uploaded per run (MiB)")
+        ("threads", po::value<std::size_t>(&options.threads)->default_value(2), "Set number of coroutine server threads")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (options.connections == 0 || totalMiB == 0 || options.threads == 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.totalSize = totalMiB * 1024 * 1024;
+
+    /* Both implementations log connections and requests, keep the results only */
+    std::fflush(stdout);
+    const int output = ::dup(STDOUT_FILENO);
+    std::freopen("/dev/null", "w", stdout);
+    std::freopen("/dev/null", "w", stderr);
+
+    ::dprintf(output,
+              "%8s %8s %8s %10s %10s %10s %10s %10s %7s\n",
+              "impl",
+              "chunk",
+              "payload",
+              "MiB/s",
+              "p50 us",
+              "p99 us",
+              "cpu us/MiB",
+              "peak MiB",
+              "failed");
+    /* Payloads stay below the default body limit of servers keeping uploads in memory */
+    for (const auto implementation : {Implementation::Classic, Implementation::Coro}) {
+        for (const std::size_t chunkSize : {4 * 1024, 64 * 1024, 1024 * 1024}) {
+            for (const std::size_t payloadSize : {64 * 1024, 256 * 1024, 1024 * 1024}) {
+                if (chunkSize > payloadSize) {
+                    continue;
+                }
+                const auto result = runBenchmark(options, implementation, payloadSize, chunkSize);
+                ::dprintf(output,
+                          "%8s %8s %8s %10.1f %10.1f %10.1f %10.0f %10.1f %7zu\n",
+                          implementation == Implementation::Classic ? "classic" : "coro",
+                          sizeName(chunkSize).c_str(),
+                          sizeName(payloadSize).c_str(),
+                          result.mibPerSecond,
+                          std::chrono::duration<double, std::micro>(result.p50).count(),
+                          std::chrono::duration<double, std::micro>(result.p99).count(),
+                          result.cpuMicrosPerMiB,
+                          result.peakMiB,
+                          result.failed);
+                ++options.port;
+            }
+        }
+    }
+    ::close(output);
+    return EXIT_SUCCESS;
+}
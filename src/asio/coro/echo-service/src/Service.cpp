@@ -12,22 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <boost/asio.hpp>
+#include "Common.hpp"
+#include "ReceiveRing.hpp"
 
 #include <fmt/format.h>
 
-namespace io = boost::asio;
-namespace sys = boost::system;
-
-using tcp = boost::asio::ip::tcp;
+/* The number of sessions receiving into registered buffers and the size of each buffer */
+constexpr std::size_t kRingSlots{256};
+constexpr std::size_t kSlotSize{16384};
 
 io::awaitable<void>
-session(tcp::socket socket)
+session(tcp::socket socket, ReceiveRing::Slot slot)
 {
     try {
-        char data[1024];
+        const auto data = io::buffer(slot.data().data(), slot.data().size());
         for (;;) {
-            std::size_t n = co_await socket.async_read_some(io::buffer(data), io::use_awaitable);
+            std::size_t n = slot.registered()
+                ? co_await socket.async_read_some(slot.registered(data), io::use_awaitable)
+                : co_await socket.async_read_some(data, io::use_awaitable);
             co_await io::async_write(socket, io::buffer(data, n), io::use_awaitable);
         }
     } catch (const sys::system_error& e) {
@@ -41,13 +43,14 @@ session(tcp::socket socket)
 }
 
 io::awaitable<void>
-listener()
+listener(std::shared_ptr<ReceiveRing> ring)
 {
     auto executor = co_await io::this_coro::executor;
     tcp::acceptor acceptor{executor, {tcp::v4(), 8080}};
     for (;;) {
         tcp::socket socket = co_await acceptor.async_accept(io::use_awaitable);
-        io::co_spawn(executor, session(std::move(socket)), io::detached);
+        auto slot = ring ? ring->acquire() : ReceiveRing::allocate(kSlotSize);
+        io::co_spawn(executor, session(std::move(socket), std::move(slot)), io::detached);
     }
 }
 
@@ -60,8 +63,14 @@ main()
         io::signal_set signals{context, SIGINT, SIGTERM};
         signals.async_wait([&](auto, auto) { context.stop(); });
 
+        /* Receive buffers are registered once (used as fixed buffers by io_uring backend) */
+        std::shared_ptr<ReceiveRing> ring;
+#ifdef BOOST_ASIO_HAS_IO_URING
+        ring = std::make_shared<ReceiveRing>(context, kRingSlots, kSlotSize);
+#endif
+
         /* Spawn a new coroutine-based thread of execution */
-        io::co_spawn(context, listener(), io::detached /* explicitly ignore the result */);
+        io::co_spawn(context, listener(ring), io::detached /* explicitly ignore the result */);
 
         context.run();
     } catch (const std::exception& e) {
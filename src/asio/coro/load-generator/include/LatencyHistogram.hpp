@@ -0,0 +1,86 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Log-linear latency histogram (HdrHistogram-like layout)
+ *
+ * Values below 2^kSubBucketBits nanoseconds are stored exactly, every next power of two
+ * range is split into 2^(kSubBucketBits - 1) equal buckets. It keeps relative error
+ * below 1% while recording is a couple of bit operations and one increment.
+ */
+class LatencyHistogram {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    struct Bucket {
+        Duration upper;
+        std::uint64_t count;
+    };
+
+    explicit LatencyHistogram(Duration highest = std::chrono::seconds{60});
+
+    void
+    record(Duration value);
+
+    void
+    merge(const LatencyHistogram& other);
+
+    void
+    reset();
+
+    [[nodiscard]] std::uint64_t
+    count() const;
+
+    [[nodiscard]] Duration
+    min() const;
+
+    [[nodiscard]] Duration
+    max() const;
+
+    [[nodiscard]] Duration
+    mean() const;
+
+    /** Returns the value at given percentile (e.g. 99.9) */
+    [[nodiscard]] Duration
+    percentile(double p) const;
+
+    /** Returns non-empty buckets in ascending order */
+    [[nodiscard]] std::vector<Bucket>
+    buckets() const;
+
+private:
+    static constexpr unsigned kSubBucketBits{8};
+    static constexpr std::uint64_t kSubBucketCount{1u << kSubBucketBits};
+    static constexpr std::uint64_t kSubBucketHalf{kSubBucketCount / 2};
+
+    [[nodiscard]] static std::size_t
+    indexOf(std::uint64_t value);
+
+    [[nodiscard]] static std::uint64_t
+    upperOf(std::size_t index);
+
+private:
+    std::uint64_t _highest;
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _count{0};
+    std::uint64_t _min{0};
+    std::uint64_t _max{0};
+    long double _sum{0};
+};
@@ -0,0 +1,112 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Common.hpp"
+#include "LatencyHistogram.hpp"
+
+#include <string>
+#include <vector>
+
+enum class Protocol {
+    Echo, /* Echo server over TCP (tcp-echo, asio-coro-echo-service) */
+    Ping, /* Ping/Pong server over TCP (asio-tcp-async) */
+    Udp,  /* Echo server over UDP (asio-udp-sync) */
+};
+
+enum class Mode {
+    /* Next request is sent only when the previous response has been received */
+    Closed,
+    /* Requests are sent on fixed schedule regardless of responses, latency is measured from
+       the intended send time (coordinated omission corrected) */
+    Open,
+};
+
+struct LoadOptions {
+    Protocol protocol{Protocol::Echo};
+    Mode mode{Mode::Closed};
+    std::string host{"127.0.0.1"};
+    std::string port{"8080"};
+    std::size_t connections{1};
+    std::size_t threads{1};
+    /* The total rate of requests per second (open-loop mode only) */
+    double rate{1000.0};
+    std::size_t messageSize{64};
+    std::chrono::seconds duration{10};
+    /* How long to wait for in-flight responses after the end of the test */
+    std::chrono::milliseconds drainTimeout{2000};
+};
+
+struct LoadResult {
+    std::chrono::nanoseconds elapsed{};
+    std::uint64_t requests{0};
+    std::uint64_t responses{0};
+    std::uint64_t errors{0};
+    std::uint64_t bytesSent{0};
+    std::uint64_t bytesReceived{0};
+    LatencyHistogram latency;
+
+    void
+    merge(const LoadResult& other);
+};
+
+class LoadGenerator {
+public:
+    explicit LoadGenerator(LoadOptions options);
+
+    [[nodiscard]] LoadResult
+    run();
+
+private:
+    io::awaitable<void>
+    connection(std::size_t index);
+
+    io::awaitable<void>
+    echoClosed(std::size_t index);
+
+    io::awaitable<void>
+    echoOpen(std::size_t index);
+
+    io::awaitable<void>
+    pingClosed(std::size_t index);
+
+    io::awaitable<void>
+    pingOpen(std::size_t index);
+
+    io::awaitable<bool>
+    ping(std::size_t index);
+
+    io::awaitable<void>
+    udpClosed(std::size_t index);
+
+    io::awaitable<void>
+    udpOpen(std::size_t index);
+
+    /* Returns the interval between two requests of one connection (open-loop mode) */
+    [[nodiscard]] Clock::duration
+    interval() const;
+
+    /* Returns the first intended send time of the connection (spread over the interval) */
+    [[nodiscard]] Clock::time_point
+    firstSendTime(std::size_t index) const;
+
+private:
+    LoadOptions _options;
+    Clock::time_point _start;
+    Clock::time_point _deadline;
+    std::vector<tcp::endpoint> _tcpEndpoints;
+    udp::endpoint _udpEndpoint;
+    std::vector<LoadResult> _results;
+};
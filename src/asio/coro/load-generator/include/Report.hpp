@@ -0,0 +1,27 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "LoadGenerator.hpp"
+
+#include <string>
+
+/** Formats the result of the load test as human readable text */
+[[nodiscard]] std::string
+formatText(const LoadOptions& options, const LoadResult& result);
+
+/** Formats the result of the load test as JSON document */
+[[nodiscard]] std::string
+formatJson(const LoadOptions& options, const LoadResult& result);
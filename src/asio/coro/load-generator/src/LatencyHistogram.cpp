@@ -0,0 +1,151 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram(Duration highest)
+    : _highest{static_cast<std::uint64_t>(std::max(highest.count(), Duration::rep{1}))}
+    , _counts(indexOf(_highest) + 1)
+{
+}
+
+void
+LatencyHistogram::record(Duration value)
+{
+    const auto v = std::min(static_cast<std::uint64_t>(std::max(value.count(), Duration::rep{0})),
+                            _highest);
+    ++_counts[indexOf(v)];
+    _min = (_count == 0) ? v : std::min(_min, v);
+    _max = std::max(_max, v);
+    _sum += v;
+    ++_count;
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other._count == 0) {
+        return;
+    }
+    if (other._counts.size() > _counts.size()) {
+        _counts.resize(other._counts.size());
+        _highest = other._highest;
+    }
+    for (std::size_t n{0}; n < other._counts.size(); ++n) {
+        _counts[n] += other._counts[n];
+    }
+    _min = (_count == 0) ? other._min : std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    _sum += other._sum;
+    _count += other._count;
+}
+
+void
+LatencyHistogram::reset()
+{
+    std::fill(_counts.begin(), _counts.end(), 0);
+    _count = _min = _max = 0;
+    _sum = 0;
+}
+
+std::uint64_t
+LatencyHistogram::count() const
+{
+    return _count;
+}
+
+LatencyHistogram::Duration
+LatencyHistogram::min() const
+{
+    return Duration{_min};
+}
+
+LatencyHistogram::Duration
+LatencyHistogram::max() const
+{
+    return Duration{_max};
+}
+
+LatencyHistogram::Duration
+LatencyHistogram::mean() const
+{
+    return Duration{(_count == 0) ? 0 : static_cast<Duration::rep>(_sum / _count)};
+}
+
+LatencyHistogram::Duration
+LatencyHistogram::percentile(double p) const
+{
+    if (_count == 0) {
+        return Duration::zero();
+    }
+
+    p = std::clamp(p, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(_count))));
+
+    std::uint64_t seen{0};
+    for (std::size_t n{0}; n < _counts.size(); ++n) {
+        seen += _counts[n];
+        if (seen >= target) {
+            /* Report bucket upper bound but never above what we really observed */
+            return Duration{std::clamp(upperOf(n), _min, _max)};
+        }
+    }
+    return Duration{_max};
+}
+
+std::vector<LatencyHistogram::Bucket>
+LatencyHistogram::buckets() const
+{
+    std::vector<Bucket> output;
+    for (std::size_t n{0}; n < _counts.size(); ++n) {
+        if (_counts[n] > 0) {
+            output.push_back({Duration{upperOf(n)}, _counts[n]});
+        }
+    }
+    return output;
+}
+
+std::size_t
+LatencyHistogram::indexOf(std::uint64_t value)
+{
+    if (value < kSubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+
+    /* The shift keeps the top kSubBucketBits bits of the value (mantissa) */
+    const unsigned shift = std::bit_width(value) - kSubBucketBits;
+    const std::uint64_t mantissa = value >> shift;
+    assert(mantissa >= kSubBucketHalf && mantissa < kSubBucketCount);
+    return kSubBucketCount + (shift - 1) * kSubBucketHalf + (mantissa - kSubBucketHalf);
+}
+
+std::uint64_t
+LatencyHistogram::upperOf(std::size_t index)
+{
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    const std::size_t offset = index - kSubBucketCount;
+    const unsigned shift = offset / kSubBucketHalf + 1;
+    const std::uint64_t mantissa = offset % kSubBucketHalf + kSubBucketHalf;
+    return ((mantissa + 1) << shift) - 1;
+}
@@ -0,0 +1,81 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "LatencyHistogram.hpp"
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, Empty)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.percentile(99.0), 0ns);
+    EXPECT_THAT(histogram.buckets(), IsEmpty());
+}
+
+TEST(LatencyHistogramTest, ExactSmallValues)
+{
+    LatencyHistogram histogram;
+    for (int n{1}; n <= 100; ++n) {
+        histogram.record(std::chrono::nanoseconds{n});
+    }
+    EXPECT_EQ(histogram.count(), 100);
+    EXPECT_EQ(histogram.min(), 1ns);
+    EXPECT_EQ(histogram.max(), 100ns);
+    EXPECT_EQ(histogram.percentile(50.0), 50ns);
+    EXPECT_EQ(histogram.percentile(99.0), 99ns);
+    EXPECT_EQ(histogram.percentile(100.0), 100ns);
+}
+
+TEST(LatencyHistogramTest, RelativeError)
+{
+    LatencyHistogram histogram;
+    for (int n{1}; n <= 10000; ++n) {
+        histogram.record(std::chrono::microseconds{n});
+    }
+
+    auto near = [](std::chrono::nanoseconds expected) {
+        return AllOf(Ge(expected), Le(expected + expected / 100));
+    };
+    EXPECT_THAT(histogram.percentile(50.0), near(5000us));
+    EXPECT_THAT(histogram.percentile(99.0), near(9900us));
+    EXPECT_THAT(histogram.percentile(99.9), near(9990us));
+    EXPECT_EQ(histogram.percentile(100.0), 10000us);
+}
+
+TEST(LatencyHistogramTest, Merge)
+{
+    LatencyHistogram histogram1;
+    LatencyHistogram histogram2;
+    histogram1.record(10us);
+    histogram2.record(1ms);
+    histogram2.record(2ms);
+
+    histogram1.merge(histogram2);
+    EXPECT_EQ(histogram1.count(), 3);
+    EXPECT_EQ(histogram1.min(), 10us);
+    EXPECT_EQ(histogram1.max(), 2ms);
+    EXPECT_THAT(histogram1.buckets(), SizeIs(3));
+}
+
+TEST(LatencyHistogramTest, ClampHighest)
+{
+    LatencyHistogram histogram{1s};
+    histogram.record(10s);
+    EXPECT_EQ(histogram.max(), 1s);
+}
@@ -0,0 +1,415 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LoadGenerator.hpp"
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <deque>
+#include <thread>
+
+using namespace io::experimental::awaitable_operators;
+
+namespace {
+
+/* The request understood by asio-tcp-async server */
+constexpr std::string_view kPingRequest{"Ping\n"};
+constexpr std::string_view kPingResponse{"Pong"};
+
+io::awaitable<void>
+expire(Clock::duration timeout)
+{
+    io::steady_timer timer{co_await io::this_coro::executor};
+    timer.expires_after(timeout);
+    co_await timer.async_wait(io::use_awaitable);
+}
+
+void
+putSequence(std::string& datagram, std::uint64_t sequence)
+{
+    std::memcpy(datagram.data(), &sequence, sizeof(sequence));
+}
+
+std::uint64_t
+getSequence(const std::string& datagram)
+{
+    std::uint64_t sequence;
+    std::memcpy(&sequence, datagram.data(), sizeof(sequence));
+    return sequence;
+}
+
+} // namespace
+
+void
+LoadResult::merge(const LoadResult& other)
+{
+    elapsed = std::max(elapsed, other.elapsed);
+    requests += other.requests;
+    responses += other.responses;
+    errors += other.errors;
+    bytesSent += other.bytesSent;
+    bytesReceived += other.bytesReceived;
+    latency.merge(other.latency);
+}
+
+LoadGenerator::LoadGenerator(LoadOptions options)
+    : _options{std::move(options)}
+{
+    assert(_options.connections > 0);
+    assert(_options.threads > 0);
+    assert(_options.messageSize > 0);
+    assert(_options.mode == Mode::Closed || _options.rate > 0);
+
+    if (_options.protocol == Protocol::Udp) {
+        /* Each datagram carries the sequence number to match responses */
+        _options.messageSize = std::max(_options.messageSize, sizeof(std::uint64_t));
+    }
+}
+
+LoadResult
+LoadGenerator::run()
+{
+    io::io_context context{static_cast<int>(_options.threads)};
+
+    if (_options.protocol == Protocol::Udp) {
+        udp::resolver resolver{context};
+        _udpEndpoint = *resolver.resolve(udp::v4(), _options.host, _options.port).begin();
+    } else {
+        tcp::resolver resolver{context};
+        for (auto&& entry : resolver.resolve(_options.host, _options.port)) {
+            _tcpEndpoints.push_back(entry.endpoint());
+        }
+    }
+
+    _results.assign(_options.connections, LoadResult{});
+    _start = Clock::now();
+    _deadline = _start + _options.duration;
+
+    for (std::size_t n{0}; n < _options.connections; ++n) {
+        io::co_spawn(io::make_strand(context), connection(n), [this, n](std::exception_ptr e) {
+            if (e) {
+                try {
+                    std::rethrow_exception(e);
+                } catch (const std::exception& ex) {
+                    fmt::print(stderr, "Connection <{}>: {}\n", n, ex.what());
+                }
+                ++_results[n].errors;
+            }
+        });
+    }
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t n{1}; n < _options.threads; ++n) {
+            threads.emplace_back([&context]() { context.run(); });
+        }
+        context.run();
+    }
+
+    LoadResult total;
+    for (const auto& result : _results) {
+        total.merge(result);
+    }
+    total.elapsed = Clock::now() - _start;
+    return total;
+}
+
+io::awaitable<void>
+LoadGenerator::connection(std::size_t index)
+{
+    switch (_options.protocol) {
+    case Protocol::Echo:
+        co_await (_options.mode == Mode::Open ? echoOpen(index) : echoClosed(index));
+        break;
+    case Protocol::Ping:
+        co_await (_options.mode == Mode::Open ? pingOpen(index) : pingClosed(index));
+        break;
+    case Protocol::Udp:
+        co_await (_options.mode == Mode::Open ? udpOpen(index) : udpClosed(index));
+        break;
+    }
+}
+
+io::awaitable<void>
+LoadGenerator::echoClosed(std::size_t index)
+{
+    auto& result = _results[index];
+
+    tcp::socket socket{co_await io::this_coro::executor};
+    co_await io::async_connect(socket, _tcpEndpoints, io::use_awaitable);
+    socket.set_option(tcp::no_delay{true});
+
+    const std::string request(_options.messageSize, 'x');
+    std::string response(_options.messageSize, '\0');
+    while (Clock::now() < _deadline) {
+        const auto sent = Clock::now();
+        ++result.requests;
+        result.bytesSent
+            += co_await io::async_write(socket, io::buffer(request), io::use_awaitable);
+        result.bytesReceived
+            += co_await io::async_read(socket, io::buffer(response), io::use_awaitable);
+        ++result.responses;
+        result.latency.record(Clock::now() - sent);
+    }
+}
+
+io::awaitable<void>
+LoadGenerator::echoOpen(std::size_t index)
+{
+    auto& result = _results[index];
+    auto executor = co_await io::this_coro::executor;
+
+    tcp::socket socket{executor};
+    co_await io::async_connect(socket, _tcpEndpoints, io::use_awaitable);
+    socket.set_option(tcp::no_delay{true});
+
+    /* Echo preserves the order so the responses are matched in FIFO order */
+    std::deque<Clock::time_point> pending;
+    bool writing{true};
+    io::steady_timer drain{executor};
+
+    auto writer = [&]() -> io::awaitable<void> {
+        const std::string request(_options.messageSize, 'x');
+        io::steady_timer timer{executor};
+        for (auto next = firstSendTime(index); next < _deadline; next += interval()) {
+            timer.expires_at(next);
+            co_await timer.async_wait(io::use_awaitable);
+            pending.push_back(next);
+            ++result.requests;
+            result.bytesSent
+                += co_await io::async_write(socket, io::buffer(request), io::use_awaitable);
+        }
+        writing = false;
+
+        if (not pending.empty()) {
+            sys::error_code ec;
+            drain.expires_after(_options.drainTimeout);
+            co_await drain.async_wait(io::redirect_error(io::use_awaitable, ec));
+            if (ec == io::error::operation_aborted) {
+                /* All responses have been received */
+                co_return;
+            }
+        }
+        /* Interrupt the reader which waits for lost responses */
+        socket.cancel();
+    };
+
+    auto reader = [&]() -> io::awaitable<void> {
+        std::string response(_options.messageSize, '\0');
+        sys::error_code ec;
+        while (writing || not pending.empty()) {
+            result.bytesReceived += co_await io::async_read(
+                socket, io::buffer(response), io::redirect_error(io::use_awaitable, ec));
+            if (ec) {
+                break;
+            }
+            /* Latency is measured from the intended send time, not from the actual one */
+            result.latency.record(Clock::now() - pending.front());
+            pending.pop_front();
+            ++result.responses;
+        }
+        result.errors += pending.size();
+        drain.cancel();
+    };
+
+    co_await (writer() && reader());
+}
+
+io::awaitable<void>
+LoadGenerator::pingClosed(std::size_t index)
+{
+    auto& result = _results[index];
+
+    while (Clock::now() < _deadline) {
+        const auto sent = Clock::now();
+        ++result.requests;
+        const auto outcome = co_await (ping(index) || expire(_options.drainTimeout));
+        if (outcome.index() == 0 && std::get<0>(outcome)) {
+            ++result.responses;
+            result.latency.record(Clock::now() - sent);
+        } else {
+            ++result.errors;
+        }
+    }
+}
+
+io::awaitable<void>
+LoadGenerator::pingOpen(std::size_t index)
+{
+    auto& result = _results[index];
+    auto executor = co_await io::this_coro::executor;
+
+    /* Every request is sent over a connection of its own, so requests are independent */
+    io::steady_timer timer{executor};
+    for (auto next = firstSendTime(index); next < _deadline; next += interval()) {
+        timer.expires_at(next);
+        co_await timer.async_wait(io::use_awaitable);
+        ++result.requests;
+        io::co_spawn(
+            executor,
+            [this, index, next, &result]() -> io::awaitable<void> {
+                const auto outcome = co_await (ping(index) || expire(_options.drainTimeout));
+                if (outcome.index() == 0 && std::get<0>(outcome)) {
+                    ++result.responses;
+                    result.latency.record(Clock::now() - next);
+                } else {
+                    ++result.errors;
+                }
+            },
+            io::detached);
+    }
+}
+
+io::awaitable<bool>
+LoadGenerator::ping(std::size_t index)
+{
+    auto& result = _results[index];
+
+    sys::error_code ec;
+    tcp::socket socket{co_await io::this_coro::executor};
+    co_await io::async_connect(
+        socket, _tcpEndpoints, io::redirect_error(io::use_awaitable, ec));
+    if (ec) {
+        co_return false;
+    }
+
+    result.bytesSent += co_await io::async_write(
+        socket, io::buffer(kPingRequest), io::redirect_error(io::use_awaitable, ec));
+    if (ec) {
+        co_return false;
+    }
+
+    std::string response;
+    result.bytesReceived += co_await io::async_read_until(socket,
+                                                          io::dynamic_buffer(response),
+                                                          '\n',
+                                                          io::redirect_error(io::use_awaitable, ec));
+    co_return (not ec && response.starts_with(kPingResponse));
+}
+
+io::awaitable<void>
+LoadGenerator::udpClosed(std::size_t index)
+{
+    auto& result = _results[index];
+
+    udp::socket socket{co_await io::this_coro::executor, udp::endpoint{udp::v4(), 0}};
+    socket.connect(_udpEndpoint);
+
+    std::string request(_options.messageSize, 'x');
+    std::string response(_options.messageSize, '\0');
+    for (std::uint64_t sequence{0}; Clock::now() < _deadline; ++sequence) {
+        putSequence(request, sequence);
+
+        const auto sent = Clock::now();
+        ++result.requests;
+        result.bytesSent += co_await socket.async_send(io::buffer(request), io::use_awaitable);
+
+        /* Skip late responses to the requests which were already counted as lost */
+        for (;;) {
+            const auto outcome = co_await (socket.async_receive(io::buffer(response),
+                                                                io::use_awaitable)
+                                           || expire(sent + _options.drainTimeout - Clock::now()));
+            if (outcome.index() != 0) {
+                ++result.errors;
+                break;
+            }
+            result.bytesReceived += std::get<0>(outcome);
+            if (getSequence(response) == sequence) {
+                ++result.responses;
+                result.latency.record(Clock::now() - sent);
+                break;
+            }
+        }
+    }
+}
+
+io::awaitable<void>
+LoadGenerator::udpOpen(std::size_t index)
+{
+    auto& result = _results[index];
+    auto executor = co_await io::this_coro::executor;
+
+    udp::socket socket{executor, udp::endpoint{udp::v4(), 0}};
+    socket.connect(_udpEndpoint);
+
+    /* Datagrams might be lost or reordered, so responses are matched by the sequence number */
+    std::vector<Clock::time_point> intended;
+    std::vector<bool> answered;
+    bool writing{true};
+    io::steady_timer drain{executor};
+
+    auto writer = [&]() -> io::awaitable<void> {
+        std::string request(_options.messageSize, 'x');
+        io::steady_timer timer{executor};
+        for (auto next = firstSendTime(index); next < _deadline; next += interval()) {
+            timer.expires_at(next);
+            co_await timer.async_wait(io::use_awaitable);
+            putSequence(request, intended.size());
+            intended.push_back(next);
+            answered.push_back(false);
+            ++result.requests;
+            result.bytesSent += co_await socket.async_send(io::buffer(request), io::use_awaitable);
+        }
+        writing = false;
+
+        if (result.responses < result.requests) {
+            sys::error_code ec;
+            drain.expires_after(_options.drainTimeout);
+            co_await drain.async_wait(io::redirect_error(io::use_awaitable, ec));
+            if (ec == io::error::operation_aborted) {
+                co_return;
+            }
+        }
+        socket.cancel();
+    };
+
+    auto reader = [&]() -> io::awaitable<void> {
+        std::string response(_options.messageSize, '\0');
+        sys::error_code ec;
+        while (writing || result.responses < result.requests) {
+            const auto n = co_await socket.async_receive(
+                io::buffer(response), io::redirect_error(io::use_awaitable, ec));
+            if (ec) {
+                break;
+            }
+            result.bytesReceived += n;
+            if (const auto sequence = getSequence(response);
+                sequence < intended.size() && not answered[sequence]) {
+                answered[sequence] = true;
+                ++result.responses;
+                result.latency.record(Clock::now() - intended[sequence]);
+            }
+        }
+        result.errors += result.requests - result.responses;
+        drain.cancel();
+    };
+
+    co_await (writer() && reader());
+}
+
+Clock::duration
+LoadGenerator::interval() const
+{
+    const std::chrono::duration<double> seconds{
+        static_cast<double>(_options.connections) / _options.rate};
+    return std::max<Clock::duration>(
+        std::chrono::duration_cast<Clock::duration>(seconds), Clock::duration{1});
+}
+
+Clock::time_point
+LoadGenerator::firstSendTime(std::size_t index) const
+{
+    return _start + interval() * index / _options.connections;
+}
@@ -0,0 +1,179 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Report.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <iterator>
+
+namespace {
+
+constexpr std::array kPercentiles{50.0, 75.0, 90.0, 99.0, 99.9, 99.99, 100.0};
+
+std::string_view
+toString(Protocol protocol)
+{
+    switch (protocol) {
+    case Protocol::Echo:
+        return "echo";
+    case Protocol::Ping:
+        return "ping";
+    case Protocol::Udp:
+        return "udp";
+    }
+    return "unknown";
+}
+
+std::string_view
+toString(Mode mode)
+{
+    return (mode == Mode::Open) ? "open" : "closed";
+}
+
+double
+toMicros(std::chrono::nanoseconds value)
+{
+    return std::chrono::duration<double, std::micro>{value}.count();
+}
+
+double
+toSeconds(std::chrono::nanoseconds value)
+{
+    return std::chrono::duration<double>{value}.count();
+}
+
+} // namespace
+
+std::string
+formatText(const LoadOptions& options, const LoadResult& result)
+{
+    const double seconds = toSeconds(result.elapsed);
+    const auto& latency = result.latency;
+
+    std::string output;
+    auto out = std::back_inserter(output);
+    fmt::format_to(out,
+                   "Target: {}:{} ({}, {}-loop)\n",
+                   options.host,
+                   options.port,
+                   toString(options.protocol),
+                   toString(options.mode));
+    fmt::format_to(out,
+                   "Connections: {}, threads: {}, message size: {} bytes, duration: {}s\n",
+                   options.connections,
+                   options.threads,
+                   options.messageSize,
+                   options.duration.count());
+    if (options.mode == Mode::Open) {
+        fmt::format_to(out, "Target rate: {:.0f} req/s\n", options.rate);
+    }
+    fmt::format_to(out,
+                   "\nRequests: {}, responses: {}, errors: {} in {:.3f}s\n",
+                   result.requests,
+                   result.responses,
+                   result.errors,
+                   seconds);
+    fmt::format_to(out,
+                   "Throughput: {:.1f} req/s, {:.3f} MB/s sent, {:.3f} MB/s received\n",
+                   result.responses / seconds,
+                   result.bytesSent / seconds / 1e6,
+                   result.bytesReceived / seconds / 1e6);
+    fmt::format_to(out,
+                   "\nLatency (us): min {:.1f}, mean {:.1f}, max {:.1f}\n",
+                   toMicros(latency.min()),
+                   toMicros(latency.mean()),
+                   toMicros(latency.max()));
+    fmt::format_to(out, "{:>10}  {:>12}\n", "Percentile", "Value (us)");
+    for (const double p : kPercentiles) {
+        fmt::format_to(out, "{:>9g}%  {:>12.1f}\n", p, toMicros(latency.percentile(p)));
+    }
+
+    fmt::format_to(out, "\n{:>14}  {:>12}  {:>10}\n", "Value (us)", "Count", "Cumulative");
+    std::uint64_t seen{0};
+    for (const auto& bucket : latency.buckets()) {
+        seen += bucket.count;
+        fmt::format_to(out,
+                       "{:>14.1f}  {:>12}  {:>9.5f}\n",
+                       toMicros(bucket.upper),
+                       bucket.count,
+                       static_cast<double>(seen) / latency.count());
+    }
+    return output;
+}
+
+std::string
+formatJson(const LoadOptions& options, const LoadResult& result)
+{
+    const double seconds = toSeconds(result.elapsed);
+    const auto& latency = result.latency;
+
+    std::string output;
+    auto out = std::back_inserter(output);
+    fmt::format_to(out, "{{\n");
+    fmt::format_to(out,
+                   R"(  "options": {{"host": "{}", "port": "{}", "protocol": "{}", "mode": "{}", )",
+                   options.host,
+                   options.port,
+                   toString(options.protocol),
+                   toString(options.mode));
+    fmt::format_to(out,
+                   R"("connections": {}, "threads": {}, "rate": {}, "message_size": {}, )"
+                   R"("duration_s": {}}},)"
+                   "\n",
+                   options.connections,
+                   options.threads,
+                   options.rate,
+                   options.messageSize,
+                   options.duration.count());
+    fmt::format_to(out,
+                   R"(  "elapsed_s": {:.6f}, "requests": {}, "responses": {}, "errors": {},)"
+                   "\n",
+                   seconds,
+                   result.requests,
+                   result.responses,
+                   result.errors);
+    fmt::format_to(out,
+                   R"(  "throughput": {{"requests_per_s": {:.3f}, "sent_bytes_per_s": {:.3f}, )"
+                   R"("received_bytes_per_s": {:.3f}}},)"
+                   "\n",
+                   result.responses / seconds,
+                   result.bytesSent / seconds,
+                   result.bytesReceived / seconds);
+    fmt::format_to(out,
+                   R"(  "latency_us": {{"min": {:.3f}, "mean": {:.3f}, "max": {:.3f}, "percentiles": {{)",
+                   toMicros(latency.min()),
+                   toMicros(latency.mean()),
+                   toMicros(latency.max()));
+    for (std::size_t n{0}; n < kPercentiles.size(); ++n) {
+        fmt::format_to(out,
+                       R"({}"p{:g}": {:.3f})",
+                       (n == 0) ? "" : ", ",
+                       kPercentiles[n],
+                       toMicros(latency.percentile(kPercentiles[n])));
+    }
+    fmt::format_to(out, "}},\n");
+    fmt::format_to(out, R"(    "histogram": [)");
+    const auto buckets = latency.buckets();
+    for (std::size_t n{0}; n < buckets.size(); ++n) {
+        fmt::format_to(out,
+                       R"({}{{"le": {:.3f}, "count": {}}})",
+                       (n == 0) ? "" : ", ",
+                       toMicros(buckets[n].upper),
+                       buckets[n].count);
+    }
+    fmt::format_to(out, "]}}\n}}\n");
+    return output;
+}
@@ -0,0 +1,119 @@
+// Copyright 2025 Denys Asauliak
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LoadGenerator.hpp"
+#include "Report.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+
+static const char* DefaultHost{"127.0.0.1"};
+static const char* DefaultPort{"8080"};
+
+static bool
+parseProtocol(const std::string& value, Protocol& protocol)
+{
+    if (value == "echo") {
+        protocol = Protocol::Echo;
+    } else if (value == "ping") {
+        protocol = Protocol::Ping;
+    } else if (value == "udp") {
+        protocol = Protocol::Udp;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool
+parseMode(const std::string& value, Mode& mode)
+{
+    if (value == "closed") {
+        mode = Mode::Closed;
+    } else if (value == "open") {
+        mode = Mode::Open;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int
+main(int argc, char* argv[])
+{
+    LoadOptions options;
+    std::string protocol;
+    std::string mode;
+    std::string format;
+    std::size_t duration{0};
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "produce help message")
+        ("host,h", po::value<std::string>(&options.host)->default_value(DefaultHost), "Set host")
+        ("port,p", po::value<std::string>(&options.port)->default_value(DefaultPort), "Set port")
+        ("protocol", po::value<std::string>(&protocol)->default_value("echo"), "Set protocol (echo, ping, udp)")
+        ("mode,m", po::value<std::string>(&mode)->default_value("closed"), "Set mode (closed, open)")
+        ("connections,c", po::value<std::size_t>(&options.connections)->default_value(1), "Set number of connections")
+        ("threads,t", po::value<std::size_t>(&options.threads)->default_value(1), "Set number of threads")
+        ("rate,r", po::value<double>(&options.rate)->default_value(1000), "Set total request rate (open mode)")
+        ("size,s", po::value<std::size_t>(&options.messageSize)->default_value(64), "Set message size")
+        ("duration,d", po::value<std::size_t>(&duration)->default_value(10), "Set duration in seconds")
+        ("format,f", po::value<std::string>(&format)->default_value("text"), "Set report format (text, json)")
+        ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if (not parseProtocol(protocol, options.protocol) or not parseMode(mode, options.mode)
+        or (format != "text" and format != "json")) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (options.connections == 0 or options.threads == 0 or options.messageSize == 0
+        or options.rate <= 0) {
+        std::cerr << desc << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (options.protocol == Protocol::Ping) {
+        /* The size of request is fixed by the protocol */
+        options.messageSize = 5;
+    }
+    options.duration = std::chrono::seconds{duration};
+
+    try {
+        LoadGenerator generator{options};
+        const auto result = generator.run();
+        fmt::print("{}", (format == "json") ? formatJson(options, result)
+                                            : formatText(options, result));
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "Exception: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}